@@ -45,6 +45,9 @@ void    ADS1232_PowerDown(void);
 bool    ADS1232_IsDataAvailable(void);
 float   ADS1232_GetGrams(void);
 
+// ltima amostra bruta (24 bits, sinal estendido) e total de amostras lidas
+void    ADS1232_GetLastRaw(int32_t* raw, uint32_t* contador);
+
 // Funes de Tara e Calibrao (agora no-bloqueantes ou semi-bloqueantes dependendo da estratgia)
 void    ADS1232_SetTareCurrent(void);
 int32_t ADS1232_GetOffset(void);
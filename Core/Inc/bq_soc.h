@@ -15,6 +15,46 @@
 #include "i2c.h"
 #include "bq25622_driver.h"
 
+// ============================================================
+// Defines de Configurao
+// ============================================================
+
+// Amostragem adaptativa (converso one-shot do BQ25622 a cada amostra)
+#define BQ_SOC_INTERVALO_RAPIDO_MS   1000   // Carregando, cabo conectado ou sob carga
+#define BQ_SOC_INTERVALO_LENTO_MS    30000  // Ocioso: s eventos do INT antecipam
+#define BQ_SOC_CORRENTE_CARGA_MA     50     // |IBAT| acima disso mantm o intervalo rpido
+#define BQ_SOC_VBUS_PRESENTE_MV      4500   // Cabo conectado
+#define BQ_SOC_ONESHOT_TIMEOUT_MS    500    // Espera mxima pelo ADC_DONE
+
+// Persistncia na EEPROM (anel de checkpoints do gerenciador de configuraes)
+#define BQ_SOC_CHECKPOINT_DELTA_PCT  2      // Variao de carga que justifica um checkpoint
+#define BQ_SOC_CHECKPOINT_MIN_MS     60000  // Intervalo mnimo entre checkpoints por variao
+#define BQ_SOC_DIVERGENCIA_MAX_PCT   30     // Restaurado x estimativa por tenso acima disso: usa a tenso
+
+// Aprendizado de capacidade entre ncoras de carga cheia e vazia
+#define BQ_SOC_VBAT_CHEIA_MV         4150   // ncora de cheia (com cabo e carga concluda)
+#define BQ_SOC_VBAT_VAZIA_MV         3300   // ncora de vazia (sem cabo e com carga leve)
+#define BQ_SOC_CAPACIDADE_MIN_PCT    50     // Faixa aceita para a capacidade aprendida (% do nominal)
+#define BQ_SOC_CAPACIDADE_MAX_PCT    120
+
+// ============================================================
+// Tipos de Dados Pblicos
+// ============================================================
+
+// Deriva do integrador: intervalo real entre amostras e ajustes forados da carga
+typedef struct {
+    uint32_t amostras;
+    uint32_t intervalo_ms;          // Intervalo programado atual
+    uint32_t dt_min_ms;
+    uint32_t dt_medio_ms;
+    uint32_t dt_max_ms;
+    uint32_t atraso_max_ms;         // Maior dt alm do intervalo programado
+    uint32_t tempo_integrado_s;
+    uint32_t correcoes;             // ncoras e saturaes que mudaram a carga
+    int32_t  correcao_ultima_uAh;   // Sinal: + contador abaixo do real, - acima
+    uint32_t correcao_total_uAh;    // Soma dos mdulos
+} BQ_SOC_Stats_t;
+
 // ============================================================
 // Prottipos de Funes Pblicas
 // ============================================================
@@ -28,6 +68,12 @@ void    bq_soc_coulomb_update(I2C_HandleTypeDef *hi2c);
 // Callback do SysTick (deve ser chamado a cada 1ms)
 void    bq_soc_systick_callback(void);
 
+// Callback do EXTI do pino INT do BQ25622 (borda de descida)
+void    bq_soc_int_callback(void);
+
+// Mantm o intervalo rpido enquanto ativo (1) ou volta ao adaptativo (0)
+void    bq_soc_set_modo_rapido(uint8_t ativo);
+
 // Retorna a porcentagem de bateria calculada (0.0% a 100.0%)
 float   bq_soc_get_percentage(void);
 
@@ -46,4 +92,17 @@ float   bq_soc_get_last_tdie(void);
 // Retorna o ltimo status de carga lido
 BQ25622_ChargeStatus_t bq_soc_get_last_chg_status(void);
 
+// Retorna a capacidade de plena carga aprendida (mAh)
+float   bq_soc_get_capacidade_mAh(void);
+
+// Retorna o nmero de ciclos completos de descarga acumulados
+uint16_t bq_soc_get_ciclos(void);
+
+// Retorna a carga restante (uAh)
+int32_t bq_soc_get_carga_uAh(void);
+
+// Estatsticas de deriva do contador
+void    bq_soc_get_stats(BQ_SOC_Stats_t *stats);
+void    bq_soc_reset_stats(void);
+
 #endif /* INC_BQ_SOC_H_ */
\ No newline at end of file
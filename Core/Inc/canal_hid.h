@@ -0,0 +1,76 @@
+/*
+ * Nome do Arquivo: canal_hid.h
+ * Descricao: Canal de comandos de baixa latencia pela interface USB HID
+ *            (relatorio de entrada de formato fixo a cada 1 ms e comandos
+ *            por relatorio de saida), em paralelo a CLI da CDC
+ * Autor: Gabriel Agune
+ */
+
+#ifndef CANAL_HID_H
+#define CANAL_HID_H
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================
+// Definicoes de Configuracao
+// ============================================================
+
+#define CANAL_HID_RELATORIO_IN_SIZE   32U   // = USBD_HID_CUSTOM_EPIN_FS_MPS
+#define CANAL_HID_RELATORIO_OUT_SIZE  8U    // = USBD_HID_CUSTOM_EPOUT_FS_MPS
+#define CANAL_HID_PERIODO_PADRAO_MS   1U    // Um relatorio por frame USB
+#define CANAL_HID_VERSAO_FORMATO      1U
+
+// Relatorio de entrada (little-endian, sem report ID):
+//   [0]      u8  versao do formato (CANAL_HID_VERSAO_FORMATO)
+//   [1]      u8  status (CANAL_HID_STATUS_*)
+//   [2..3]   u16 sequencia
+//   [4..7]   u32 tick_ms
+//   [8..11]  i32 peso (miligramas)
+//   [12..15] u32 frequencia (pulsos do capacimetro em 1 s)
+//   [16..17] i16 temperatura (centesimos de grau)
+//   [18..19] u16 umidade (centesimos de %)
+//   [20..23] i32 ads_raw (ultima amostra do ADS1232)
+//   [24]     u8  eco da sequencia do ultimo comando
+//   [25]     u8  eco do codigo do ultimo comando
+//   [26]     u8  resultado do ultimo comando (CANAL_HID_RES_*)
+//   [27..31] reservado (zero)
+#define CANAL_HID_STATUS_NOVA_AMOSTRA  0x01U   // ADS1232 produziu amostra desde o relatorio anterior
+#define CANAL_HID_STATUS_BALANCA_ATIVA 0x02U
+#define CANAL_HID_STATUS_STREAM_CDC    0x04U   // Telemetria binaria da CDC ativa
+
+// Relatorio de saida (SET_REPORT ou endpoint interrupt OUT):
+//   [0]      u8  sequencia escolhida pelo host (ecoada no relatorio de entrada)
+//   [1]      u8  codigo (CANAL_HID_CMD_*)
+//   [2..7]   argumentos
+#define CANAL_HID_CMD_NENHUM           0x00U
+#define CANAL_HID_CMD_TARA             0x01U
+#define CANAL_HID_CMD_BALANCA_LIGAR    0x02U
+#define CANAL_HID_CMD_BALANCA_DESLIGAR 0x03U
+#define CANAL_HID_CMD_PERIODO          0x04U   // arg[0]: periodo em ms (0 pausa os relatorios)
+
+#define CANAL_HID_RES_OK               0x00U
+#define CANAL_HID_RES_DESCONHECIDO     0x01U
+#define CANAL_HID_RES_INVALIDO         0x02U
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Registra a instancia da classe HID (NULL quando o host desconfigura)
+void Canal_HID_Set_Instancia(void *hid);
+
+// Executa um relatorio de saida recebido do host
+void Canal_HID_Receber_Comando(const uint8_t *dados, uint32_t tamanho);
+
+// Monta o relatorio de entrada atual (GET_REPORT); retorna o tamanho
+uint32_t Canal_HID_Montar_Relatorio(uint8_t *buf);
+
+// Enfileira o relatorio de entrada no ritmo configurado (tarefa de 1 ms)
+void Canal_HID_Process(void);
+
+#endif // CANAL_HID_H
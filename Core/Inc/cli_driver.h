@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 // ============================================================
 // Typedefs
@@ -28,6 +29,12 @@ typedef void (*cli_line_callback_t)(const char* line);
 // Inicializa o driver e registra o callback de processamento de linha
 void CLI_Init(cli_line_callback_t line_cb);
 
+// Enfileira um bloco de bytes (no bloqueante); retorna quantos bytes couberam no FIFO
+size_t CLI_Write(const void* data, size_t len);
+
+// Enfileira um quadro inteiro ou nada; retorna false se no houver espao
+bool CLI_Write_Frame(const void* data, size_t len);
+
 // Enfileira uma string simples para envio (no bloqueante)
 void CLI_Puts(const char* str);
 
@@ -37,6 +44,9 @@ void CLI_Printf(const char* format, ...);
 // Processa o envio de dados do FIFO para a interface USB (chamar no loop)
 void CLI_TX_Pump(void);
 
+// Recebe da interface USB CDC e processa os bytes (chamar no loop)
+void CLI_RX_Pump(void);
+
 // Processa um byte recebido da interface de hardware
 void CLI_Receive_Char(uint8_t received_char);
 
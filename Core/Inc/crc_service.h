@@ -0,0 +1,73 @@
+/*
+ * Nome do Arquivo: crc_service.h
+ * Descricao: Servico de CRC por hardware (incremental, CRC-32 e CRC-16/MODBUS, DMA)
+ * Autor: Gabriel Agune
+ */
+
+#ifndef CRC_SERVICE_H
+#define CRC_SERVICE_H
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "stm32c0xx_hal.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================
+// Definicoes de Configuracao
+// ============================================================
+
+#define CRC_SERVICE_DMA_CANAL     DMA1_Channel1  // Canal reservado para alimentar o CRC (mem2mem)
+#define CRC_SERVICE_DMA_TIMEOUT   50             // Espera maxima por um bloco DMA (ms)
+
+// Valores de verificacao ("123456789")
+#define CRC_SERVICE_CHECK_CRC32         0x0376E6E7UL
+#define CRC_SERVICE_CHECK_CRC16_MODBUS  0x4B37U
+
+// ============================================================
+// Tipos de Dados Publicos
+// ============================================================
+
+typedef enum {
+    CRC_SERVICE_CRC32,        // Poly 0x04C11DB7, init 0xFFFFFFFF, sem reflexao (padrao do periferico, armazenamento)
+    CRC_SERVICE_CRC16_MODBUS  // Poly 0x8005, init 0xFFFF, entrada/saida refletidas (protocolos seriais)
+} CRC_Service_Tipo_t;
+
+// Contexto de um calculo incremental. Varios contextos podem coexistir:
+// o estado e salvo/restaurado no periferico a cada atualizacao.
+typedef struct {
+    CRC_Service_Tipo_t tipo;
+    uint32_t           estado;   // Registrador interno (sem reflexao de saida)
+} CRC_Service_Ctx_t;
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Inicializa o servico sobre o handle gerado pelo CubeMX (crc.c)
+void CRC_Service_Init(CRC_HandleTypeDef *hcrc);
+
+// Inicia um calculo incremental
+void CRC_Service_Iniciar(CRC_Service_Ctx_t *ctx, CRC_Service_Tipo_t tipo);
+
+// Acumula 'tamanho' bytes (qualquer alinhamento/tamanho) pela CPU
+void CRC_Service_Atualizar(CRC_Service_Ctx_t *ctx, const void *dados, uint32_t tamanho);
+
+// Acumula via DMA (nao-bloqueante). O buffer deve permanecer valido ate a conclusao.
+bool CRC_Service_Atualizar_DMA(CRC_Service_Ctx_t *ctx, const void *dados, uint32_t tamanho);
+
+// Verifica/avanca a alimentacao por DMA; retorna true quando nao ha DMA pendente
+bool CRC_Service_DMA_Concluido(void);
+
+// Retorna o CRC final do contexto (aguarda DMA pendente, se houver)
+uint32_t CRC_Service_Finalizar(CRC_Service_Ctx_t *ctx);
+
+// Calculo de uma vez so (equivale a Iniciar + Atualizar + Finalizar)
+uint32_t CRC_Service_Calcular(CRC_Service_Tipo_t tipo, const void *dados, uint32_t tamanho);
+
+// Confere o periferico contra os valores de verificacao conhecidos
+bool CRC_Service_Auto_Teste(void);
+
+#endif // CRC_SERVICE_H
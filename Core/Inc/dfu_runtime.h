@@ -0,0 +1,63 @@
+/*
+ * Nome do Arquivo: dfu_runtime.h
+ * Descricao: Atualizacao de firmware em campo: interface DFU runtime (USB),
+ *            entrada no bootloader DFU da ROM e verificacao de CRC da imagem
+ * Autor: Gabriel Agune
+ */
+
+#ifndef DFU_RUNTIME_H
+#define DFU_RUNTIME_H
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================
+// Definicoes de Configuracao
+// ============================================================
+
+#define DFU_RUNTIME_FLASH_BASE      0x08000000UL
+#define DFU_RUNTIME_SISTEMA_BASE    0x1FFF0000UL   // Bootloader da ROM (USB DFU no STM32C071)
+#define DFU_RUNTIME_ATRASO_MS       50u            // Espera apos o DFU_DETACH antes do salto
+#define DFU_RUNTIME_MAGICO          0x43524346UL   // "FCRC": trailer gravado por Tools/dfu_preparar.py
+
+// ============================================================
+// Tipos de Dados Publicos
+// ============================================================
+
+typedef enum {
+    DFU_IMAGEM_OK,          // Trailer presente e CRC confere
+    DFU_IMAGEM_SEM_TRAILER, // Gravada pelo depurador (sem CRC anexado)
+    DFU_IMAGEM_CORROMPIDA   // Trailer da propria imagem com CRC divergente
+} DFU_Imagem_Status_t;
+
+// Trailer anexado ao final do .bin (logo apos a regiao de carga)
+typedef struct {
+    uint32_t magico;
+    uint32_t tamanho;   // Bytes cobertos pelo CRC (a partir de DFU_RUNTIME_FLASH_BASE)
+    uint32_t crc32;     // CRC-32 do periferico (poly 0x04C11DB7, init 0xFFFFFFFF, sem reflexao)
+} DFU_Trailer_t;
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Registra a instancia da classe DFU (chamado pelo ux_device_dfu_media.c)
+void DFU_Runtime_Set_Instancia(void *dfu);
+
+// Detecta o DFU_DETACH do host e salta para o bootloader (tarefa periodica)
+void DFU_Runtime_Process(void);
+
+// Agenda a entrada no bootloader (permite esvaziar a CLI antes do salto)
+void DFU_Runtime_Solicitar_Bootloader(void);
+
+// Para o USB e os perifericos e salta para o bootloader DFU da ROM (nao retorna)
+void DFU_Runtime_Entrar_Bootloader(void);
+
+// Confere a imagem em execucao contra o trailer (usa o periferico CRC)
+DFU_Imagem_Status_t DFU_Runtime_Verificar_Imagem(uint32_t *crc_calculado, uint32_t *tamanho);
+
+#endif // DFU_RUNTIME_H
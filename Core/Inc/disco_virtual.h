@@ -0,0 +1,49 @@
+/*
+ * Nome do Arquivo: disco_virtual.h
+ * Descricao: Disco FAT12 somente-leitura sintetizado sob demanda para a
+ *            classe USB Mass Storage (INFO.TXT, GRAOS.CSV e EEPROM.BIN)
+ * Autor: Gabriel Agune
+ */
+
+#ifndef DISCO_VIRTUAL_H
+#define DISCO_VIRTUAL_H
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================
+// Definicoes de Configuracao
+// ============================================================
+
+#define DISCO_VIRTUAL_SETOR        512u      // Bytes por setor (= bytes por cluster)
+#define DISCO_VIRTUAL_EEPROM_BYTES 65536ul   // Imagem da AT24C512 (regiao de configuracao mascarada)
+
+// ============================================================
+// Tipos de Dados Publicos
+// ============================================================
+
+typedef enum {
+    DISCO_VIRTUAL_OK,        // Setor preenchido
+    DISCO_VIRTUAL_PENDENTE,  // Leitura assincrona em andamento (chamar novamente com o mesmo LBA)
+    DISCO_VIRTUAL_ERRO       // LBA invalido ou falha na leitura da EEPROM
+} Disco_Virtual_Status_t;
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Congela tamanhos, datas e a tabela de diretorio (chamar quando o host monta o disco)
+void Disco_Virtual_Montar(void);
+
+// Numero total de setores do volume
+uint32_t Disco_Virtual_Total_Setores(void);
+
+// Preenche um setor de DISCO_VIRTUAL_SETOR bytes. Setores da EEPROM sao lidos
+// de forma assincrona: o buffer deve permanecer valido enquanto PENDENTE.
+Disco_Virtual_Status_t Disco_Virtual_Ler_Setor(uint32_t lba, uint8_t *buf);
+
+#endif // DISCO_VIRTUAL_H
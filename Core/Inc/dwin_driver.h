@@ -20,7 +20,8 @@
 // ============================================================
 
 #define DWIN_RX_BUFFER_SIZE     64u
-#define DWIN_UART_TIMEOUT_MS    100u
+#define DWIN_TX_BUFFER_SIZE     256u    // Anel de transmisso (potncia de 2)
+#define DWIN_UART_TIMEOUT_MS    100u    // Espera mxima por espao no anel de transmisso
 
 // ============================================================
 // Constantes de Comandos
@@ -235,5 +236,6 @@ bool     DWIN_Driver_WriteRawBytes(const uint8_t *data, uint16_t size);
 
 void     DWIN_Driver_HandleRxEvent(uint16_t size);
 void     DWIN_Driver_HandleError(UART_HandleTypeDef *huart);
+void     DWIN_Driver_HandleTxCplt(UART_HandleTypeDef *huart);
 
 #endif /* __DRIVER_DWIN_H */
\ No newline at end of file
@@ -20,8 +20,16 @@
 // ============================================================
 
 #define EEPROM_PAGE_SIZE         128  // Tamanho de pgina (AT24C512)
-#define EEPROM_WRITE_TIME_MS       5  // Tempo de escrita interna (tWR)
+#define EEPROM_WRITE_TIME_MS       5  // Tempo de escrita interna mximo (tWR), base do limite do ACK polling
 #define EEPROM_I2C_TIMEOUT_BOOT  100  // Timeout padro de inicializao
+#define EEPROM_QUEUE_SIZE          4  // Requisies assncronas pendentes (leitura/escrita)
+
+// ============================================================
+// Tipos de Dados Pblicos
+// ============================================================
+
+// Callback de concluso de requisio assncrona (executado no contexto principal)
+typedef void (*EEPROM_Callback_t)(bool sucesso, void *ctx);
 
 // ============================================================
 // API Pblica - Inicializao e Status
@@ -47,16 +55,22 @@ bool EEPROM_Driver_Write_Blocking(uint16_t addr, const uint8_t *data, uint16_t s
 // API Pblica - Funes Assncronas (FSM)
 // ============================================================
 
-// Verifica se a mquina de estados (FSM) de escrita est ocupada
+// Verifica se h requisio em andamento ou pendente na fila
 bool EEPROM_Driver_IsBusy(void);
 
+// Enfileira uma leitura assncrona; o buffer deve permanecer vlido at o callback
+bool EEPROM_Driver_Read_Async(uint16_t addr, uint8_t *data, uint16_t size, EEPROM_Callback_t cb, void *ctx);
+
+// Enfileira uma escrita assncrona; os dados devem permanecer vlidos at o callback
+bool EEPROM_Driver_Write_Async(uint16_t addr, const uint8_t *data, uint16_t size, EEPROM_Callback_t cb, void *ctx);
+
 // Inicia uma operao de escrita assncrona (no-bloqueante)
 bool EEPROM_Driver_Write_Async_Start(uint16_t addr, const uint8_t *data, uint16_t size);
 
-// Processa a mquina de estados (FSM) de escrita assncrona
+// Processa a mquina de estados (FSM) das requisies assncronas
 void EEPROM_Driver_FSM_Process(void);
 
-// Obtm o status de erro da FSM e limpa a flag
+// Obtm o erro das requisies sem callback e limpa a flag
 bool EEPROM_Driver_GetAndClearErrorFlag(void);
 
 #endif // EEPROM_DRIVER_H
\ No newline at end of file
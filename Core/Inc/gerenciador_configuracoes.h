@@ -24,6 +24,10 @@
 #define MAX_SENHA_LEN           10
 #define MAX_VALIDADE_LEN        10
 #define MAX_USUARIOS            10
+#define MAX_NR_DECIMALS         4       // Casas decimais da umidade (limite do relatrio em ponto fixo)
+#define SEQ_MAX_PASSOS          8       // Passos por receita de sequncia dos servos
+#define SEQ_NUM_RECEITAS        4
+#define CONFIG_NUM_SERVOS       2       // Trims de calibrao (um por ServoId_t)
 
 #define HARDWARE                "1.00"
 #define FIRMWARE                "0.00.001"
@@ -36,6 +40,7 @@
 typedef struct {
     char        nome[MAX_NOME_GRAO_LEN + 1];
     char        validade[MAX_VALIDADE_LEN + 2];
+    uint8_t     id_sequencia;   // Receita dos servos (ocupa o preenchimento antes de id_curva)
     uint32_t    id_curva;
     int16_t     umidade_min;
     int16_t     umidade_max;
@@ -62,6 +67,49 @@ typedef struct {
     uint32_t          crc; // IMPORTANTE: Deve ser o ltimo membro
 } Config_Aplicacao_t;
 
+// Estado do contador de Coulomb (gravado em anel, fora da imagem principal)
+typedef struct {
+    uint32_t          sequencia;          // Monotnica: o registro com maior sequncia  o atual
+    int32_t           carga_uAh;          // Carga restante
+    int32_t           capacidade_uAh;     // Capacidade de plena carga aprendida
+    int32_t           aprendizado_uAh;    // Carga lquida desde a ltima ncora (cheia/vazia)
+    int32_t           descarga_acum_uAh;  // Descarga acumulada para a contagem de ciclos
+    uint16_t          ciclos;
+    uint8_t           ancora;             // ltima ncora do aprendizado (ver bq_soc.c)
+    uint8_t           versao;
+    uint32_t          crc; // IMPORTANTE: Deve ser o ltimo membro
+} Config_Bateria_t;
+
+// Passo de uma receita de sequncia dos servos (interpretado em servo_controle.c)
+typedef struct {
+    uint8_t           servo;              // ServoId_t; fora da faixa = passo s de espera
+    uint8_t           angulo;             // Alvo (graus)
+    uint8_t           perfil;             // ServoPerfil_t
+    uint8_t           condicao;           // ServoCondicao_t: o que libera o prximo passo
+    uint16_t          espera_ms;          // Tempo mnimo do incio deste passo ao incio do prximo
+    uint16_t          reservado;
+} Config_Passo_Servo_t;
+
+typedef struct {
+    uint8_t               num_passos;     // 0 = receita no gravada (usa a padro do firmware)
+    uint8_t               reservado[3];
+    Config_Passo_Servo_t  passos[SEQ_MAX_PASSOS];
+} Config_Receita_Servo_t;
+
+// Calibrao do pulso de um servo, somada a min/max_pulse_us do firmware
+typedef struct {
+    int16_t           trim_min_us;
+    int16_t           trim_max_us;
+} Config_Trim_Servo_t;
+
+// Bloco dos servos na EEPROM (receitas e trims, fora da imagem principal)
+typedef struct {
+    uint32_t                versao;
+    Config_Receita_Servo_t  receitas[SEQ_NUM_RECEITAS];
+    Config_Trim_Servo_t     trims[CONFIG_NUM_SERVOS];
+    uint32_t                crc; // IMPORTANTE: Deve ser o ltimo membro
+} Config_Sequencias_t;
+
 // ============================================================
 // Mapeamento de Memria (EEPROM)
 // ============================================================
@@ -69,11 +117,33 @@ typedef struct {
 #define EEPROM_TOTAL_SIZE_BYTES 65536
 
 #define CONFIG_BLOCK_SIZE       sizeof(Config_Aplicacao_t)
+#define CONFIG_PAGINA_EEPROM    128
+#define CONFIG_ALINHAR_PAGINA(x) ((((x) + CONFIG_PAGINA_EEPROM - 1) / CONFIG_PAGINA_EEPROM) * CONFIG_PAGINA_EEPROM)
+
+// Layout legado (cpia tripla): apenas lido no boot para migrao
 #define ADDR_CONFIG_PRIMARY     0x0000
 #define ADDR_CONFIG_BACKUP1     (ADDR_CONFIG_PRIMARY + CONFIG_BLOCK_SIZE)
 #define ADDR_CONFIG_BACKUP2     (ADDR_CONFIG_BACKUP1 + CONFIG_BLOCK_SIZE)
+#define END_OF_LEGACY_CONFIG    (ADDR_CONFIG_BACKUP2 + CONFIG_BLOCK_SIZE)
 
-#define END_OF_CONFIG_DATA      (ADDR_CONFIG_BACKUP2 + CONFIG_BLOCK_SIZE)
+// Slots A/B: [imagem Config_Aplicacao_t][marcador de commit], gravados alternadamente
+#define CONFIG_MARCADOR_SIZE    16
+#define CONFIG_SLOT_SIZE        CONFIG_ALINHAR_PAGINA(CONFIG_BLOCK_SIZE + CONFIG_MARCADOR_SIZE)
+#define ADDR_CONFIG_SLOT_A      CONFIG_ALINHAR_PAGINA(END_OF_LEGACY_CONFIG)
+#define ADDR_CONFIG_SLOT_B      (ADDR_CONFIG_SLOT_A + CONFIG_SLOT_SIZE)
+
+#define END_OF_CONFIG_DATA      (ADDR_CONFIG_SLOT_B + CONFIG_SLOT_SIZE)
+
+// Anel de registros da bateria: cada checkpoint vai para o prximo registro,
+// espalhando o desgaste da EEPROM por todas as pginas do anel
+#define BATERIA_REGISTRO_SIZE   32
+#define BATERIA_NUM_REGISTROS   16
+#define ADDR_BATERIA_INICIO     CONFIG_ALINHAR_PAGINA(END_OF_CONFIG_DATA)
+#define END_OF_BATERIA_DATA     (ADDR_BATERIA_INICIO + (BATERIA_NUM_REGISTROS * BATERIA_REGISTRO_SIZE))
+
+// Receitas de sequncia dos servos
+#define ADDR_SEQUENCIAS_INICIO  CONFIG_ALINHAR_PAGINA(END_OF_BATERIA_DATA)
+#define END_OF_SEQUENCIAS_DATA  (ADDR_SEQUENCIAS_INICIO + sizeof(Config_Sequencias_t))
 
 // ============================================================
 // API Pblica do Mdulo
@@ -113,6 +183,7 @@ bool Gerenciador_Config_Set_Grao_Ativo(uint8_t novo_indice);
 bool Gerenciador_Config_Get_Grao_Ativo(uint8_t* indice_ativo);
 
 bool Gerenciador_Config_Get_Dados_Grao(uint8_t indice, Config_Grao_t* dados_grao);
+bool Gerenciador_Config_Set_Sequencia_Grao(uint8_t indice, uint8_t id_receita);
 uint8_t Gerenciador_Config_Get_Num_Graos(void);
 
 bool Gerenciador_Config_Set_Cal_A(float gain, float zero);
@@ -133,4 +204,20 @@ bool Gerenciador_Config_Get_Company(char* empresa, uint8_t tamanho_empresa);
 bool Gerenciador_Config_Set_Serial(const char* novo_serial);
 bool Gerenciador_Config_Get_Serial(char* serial, uint8_t tamanho_buffer);
 
+// Estado da bateria: o Set agenda um checkpoint assncrono (sequncia e CRC so
+// preenchidos na gravao); o Get l o anel na primeira chamada (bloqueante)
+bool Gerenciador_Config_Set_Bateria(const Config_Bateria_t* dados);
+bool Gerenciador_Config_Get_Bateria(Config_Bateria_t* dados);
+
+// Receitas dos servos: o Get l o bloco na primeira chamada (bloqueante) e retorna
+// false para receita no gravada; o Set agenda a gravao assncrona do bloco.
+// Enquanto a leitura do bloco falhar, Get e Set retornam false (nada  gravado)
+bool Gerenciador_Config_Set_Receita_Servo(uint8_t id, const Config_Receita_Servo_t* receita);
+bool Gerenciador_Config_Get_Receita_Servo(uint8_t id, Config_Receita_Servo_t* receita);
+
+// Trims dos servos (mesmo bloco das receitas; zero quando nunca gravados ou se a
+// leitura falhar, caso em que o Set retorna false)
+bool Gerenciador_Config_Set_Trim_Servo(uint8_t id, const Config_Trim_Servo_t* trim);
+bool Gerenciador_Config_Get_Trim_Servo(uint8_t id, Config_Trim_Servo_t* trim);
+
 #endif // GERENCIADOR_CONFIGURACOES_H
\ No newline at end of file
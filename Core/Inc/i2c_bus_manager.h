@@ -0,0 +1,91 @@
+/*
+ * Nome do Arquivo: i2c_bus_manager.h
+ * Descricao: Gerenciador do barramento I2C1 (fila de transacoes com prioridade)
+ * Autor: Gabriel Agune
+ */
+
+#ifndef I2C_BUS_MANAGER_H
+#define I2C_BUS_MANAGER_H
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "stm32c0xx_hal.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================
+// Definicoes de Configuracao
+// ============================================================
+
+#define I2C_BUS_QUEUE_SIZE         6    // Transacoes pendentes (todas as prioridades)
+#define I2C_BUS_TIMEOUT_PADRAO    50    // Timeout padrao de uma transacao (ms)
+
+// Pinos usados na recuperacao do barramento (9 pulsos de SCL)
+#define I2C_BUS_SCL_PORT       GPIOB
+#define I2C_BUS_SCL_PIN        GPIO_PIN_8
+#define I2C_BUS_SDA_PORT       GPIOB
+#define I2C_BUS_SDA_PIN        GPIO_PIN_9
+
+// ============================================================
+// Tipos de Dados Publicos
+// ============================================================
+
+// Prioridade da transacao (menor valor = atendida primeiro)
+typedef enum {
+    I2C_BUS_PRIO_ALTA = 0,
+    I2C_BUS_PRIO_NORMAL,
+    I2C_BUS_PRIO_BAIXA
+} I2C_Bus_Prioridade_t;
+
+// Tipo de transacao
+typedef enum {
+    I2C_BUS_OP_READ,   // Leitura de memoria/registrador (Mem_Read)
+    I2C_BUS_OP_WRITE,  // Escrita de memoria/registrador (Mem_Write)
+    I2C_BUS_OP_PROBE   // Apenas o endereco (teste de ACK)
+} I2C_Bus_Op_t;
+
+// Callback de conclusao (contexto de ISR ou principal: deve ser curto)
+typedef void (*I2C_Bus_Callback_t)(bool sucesso, void *ctx);
+
+// Descricao de uma transacao
+typedef struct {
+    I2C_Bus_Op_t        op;
+    uint16_t            dev_addr;       // Endereco de 8 bits (formato HAL)
+    uint16_t            mem_addr;
+    uint16_t            mem_addr_size;  // I2C_MEMADD_SIZE_8BIT / I2C_MEMADD_SIZE_16BIT
+    uint8_t* p_data;
+    uint16_t            size;
+    uint16_t            timeout_ms;     // 0 = I2C_BUS_TIMEOUT_PADRAO
+    uint16_t            ack_poll_ms;    // Janela para repetir em caso de NACK (0 = sem polling)
+    I2C_Bus_Callback_t  callback;
+    void* ctx;
+} I2C_Bus_Transacao_t;
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Inicializa o gerenciador com o handle do barramento
+void I2C_Bus_Init(I2C_HandleTypeDef *hi2c);
+
+// Enfileira uma transacao nao-bloqueante (retorna false se a fila estiver cheia)
+bool I2C_Bus_Submit(const I2C_Bus_Transacao_t *t, I2C_Bus_Prioridade_t prio);
+
+// Trata timeouts, repeticoes de ACK polling e recuperacao (chamar periodicamente)
+void I2C_Bus_Process(void);
+
+// Verifica se nao ha transacao em andamento nem pendente
+bool I2C_Bus_IsIdle(void);
+
+// Executa a recuperacao do barramento (9 pulsos de SCL + STOP) e reinicia o periferico.
+// Usada internamente em timeouts; chamadas externas apenas com o barramento ocioso.
+void I2C_Bus_Recover(void);
+
+// Wrappers bloqueantes (enfileiram e aguardam a conclusao, sem competir pelo HAL)
+HAL_StatusTypeDef I2C_Bus_Mem_Read_Blocking(uint16_t dev_addr, uint16_t mem_addr, uint16_t mem_addr_size, uint8_t *data, uint16_t size, uint16_t timeout_ms);
+HAL_StatusTypeDef I2C_Bus_Mem_Write_Blocking(uint16_t dev_addr, uint16_t mem_addr, uint16_t mem_addr_size, const uint8_t *data, uint16_t size, uint16_t timeout_ms);
+HAL_StatusTypeDef I2C_Bus_Probe_Blocking(uint16_t dev_addr, uint16_t timeout_ms);
+
+#endif // I2C_BUS_MANAGER_H
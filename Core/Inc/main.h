@@ -91,6 +91,7 @@ void SystemClock_Config(void);
 #define POWER_GOOD_GPIO_Port GPIOB
 #define FAIL_INT_Pin GPIO_PIN_4
 #define FAIL_INT_GPIO_Port GPIOB
+#define FAIL_INT_EXTI_IRQn EXTI4_15_IRQn
 #define HAB_TOUCH_Pin GPIO_PIN_5
 #define HAB_TOUCH_GPIO_Port GPIOB
 
@@ -26,6 +26,9 @@ typedef struct {
     float Temp_Instru;
     float Densidade;
     float Umidade;
+    uint64_t Carimbo_Peso_ms;       // Epoch em ms de cada grandeza (RTC_Driver_Get_Epoch_ms)
+    uint64_t Carimbo_Frequencia_ms;
+    uint64_t Carimbo_Temp_ms;
 } DadosMedicao_t;
 
 // ============================================================
@@ -38,6 +41,16 @@ void Medicao_Init(void);
 // Processa as lgicas de medio (leitura de balana e frequncia)
 void Medicao_Process(void);
 
+// Liga/desliga o ADS1232 (a balana s  alimentada quando necessrio)
+void Medicao_Start_Balanca(void);
+void Medicao_Stop_Balanca(void);
+
+// Indica se a balana est ligada
+bool Medicao_Balanca_Ativa(void);
+
+// Tara no bloqueante (usa a leitura atual como offset)
+void Medicao_Tare_Balanca(void);
+
 // Obtm uma cpia da ltima medio consolidada
 void Medicao_Get_UltimaMedicao(DadosMedicao_t* dados);
 
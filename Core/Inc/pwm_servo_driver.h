@@ -13,6 +13,32 @@
 
 #include "main.h" // Necessrio para o tipo TIM_HandleTypeDef
 
+// ============================================================
+// Definies de Configurao
+// ============================================================
+
+// Base de tempo dos servos (TIM16/TIM17 no .ioc: PSC 47, ARR 19999)
+#define PWM_SERVO_TIMER_HZ      48000000UL  // Clock dos timers (HSI 48 MHz, APB /1)
+#define PWM_SERVO_TICK_HZ       1000000UL   // 1 tick = 1 us
+#define PWM_SERVO_QUADRO_US     20000UL     // Quadro de 50 Hz
+#define PWM_SERVO_PRESCALER     ((PWM_SERVO_TIMER_HZ / PWM_SERVO_TICK_HZ) - 1UL)
+#define PWM_SERVO_ARR           ((PWM_SERVO_QUADRO_US * (PWM_SERVO_TICK_HZ / 1000000UL)) - 1UL)
+
+// Converso us -> CCR resolvida em tempo de compilao
+#define PWM_SERVO_US_PARA_CCR(us)   ((uint32_t)(us) * (PWM_SERVO_TICK_HZ / 1000000UL))
+
+// Limites de segurana do pulso, j com o trim aplicado
+#define PWM_SERVO_PULSO_MIN_US  500
+#define PWM_SERVO_PULSO_MAX_US  2500
+
+#define PWM_SERVO_ANGULO_MAX    180U    // Curso do servo (graus)
+#define PWM_SERVO_FRAC_BITS     8U      // Posio em graus Q8 (1/256 de grau)
+#define PWM_SERVO_LUT_SHIFT     2U      // Um ponto da tabela a cada 4 graus
+#define PWM_SERVO_LUT_PONTOS    ((PWM_SERVO_ANGULO_MAX >> PWM_SERVO_LUT_SHIFT) + 1U)
+
+// Converte graus inteiros para a posio Q8 usada pelo driver
+#define PWM_SERVO_GRAUS_Q8(g)   ((uint32_t)(g) << PWM_SERVO_FRAC_BITS)
+
 // ============================================================
 // Typedefs e Estruturas
 // ============================================================
@@ -23,19 +49,28 @@ typedef struct {
     uint32_t           channel;      // Canal do timer
     uint16_t           min_pulse_us; // Pulso mnimo (em us) para 0
     uint16_t           max_pulse_us; // Pulso mximo (em us) para 180
+    int16_t            trim_min_us;  // Calibrao do ponto de 0 (persistida na EEPROM)
+    int16_t            trim_max_us;  // Calibrao do ponto de 180
+    uint16_t           lut_ccr[PWM_SERVO_LUT_PONTOS]; // CCR pr-calculado (preenchido no Init)
 } Servo_t;
 
 // ============================================================
 // Prottipos de Funes Pblicas
 // ============================================================
 
-// Inicializa e inicia a gerao de PWM para um servo especfico
+// Monta a tabela de CCR e inicia a gerao de PWM para um servo especfico
 HAL_StatusTypeDef PWM_Servo_Init(Servo_t *servo);
 
-// Define a posio do servo em um ngulo especfico
-void PWM_Servo_SetAngle(Servo_t *servo, float angle);
+// Aplica os trims de calibrao e recalcula a tabela de CCR
+void PWM_Servo_Set_Trim(Servo_t *servo, int16_t trim_min_us, int16_t trim_max_us);
+
+// Define a posio do servo em um ngulo inteiro (graus)
+void PWM_Servo_SetAngle(Servo_t *servo, uint16_t angle);
+
+// Define a posio em graus Q8 (s inteiros, pode ser chamada de ISR)
+void PWM_Servo_Set_Posicao(Servo_t *servo, uint32_t posicao_q8);
 
 // Para a gerao de PWM para um servo especfico
 HAL_StatusTypeDef PWM_Servo_DeInit(Servo_t *servo);
 
-#endif // PWM_SERVO_DRIVER_H
\ No newline at end of file
+#endif // PWM_SERVO_DRIVER_H
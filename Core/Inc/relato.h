@@ -16,6 +16,39 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <string.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ============================================================
+// Tipos de Dados
+// ============================================================
+
+// Relatrios gerados a partir dos modelos
+typedef enum {
+    RELATO_WHO_AM_I,        // Identificao do equipamento
+    RELATO_MEDICAO,         // Cabealho + medio + assinatura (impressora)
+    RELATO_QRCODE,          // Texto do QR Code do resultado
+    RELATO_CABECALHO,
+    RELATO_ASSINATURA
+} Relato_Tipo_t;
+
+// Destino do relatrio: recebe blocos de texto j formatado
+typedef void (*Relato_Escrever_t)(void* contexto, const char* dados, size_t len);
+
+typedef struct {
+    Relato_Escrever_t escrever;
+    void*             contexto;
+} Relato_Saida_t;
+
+// Contexto da sada em memria (Relato_Saida_Buffer)
+typedef struct {
+    char*  buf;
+    size_t capacidade;
+    size_t tamanho;
+} Relato_Buffer_t;
+
+// Sada padro (FIFO do CLI)
+extern const Relato_Saida_t RELATO_SAIDA_CLI;
 
 // ============================================================
 // Prottipos de Funes Externas
@@ -34,6 +67,13 @@ extern void Cabecalho(void);
 // Prottipos de Funes Pblicas
 // ============================================================
 
+// Gera um relatrio inteiro em uma passada direto na sada (sem stdio)
+extern void Relatorio_Gerar(Relato_Tipo_t tipo, const Relato_Saida_t* saida);
+
+// Sadas prontas: FIFO do CLI e buffer em memria (contexto Relato_Buffer_t)
+extern void Relato_Saida_CLI(void* contexto, const char* dados, size_t len);
+extern void Relato_Saida_Buffer(void* contexto, const char* dados, size_t len);
+
 // Gera e envia o relatrio formatado para a impressora
 extern void Relatorio_Printer(void);
 
@@ -0,0 +1,86 @@
+/*
+ * Nome do Arquivo: ring_buffer.h
+ * Descricao: Buffer circular generico (tamanho potencia de 2, indices mascarados)
+ *            com reserva segura para varios produtores (main + ISRs) e um consumidor
+ * Autor: Gabriel Agune
+ */
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "stm32c0xx_hal.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================
+// Tipos de Dados Publicos
+// ============================================================
+
+// Indices livres (uint32 com overflow natural); posicao fisica = indice & mascara
+typedef struct {
+    uint8_t*            buf;
+    uint32_t            mascara;    // tamanho - 1
+    volatile uint32_t   head;       // Proxima posicao a reservar (produtores)
+    volatile uint32_t   commit;     // Limite de dados prontos, visivel ao consumidor
+    volatile uint32_t   tail;       // Proxima posicao a ler (consumidor)
+    volatile uint8_t    abertas;    // Reservas ainda nao confirmadas
+} RingBuffer_t;
+
+// Regiao reservada por um produtor
+typedef struct {
+    uint32_t inicio;
+    uint32_t tamanho;
+} RingBuffer_Reserva_t;
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Associa o buffer ao anel (tamanho deve ser potencia de 2)
+bool RingBuffer_Init(RingBuffer_t *rb, uint8_t *buf, uint32_t tamanho);
+
+// Esvazia o anel (somente sem produtores/consumidor ativos)
+void RingBuffer_Limpar(RingBuffer_t *rb);
+
+// Espaco livre para novas reservas
+uint32_t RingBuffer_Livre(const RingBuffer_t *rb);
+
+// Bytes prontos para o consumidor
+uint32_t RingBuffer_Usado(const RingBuffer_t *rb);
+
+// --- Produtores (main ou ISR) ---
+
+// Reserva ate 'tamanho' bytes; retorna quanto foi reservado (0 = cheio).
+// Toda reserva com tamanho > 0 deve ser confirmada, mesmo que com 0 bytes usados.
+uint32_t RingBuffer_Reservar(RingBuffer_t *rb, uint32_t tamanho, RingBuffer_Reserva_t *r);
+
+// Copia dados para dentro de uma reserva (a partir de 'offset'), tratando a volta do anel
+void RingBuffer_Copiar(RingBuffer_t *rb, const RingBuffer_Reserva_t *r, uint32_t offset, const void *dados, uint32_t tamanho);
+
+// Confirma a reserva; 'usados' < tamanho devolve a sobra ao anel
+void RingBuffer_Confirmar(RingBuffer_t *rb, const RingBuffer_Reserva_t *r, uint32_t usados);
+
+// Escreve o que couber; retorna os bytes aceitos
+uint32_t RingBuffer_Escrever(RingBuffer_t *rb, const void *dados, uint32_t tamanho);
+
+// Escreve tudo ou nada (mensagens que nao podem ser cortadas)
+bool RingBuffer_Escrever_Inteiro(RingBuffer_t *rb, const void *dados, uint32_t tamanho);
+
+// --- Consumidor (um unico contexto) ---
+
+// Aponta para o maior trecho contiguo pronto a partir do tail; retorna seu tamanho
+uint32_t RingBuffer_Ler_Contiguo(const RingBuffer_t *rb, uint8_t **p);
+
+// Libera 'tamanho' bytes ja consumidos
+void RingBuffer_Descartar(RingBuffer_t *rb, uint32_t tamanho);
+
+// Acesso direto a uma posicao (indice livre)
+static inline uint8_t* RingBuffer_Ponteiro(const RingBuffer_t *rb, uint32_t indice) {
+    return &rb->buf[indice & rb->mascara];
+}
+
+#endif // RING_BUFFER_H
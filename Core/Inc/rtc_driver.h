@@ -15,6 +15,31 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+// ============================================================
+// Defines e Constantes
+// ============================================================
+
+#define RTC_DWIN_DATA_HORA_BYTES    8U      // AA MM DD sem HH MM SS 00 (VP_DATA_HORA)
+#define RTC_DWIN_BYTE_SEMANA        0x03    // Valor fixo que a tela sempre recebeu no campo da semana
+
+// ============================================================
+// Tipos de Dados
+// ============================================================
+
+// Data e hora publicadas uma vez por segundo (Alarme A do RTC)
+typedef struct {
+    uint8_t  hora;
+    uint8_t  minuto;
+    uint8_t  segundo;
+    uint8_t  dia;
+    uint8_t  mes;
+    uint8_t  ano;               // 20AA
+    uint8_t  dia_semana;        // RTC_WEEKDAY_x, calculado da data
+    uint8_t  reservado;
+    uint32_t epoch_s;           // Segundos desde 01/01/1970 (hora local)
+    uint32_t segundos_boot;     // Contador monotnico (no salta com SETTIME/SETDATE)
+} RTC_Calendario_t;
+
 // ============================================================
 // Prottipos de Funes Pblicas
 // ============================================================
@@ -28,10 +53,35 @@ bool RTC_Driver_SetDate(uint8_t day, uint8_t month, uint8_t year);
 // Define a hora (hora, minuto, segundo) no RTC
 bool RTC_Driver_SetTime(uint8_t hours, uint8_t minutes, uint8_t seconds);
 
-// Obtm a data atual do RTC
+// Copia o calendrio em cache sem acessar o RTC (leitura sem trava, contexto de thread)
+bool RTC_Driver_Get_Calendario(RTC_Calendario_t* calendario);
+
+// Segundos desde 01/01/1970 do ltimo segundo publicado
+uint32_t RTC_Driver_Get_Epoch(void);
+
+// Epoch em ms (RTC + SSR na ncora, interpolado pelo tick do HAL disciplinado pelo RTC)
+uint64_t RTC_Driver_Get_Epoch_ms(void);
+
+// Desvio medido do tick do HAL em relao ao RTC (ppm)
+int32_t RTC_Driver_Get_Desvio_Tick_ppm(void);
+
+// Converte segundos desde 01/01/1970 (2000..2099) para data e hora
+void RTC_Driver_Epoch_Para_Calendario(uint32_t epoch_s, RTC_Calendario_t* calendario);
+
+// Monta os RTC_DWIN_DATA_HORA_BYTES do VP_DATA_HORA a partir do calendrio ou de um carimbo em ms
+void RTC_Driver_Calendario_Para_DWIN(const RTC_Calendario_t* calendario, uint8_t* dwin);
+void RTC_Driver_Epoch_ms_Para_DWIN(uint64_t epoch_ms, uint8_t* dwin);
+
+// Nome abreviado do dia da semana ("SEG".."DOM")
+const char* RTC_Driver_Nome_Dia_Semana(uint8_t dia_semana);
+
+// Atualiza o cache (chamar no callback do Alarme A)
+void RTC_Driver_Alarme_Callback(void);
+
+// Obtm a data atual (do cache)
 bool RTC_Driver_GetDate(uint8_t* day, uint8_t* month, uint8_t* year, char* weekday_str);
 
-// Obtm a hora atual do RTC
+// Obtm a hora atual (do cache)
 bool RTC_Driver_GetTime(uint8_t* hours, uint8_t* minutes, uint8_t* seconds);
 
 #endif // RTC_DRIVER_H
\ No newline at end of file
@@ -12,33 +12,66 @@
 // ============================================================
 
 #include "main.h"
+#include "gerenciador_configuracoes.h"
+#include <stdbool.h>
 
 // ============================================================
 // Tipos de Dados
 // ============================================================
 
+// Servos da cmara
 typedef enum {
-    SERVO_STEP_FUNNEL,
-    SERVO_STEP_SCRAPER,
-    SERVO_STEP_IDLE,
-    SERVO_STEP_FINISHED
-} ServoStep_t;
+    SERVO_FUNIL,
+    SERVO_SCRAP,
+    NUM_SERVOS
+} ServoId_t;
 
+// Perfis de rampa de ngulo (tabelas pr-calculadas no Init)
+typedef enum {
+    SERVO_PERFIL_TRAPEZOIDAL,   // Acelerao constante, velocidade de cruzeiro, desacelerao
+    SERVO_PERFIL_S_CURVA,       // Acelerao nula nas pontas (menos tranco mecnico)
+    NUM_SERVO_PERFIS
+} ServoPerfil_t;
+
+// Condio que, alm do tempo de espera do passo, libera o prximo passo
+typedef enum {
+    SERVO_COND_TEMPO,           // S o tempo (o prximo passo pode sobrepor a rampa)
+    SERVO_COND_SERVO_PARADO,    // O servo do passo chegou ao alvo
+    SERVO_COND_TODOS_PARADOS,   // Nenhum servo em rampa
+    SERVO_COND_BALANCA,         // A balana converteu uma amostra nova depois do incio do passo
+    NUM_SERVO_CONDICOES
+} ServoCondicao_t;
 
 // ============================================================
 // Prottipos de Funes Pblicas
 // ============================================================
 
-// Inicializa o mdulo de controle dos servos
+// Inicializa o mdulo de controle dos servos (l os trims: chamar aps o CRC_Service_Init)
 void Servos_Init(void);
 
-// Processa a mquina de estados e atualiza a posio dos servos
+// Processa a mquina de estados dos passos da sequncia
 void Servos_Process(void);
 
-// Inicia a sequncia de movimento dos servos
+// Inicia a sequncia do gro ativo (receita da EEPROM ou a padro do firmware)
 void Servos_Start_Sequence(void);
 
-// Decrementa os temporizadores internos de controle dos servos (Chamar a cada 1ms)
+// Motor de movimento: avana as rampas e os temporizadores (chamado no update do TIM14, 1 kHz)
 void Servos_Tick_ms(void);
 
-#endif // SERVO_CONTROLE_H
\ No newline at end of file
+// Inicia uma rampa do ngulo atual at o alvo (graus) com o perfil escolhido
+void Servos_Mover(ServoId_t id, uint8_t angulo, ServoPerfil_t perfil);
+
+// Indica se algum servo ainda est em rampa
+bool Servos_Em_Movimento(void);
+
+// Receita efetiva de um id: a gravada na EEPROM ou a padro do firmware
+void Servos_Get_Receita(uint8_t id, Config_Receita_Servo_t* receita);
+
+// Trim de calibrao do pulso (us somados a 0 e 180): aplica na hora e agenda a gravao
+bool Servos_Set_Trim(ServoId_t id, int16_t trim_min_us, int16_t trim_max_us);
+bool Servos_Get_Trim(ServoId_t id, int16_t* trim_min_us, int16_t* trim_max_us);
+
+// Evento de fim de sequncia para a FSM de medio (retorna true uma nica vez)
+bool Servos_Sequencia_Concluida(void);
+
+#endif // SERVO_CONTROLE_H
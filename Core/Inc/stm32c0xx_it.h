@@ -51,6 +51,7 @@ void HardFault_Handler(void);
 void SVC_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
+void RTC_IRQHandler(void);
 void EXTI4_15_IRQHandler(void);
 void USB_DRD_FS_IRQHandler(void);
 void TIM14_IRQHandler(void);
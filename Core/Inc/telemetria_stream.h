@@ -0,0 +1,66 @@
+/*
+ * Nome do Arquivo: telemetria_stream.h
+ * Descricao: Streaming binario de telemetria (ADS1232 bruto, contagem do TIM2,
+ *            temperatura) em registros com CRC pela USB CDC
+ * Autor: Gabriel Agune
+ */
+
+#ifndef TELEMETRIA_STREAM_H
+#define TELEMETRIA_STREAM_H
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================
+// Definicoes de Configuracao
+// ============================================================
+
+#define TELEMETRIA_TAXA_MAX_HZ     1000U   // Limite superior (tarefa de 1 ms)
+#define TELEMETRIA_TAXA_PADRAO_HZ   100U
+
+// Formato do registro (little-endian):
+//   [0]  0xA5  [1] 0x5A          sincronismo
+//   [2]  tipo (TELEMETRIA_TIPO_AMOSTRA)
+//   [3]  tamanho do payload (TELEMETRIA_PAYLOAD_SIZE)
+//   payload:
+//     u16 sequencia       (incrementa tambem para registros descartados)
+//     u32 tick_ms
+//     i32 ads_raw         (ultima amostra de 24 bits, com sinal estendido)
+//     u16 ads_contador    (amostras lidas do ADS1232, modulo 65536)
+//     u32 tim2_contagem   (contador de pulsos do capacimetro, zerado a cada 1 s)
+//     i16 temperatura     (centesimos de grau)
+//     u8  descartados     (registros perdidos por falta de espaco, saturado em 255)
+//     u8  flags           (bit0: nova amostra do ADS1232)
+//   u16 CRC-16/MODBUS sobre tipo, tamanho e payload
+#define TELEMETRIA_SYNC1             0xA5U
+#define TELEMETRIA_SYNC2             0x5AU
+#define TELEMETRIA_TIPO_AMOSTRA      0x01U
+#define TELEMETRIA_PAYLOAD_SIZE      20U
+#define TELEMETRIA_FRAME_SIZE        (4U + TELEMETRIA_PAYLOAD_SIZE + 2U)
+
+#define TELEMETRIA_FLAG_NOVA_AMOSTRA 0x01U
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Inicia o streaming na taxa pedida (1..TELEMETRIA_TAXA_MAX_HZ); retorna a taxa efetiva
+uint16_t Telemetria_Stream_Iniciar(uint16_t taxa_hz);
+
+// Encerra o streaming
+void Telemetria_Stream_Parar(void);
+
+// Indica se o streaming esta ativo
+bool Telemetria_Stream_Ativo(void);
+
+// Total de registros descartados desde o ultimo inicio
+uint32_t Telemetria_Stream_Descartados(void);
+
+// Emite registros no ritmo configurado (tarefa de 1 ms do scheduler)
+void Telemetria_Stream_Process(void);
+
+#endif // TELEMETRIA_STREAM_H
@@ -0,0 +1,72 @@
+/*
+ * Nome do Arquivo: usb_bench.h
+ * Descricao: Bancada de medicao do caminho USB no alvo: custo em ciclos do
+ *            ux_device_stack_tasks_run, latencia RX->TX da CLI e gerador de
+ *            carga para vazao da CDC (usado pelo Tools/usb_bench.py)
+ * Autor: Gabriel Agune
+ */
+
+#ifndef USB_BENCH_H
+#define USB_BENCH_H
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================
+// Definicoes de Configuracao
+// ============================================================
+
+// 1: instrumenta USB_Process e os pumps da CLI e habilita o comando USBBENCH
+// 0: build de producao, sem custo no laco principal (a medicao sem placa fica
+//    no Tools/usb_sim)
+#ifndef USB_BENCH_ENABLE
+#define USB_BENCH_ENABLE        0
+#endif
+
+#define USB_BENCH_TX_MAX_BYTES  (16UL * 1024UL * 1024UL)
+#define USB_BENCH_TX_BLOCO      64U     // Bytes por chamada do CLI_Write (um pacote FS)
+
+// ============================================================
+// Tipos de Dados Publicos
+// ============================================================
+
+typedef struct {
+    uint32_t tasks_chamadas;
+    uint32_t tasks_ciclos_medio;
+    uint32_t tasks_ciclos_max;
+    uint32_t latencia_amostras;     // Pacote recebido -> proxima transferencia IN concluida
+    uint32_t latencia_ciclos_min;
+    uint32_t latencia_ciclos_medio;
+    uint32_t latencia_ciclos_max;
+    bool     tx_ativo;
+    uint32_t tx_restante;
+} USB_Bench_Stats_t;
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Contador de ciclos de 32 bits derivado do SysTick (HAL_GetTick + VAL)
+uint32_t USB_Bench_Ciclos(void);
+
+// Acumula o custo de uma chamada do tasks_run iniciada em ciclos_inicio
+void USB_Bench_Registrar_Tasks(uint32_t ciclos_inicio);
+
+// Marcas de latencia: pacote OUT entregue a CLI / transferencia IN concluida
+void USB_Bench_Marcar_RX(void);
+void USB_Bench_Marcar_TX(void);
+
+// Enfileira 'bytes' do padrao 0x00..0xFF na CDC; false se invalido ou ja ativo
+bool USB_Bench_Iniciar_TX(uint32_t bytes);
+
+// Alimenta o gerador de carga (chamar no laco, junto ao USB_Process)
+void USB_Bench_Process(void);
+
+void USB_Bench_Reset(void);
+void USB_Bench_Get_Stats(USB_Bench_Stats_t *stats);
+
+#endif // USB_BENCH_H
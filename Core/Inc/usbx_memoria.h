@@ -0,0 +1,56 @@
+/*
+ * Nome do Arquivo: usbx_memoria.h
+ * Descricao: Alocador de memoria do USBX. No modo arena as alocacoes do stack
+ *            e das classes saem de uma arena estatica dimensionada em tempo de
+ *            compilacao a partir dos descritores, no lugar da busca first-fit
+ *            no byte pool; estatisticas de uso disponiveis nos dois modos
+ * Autor: Gabriel Agune
+ */
+
+#ifndef USBX_MEMORIA_H
+#define USBX_MEMORIA_H
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// ============================================================
+// Definicoes de Configuracao
+// ============================================================
+
+// 1: arena estatica (so alocacoes de inicializacao, caso do USBX standalone)
+// 0: byte pool do proprio USBX (UX_DEVICE_APP_MEM_POOL_SIZE original)
+#ifndef USBX_MEMORIA_ARENA
+#define USBX_MEMORIA_ARENA          1
+#endif
+
+#define USBX_MEMORIA_MAX_BLOCOS     24U   // Blocos rastreados para devolucao LIFO
+#define USBX_MEMORIA_FOLGA          32U   // Margem da arena alem do calculado
+
+// ============================================================
+// Tipos de Dados Publicos
+// ============================================================
+
+typedef struct {
+    bool     arena;         // true: arena estatica; false: byte pool do USBX
+    uint32_t capacidade;    // Bytes disponiveis para alocacao
+    uint32_t em_uso;        // Bytes ocupados (inclui alinhamento e cabecalhos)
+    uint32_t pico;
+    uint32_t alocacoes;
+    uint32_t liberacoes;
+    uint32_t retidos;       // Liberacoes fora de ordem (arena nao recupera)
+    uint32_t falhas;
+    uint32_t maior_pedido;
+} USBX_Memoria_Stats_t;
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Copia as estatisticas de alocacao do USBX
+void USBX_Memoria_Get_Stats(USBX_Memoria_Stats_t *stats);
+
+#endif // USBX_MEMORIA_H
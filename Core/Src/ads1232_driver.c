@@ -23,6 +23,8 @@ static int32_t         s_cal_zero_adc = 0;
 static int32_t         s_adc_offset   = 0;
 static float           s_final_grams  = 0.0f;
 static bool            s_new_data_available = false;
+static int32_t         s_last_raw     = 0;
+static uint32_t        s_raw_count    = 0;
 
 // Buffer para filtro de mediana
 static int32_t s_sample_buffer[MEDIAN_FILTER_SIZE];
@@ -122,6 +124,8 @@ void ADS1232_Process(void) {
 
         // L o dado bruto via SPI (Bit-bang)
         int32_t raw = ReadRawSPI();
+        s_last_raw = raw;
+        s_raw_count++;
         
         // Adiciona ao buffer e filtra
         AddSampleAndFilter(raw);
@@ -140,6 +144,15 @@ float ADS1232_GetGrams(void) {
     return s_final_grams;
 }
 
+void ADS1232_GetLastRaw(int32_t* raw, uint32_t* contador) {
+    if (raw != NULL) {
+        *raw = s_last_raw;
+    }
+    if (contador != NULL) {
+        *contador = s_raw_count;
+    }
+}
+
 void ADS1232_SetTareCurrent(void) {
     // Usa a ltima mediana calculada como offset
     int32_t current_median = CalculateMedian(); 
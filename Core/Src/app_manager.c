@@ -16,6 +16,8 @@
 #include "pwm_servo_driver.h"
 #include "cli_driver.h"
 #include "eeprom_driver.h"
+#include "crc_service.h"
+#include "i2c_bus_manager.h"
 #include "ads1232_driver.h"
 #include "pcb_frequency.h"
 #include "temp_sensor.h"
@@ -25,6 +27,9 @@
 #include "medicao_handler.h"
 #include "rtc_driver.h"
 #include "battery_handler.h"
+#include "telemetria_stream.h"
+#include "dfu_runtime.h"
+#include "canal_hid.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -55,14 +60,25 @@ static bool Test_RTC(void);
 void App_Manager_Init(void) {
     // 1. Inicializao de Drivers de Baixo Nvel
     DWIN_Driver_Init(&huart2, Controller_DwinCallback);
+    I2C_Bus_Init(&hi2c1);
     EEPROM_Driver_Init(&hi2c1);
     RTC_Driver_Init(&hrtc);
     ADS1232_Init();
     Frequency_Init();
-    Servos_Init();
     
+    CRC_Service_Init(&hcrc);
+    if (!CRC_Service_Auto_Teste()) {
+        printf("CRC Service: Falha no auto-teste do periferico!\r\n");
+    }
+
+    // Imagem gravada via DFU com CRC divergente: volta ao bootloader para regravar
+    if (DFU_Runtime_Verificar_Imagem(NULL, NULL) == DFU_IMAGEM_CORROMPIDA) {
+        DFU_Runtime_Entrar_Bootloader();
+    }
+
     // 2. Inicializao de Middleware/Logic
     Gerenciador_Config_Init(&hcrc);
+    Servos_Init(); // L os trims dos servos na EEPROM (usa o CRC)
     Medicao_Init();
     DisplayHandler_Init();
     Battery_Handler_Init(&hi2c1);
@@ -79,8 +95,11 @@ void App_Manager_Init(void) {
 
     // Tarefas de Comunicao e Alta Prioridade
     Scheduler_Register_Task(USB_Process,               5,   0);  // USB Stack (5ms)
-    Scheduler_Register_Task(CLI_TX_Pump,               10,  5);  // CLI TX (10ms)
     Scheduler_Register_Task(DWIN_Driver_Process,       20,  10); // DWIN RX Parser (20ms)
+    Scheduler_Register_Task(I2C_Bus_Process,           1,   0);  // Timeouts/ACK polling I2C1 (1ms)
+    Scheduler_Register_Task(Telemetria_Stream_Process, 1,   0);  // Telemetria binria (1ms, inativa por padro)
+    Scheduler_Register_Task(DFU_Runtime_Process,       10,  0);  // DFU_DETACH -> bootloader da ROM (10ms)
+    Scheduler_Register_Task(Canal_HID_Process,         1,   0);  // Relatrio HID de entrada (1ms)
 
     // Tarefas de Controle e Hardware
     Scheduler_Register_Task(Servos_Process,            20,  15); // Movimento Servos (20ms)
@@ -89,7 +108,7 @@ void App_Manager_Init(void) {
 
     // Tarefas de Interface e Lgica Lenta
     Scheduler_Register_Task(DisplayHandler_Process,    100, 100); // Atualizao UI (100ms)
-    Scheduler_Register_Task(Battery_Handler_Process,   1000,500); // Monitor Bateria (1s)
+    Scheduler_Register_Task(Battery_Handler_Process,   50,  500); // Monitor Bateria (amostras adaptativas via INT do BQ25622)
 }
 
 // Loop principal (agora apenas roda o scheduler)
@@ -71,7 +71,7 @@ void Battery_Handler_Process(void) {
         return;
     }
 
-    // Atualiza o clculo do SoC a cada ciclo (controlado internamente pelo bq_soc)
+    // Conduz a amostragem do SoC (intervalo adaptativo e eventos do INT, controlados pelo bq_soc)
     bq_soc_coulomb_update(s_hi2c);
 
     // Atualiza a interface grfica a cada intervalo definido
@@ -88,7 +88,9 @@ void Battery_Handler_Process(void) {
         }
 
         // Se estiver na tela de diagnstico de bateria, atualiza dados em tempo real
-        if (Controller_GetCurrentScreen() == TELA_BATERIA) {
+        uint8_t tela_bateria = (Controller_GetCurrentScreen() == TELA_BATERIA) ? 1 : 0;
+        bq_soc_set_modo_rapido(tela_bateria);
+        if (tela_bateria) {
             update_battery_screen_data();
         }
     }
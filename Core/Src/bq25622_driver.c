@@ -5,6 +5,7 @@
  */
 
 #include "bq25622_driver.h"
+#include "i2c_bus_manager.h"
 
 // ============================================================
 // Defines Internos
@@ -12,24 +13,46 @@
 
 #define BQ25622_I2C_TIMEOUT     100 // ms
 
+// ============================================================
+// Variveis Privadas
+// ============================================================
+
+// Estado do snapshot no-bloqueante (o buffer pertence ao barramento enquanto pendente)
+typedef enum {
+    SNAPSHOT_OCIOSO = 0,
+    SNAPSHOT_PENDENTE,
+    SNAPSHOT_PRONTO,
+    SNAPSHOT_FALHOU
+} SnapshotEstado_t;
+
+static uint8_t                   s_snapshot_buf[BQ25622_SNAPSHOT_TAMANHO];
+static uint8_t                   s_adc_ctrl_buf;    // Dado da escrita one-shot (vive at o fim da transao)
+static volatile SnapshotEstado_t s_snapshot_estado = SNAPSHOT_OCIOSO;
+
 // ============================================================
 // Funes Privadas (Auxiliares I2C)
 // ============================================================
 
+// Obs: o I2C1  compartilhado com a EEPROM; todos os acessos passam pela fila
+// do i2c_bus_manager. O parmetro hi2c  mantido por compatibilidade da API.
+
 // L um registrador de 8 bits
 static HAL_StatusTypeDef bq25622_read_reg_8bit(I2C_HandleTypeDef *hi2c, uint8_t reg_addr, uint8_t *pData) {
-    return HAL_I2C_Mem_Read(hi2c, BQ25622_I2C_ADDR_8BIT, reg_addr, I2C_MEMADD_SIZE_8BIT, pData, 1, BQ25622_I2C_TIMEOUT);
+    (void)hi2c;
+    return I2C_Bus_Mem_Read_Blocking(BQ25622_I2C_ADDR_8BIT, reg_addr, I2C_MEMADD_SIZE_8BIT, pData, 1, BQ25622_I2C_TIMEOUT);
 }
 
 // Escreve em um registrador de 8 bits
 static HAL_StatusTypeDef bq25622_write_reg_8bit(I2C_HandleTypeDef *hi2c, uint8_t reg_addr, uint8_t data) {
-    return HAL_I2C_Mem_Write(hi2c, BQ25622_I2C_ADDR_8BIT, reg_addr, I2C_MEMADD_SIZE_8BIT, &data, 1, BQ25622_I2C_TIMEOUT);
+    (void)hi2c;
+    return I2C_Bus_Mem_Write_Blocking(BQ25622_I2C_ADDR_8BIT, reg_addr, I2C_MEMADD_SIZE_8BIT, &data, 1, BQ25622_I2C_TIMEOUT);
 }
 
 // L um registrador de 16 bits (Little-Endian)
 static HAL_StatusTypeDef bq25622_read_reg_16bit(I2C_HandleTypeDef *hi2c, uint8_t reg_addr, uint16_t *pData) {
     uint8_t buffer[2];
-    HAL_StatusTypeDef status = HAL_I2C_Mem_Read(hi2c, BQ25622_I2C_ADDR_8BIT, reg_addr, I2C_MEMADD_SIZE_8BIT, buffer, 2, BQ25622_I2C_TIMEOUT);
+    (void)hi2c;
+    HAL_StatusTypeDef status = I2C_Bus_Mem_Read_Blocking(BQ25622_I2C_ADDR_8BIT, reg_addr, I2C_MEMADD_SIZE_8BIT, buffer, 2, BQ25622_I2C_TIMEOUT);
 
     if (status == HAL_OK) {
         *pData = (uint16_t)(buffer[1] << 8) | buffer[0];
@@ -43,7 +66,8 @@ static HAL_StatusTypeDef bq25622_write_reg_16bit(I2C_HandleTypeDef *hi2c, uint8_
     buffer[0] = (uint8_t)(data & 0x00FF);
     buffer[1] = (uint8_t)((data >> 8) & 0x00FF);
 
-    return HAL_I2C_Mem_Write(hi2c, BQ25622_I2C_ADDR_8BIT, reg_addr, I2C_MEMADD_SIZE_8BIT, buffer, 2, BQ25622_I2C_TIMEOUT);
+    (void)hi2c;
+    return I2C_Bus_Mem_Write_Blocking(BQ25622_I2C_ADDR_8BIT, reg_addr, I2C_MEMADD_SIZE_8BIT, buffer, 2, BQ25622_I2C_TIMEOUT);
 }
 
 // Modifica bits especficos (Read-Modify-Write)
@@ -61,6 +85,84 @@ static HAL_StatusTypeDef bq25622_modify_reg_8bit(I2C_HandleTypeDef *hi2c, uint8_
     return bq25622_write_reg_8bit(hi2c, reg_addr, reg_val);
 }
 
+// ============================================================
+// Funes Privadas (Converso ADC)
+// ============================================================
+
+static float bq25622_conv_vbat(uint16_t raw) {
+    return (float)((raw & 0x1FFE) >> 1) * BQ25622_VBAT_LSB_V;
+}
+
+static float bq25622_conv_vsys(uint16_t raw) {
+    return (float)((raw & 0x1FFE) >> 1) * BQ25622_VSYS_LSB_V;
+}
+
+static float bq25622_conv_vbus(uint16_t raw) {
+    return (float)((raw & 0x7FFC) >> 2) * BQ25622_VBUS_LSB_V;
+}
+
+static float bq25622_conv_ibat(uint16_t raw) {
+    return (float)((int16_t)raw >> 2) * BQ25622_IBAT_LSB_A;
+}
+
+static float bq25622_conv_ibus(uint16_t raw) {
+    return (float)((int16_t)raw >> 1) * BQ25622_IBUS_LSB_A;
+}
+
+// Temperatura do die com extenso de sinal do bit 11
+static float bq25622_conv_tdie(uint16_t raw) {
+    int16_t adc_val = (int16_t)(raw & 0x0FFF);
+    if (adc_val & 0x0800) {
+        adc_val |= (int16_t)0xF000;
+    }
+    return (float)adc_val * BQ25622_TDIE_LSB_C;
+}
+
+static BQ25622_ChargeStatus_t bq25622_conv_chg_status(uint8_t reg_val) {
+    return (BQ25622_ChargeStatus_t)((reg_val >> BQ25622_CHG_STAT_SHIFT) & BQ25622_CHG_STAT_MASK);
+}
+
+// ============================================================
+// Funes Privadas (Snapshot)
+// ============================================================
+
+// Registrador de 16 bits (Little-Endian) dentro do buffer do snapshot
+static uint16_t bq25622_snapshot_reg16(const uint8_t *buf, uint8_t reg_addr) {
+    const uint8_t *p = &buf[reg_addr - BQ25622_SNAPSHOT_REG_INICIO];
+    return (uint16_t)(p[1] << 8) | p[0];
+}
+
+// Decodifica todos os canais a partir do buffer bruto
+static void bq25622_snapshot_decode(const uint8_t *buf, BQ25622_Snapshot_t *snap) {
+    snap->status_1     = buf[BQ25622_REG_CHG_STATUS_1   - BQ25622_SNAPSHOT_REG_INICIO];
+    snap->fault_status = buf[BQ25622_REG_FAULT_STATUS_0 - BQ25622_SNAPSHOT_REG_INICIO];
+    snap->flag_0       = buf[BQ25622_REG_CHG_FLAG_0     - BQ25622_SNAPSHOT_REG_INICIO];
+    snap->flag_1       = buf[BQ25622_REG_CHG_FLAG_1     - BQ25622_SNAPSHOT_REG_INICIO];
+    snap->fault_flag   = buf[BQ25622_REG_FAULT_FLAG_0   - BQ25622_SNAPSHOT_REG_INICIO];
+    snap->chg_status   = bq25622_conv_chg_status(snap->status_1);
+
+    uint16_t raw_ibat = bq25622_snapshot_reg16(buf, BQ25622_REG_IBAT_ADC);
+    uint16_t raw_vbus = bq25622_snapshot_reg16(buf, BQ25622_REG_VBUS_ADC);
+    uint16_t raw_vbat = bq25622_snapshot_reg16(buf, BQ25622_REG_VBAT_ADC);
+
+    snap->ibat_mA = (int32_t)((int16_t)raw_ibat >> 2) * BQ25622_IBAT_LSB_MA;
+    snap->vbus_mV = (uint16_t)((((raw_vbus & 0x7FFC) >> 2) * BQ25622_VBUS_LSB_UV) / 1000);
+    snap->vbat_mV = (uint16_t)((((raw_vbat & 0x1FFE) >> 1) * BQ25622_VBAT_LSB_UV) / 1000);
+
+    snap->ibus_A = bq25622_conv_ibus(bq25622_snapshot_reg16(buf, BQ25622_REG_IBUS_ADC));
+    snap->ibat_A = bq25622_conv_ibat(raw_ibat);
+    snap->vbus_V = bq25622_conv_vbus(raw_vbus);
+    snap->vbat_V = bq25622_conv_vbat(raw_vbat);
+    snap->vsys_V = bq25622_conv_vsys(bq25622_snapshot_reg16(buf, BQ25622_REG_VSYS_ADC));
+    snap->tdie_C = bq25622_conv_tdie(bq25622_snapshot_reg16(buf, BQ25622_REG_TDIE_ADC));
+}
+
+// Concluso da rajada (contexto de ISR): s sinaliza, a decodificao fica no poll
+static void bq25622_snapshot_callback(bool sucesso, void *ctx) {
+    (void)ctx;
+    s_snapshot_estado = sucesso ? SNAPSHOT_PRONTO : SNAPSHOT_FALHOU;
+}
+
 // ============================================================
 // Funes Pblicas
 // ============================================================
@@ -119,7 +221,34 @@ HAL_StatusTypeDef bq25622_init(I2C_HandleTypeDef *hi2c, uint16_t battery_capacit
 // Habilita o ADC em modo contnuo com mdia
 HAL_StatusTypeDef bq25622_adc_init(I2C_HandleTypeDef *hi2c) {
     uint8_t adc_ctrl = BQ25622_ADC_EN_BIT | BQ25622_ADC_AVG_BIT;
-    return bq25622_write_reg_8bit(hi2c, BQ25622_REG_ADC_CONTROL, adc_ctrl);
+    HAL_StatusTypeDef status = bq25622_write_reg_8bit(hi2c, BQ25622_REG_ADC_CONTROL, adc_ctrl);
+    if (status != HAL_OK) return status;
+
+    // Garante o pulso no INT ao fim de cada converso (usado no modo one-shot)
+    return bq25622_modify_reg_8bit(hi2c, BQ25622_REG_CHG_MASK_0, BQ25622_ADC_DONE_BIT, 0x00);
+}
+
+// Dispara uma converso one-shot em 12 bits; o ADC_EN volta a zero sozinho ao final
+HAL_StatusTypeDef bq25622_adc_oneshot_start(I2C_HandleTypeDef *hi2c, uint8_t media) {
+    (void)hi2c;
+
+    s_adc_ctrl_buf = BQ25622_ADC_EN_BIT | BQ25622_ADC_RATE_BIT | BQ25622_ADC_AVG_BIT;
+    if (!media) {
+        s_adc_ctrl_buf |= BQ25622_ADC_AVG_INIT_BIT;
+    }
+
+    I2C_Bus_Transacao_t t = {0};
+    t.op            = I2C_BUS_OP_WRITE;
+    t.dev_addr      = BQ25622_I2C_ADDR_8BIT;
+    t.mem_addr      = BQ25622_REG_ADC_CONTROL;
+    t.mem_addr_size = I2C_MEMADD_SIZE_8BIT;
+    t.p_data        = &s_adc_ctrl_buf;
+    t.size          = 1;
+    t.timeout_ms    = BQ25622_I2C_TIMEOUT;
+    t.callback      = NULL;     // Falhas aparecem como ausncia de ADC_DONE
+    t.ctx           = NULL;
+
+    return I2C_Bus_Submit(&t, I2C_BUS_PRIO_BAIXA) ? HAL_OK : HAL_BUSY;
 }
 
 // L a tenso da bateria (VBAT) convertida para Volts
@@ -128,8 +257,7 @@ HAL_StatusTypeDef bq25622_read_vbat(I2C_HandleTypeDef *hi2c, float *vbat_V) {
     HAL_StatusTypeDef status = bq25622_read_reg_16bit(hi2c, BQ25622_REG_VBAT_ADC, &raw_adc);
 
     if (status == HAL_OK) {
-        uint16_t adc_val = (raw_adc & 0x1FFE) >> 1;
-        *vbat_V = (float)adc_val * BQ25622_VBAT_LSB_V;
+        *vbat_V = bq25622_conv_vbat(raw_adc);
     }
     return status;
 }
@@ -140,9 +268,7 @@ HAL_StatusTypeDef bq25622_read_ibat(I2C_HandleTypeDef *hi2c, float *ibat_A) {
     HAL_StatusTypeDef status = bq25622_read_reg_16bit(hi2c, BQ25622_REG_IBAT_ADC, &raw_adc);
 
     if (status == HAL_OK) {
-        int16_t signed_raw = (int16_t)raw_adc;
-        int16_t adc_val = signed_raw >> 2;
-        *ibat_A = (float)adc_val * BQ25622_IBAT_LSB_A;
+        *ibat_A = bq25622_conv_ibat(raw_adc);
     }
     return status;
 }
@@ -153,8 +279,7 @@ HAL_StatusTypeDef bq25622_read_vbus(I2C_HandleTypeDef *hi2c, float *vbus_V) {
     HAL_StatusTypeDef status = bq25622_read_reg_16bit(hi2c, BQ25622_REG_VBUS_ADC, &raw_adc);
 
     if (status == HAL_OK) {
-        uint16_t adc_val = (raw_adc & 0x7FFC) >> 2;
-        *vbus_V = (float)adc_val * BQ25622_VBUS_LSB_V;
+        *vbus_V = bq25622_conv_vbus(raw_adc);
     }
     return status;
 }
@@ -165,8 +290,7 @@ HAL_StatusTypeDef bq25622_read_charge_status(I2C_HandleTypeDef *hi2c, BQ25622_Ch
     HAL_StatusTypeDef status = bq25622_read_reg_8bit(hi2c, BQ25622_REG_CHG_STATUS_1, &reg_val);
 
     if (status == HAL_OK) {
-        uint8_t status_bits = (reg_val >> BQ25622_CHG_STAT_SHIFT) & BQ25622_CHG_STAT_MASK;
-        *chg_status = (BQ25622_ChargeStatus_t)status_bits;
+        *chg_status = bq25622_conv_chg_status(reg_val);
     }
     return status;
 }
@@ -183,18 +307,77 @@ HAL_StatusTypeDef bq25622_read_die_temp(I2C_HandleTypeDef *hi2c, float *die_temp
     HAL_StatusTypeDef status = bq25622_read_reg_16bit(hi2c, BQ25622_REG_TDIE_ADC, &raw_adc);
 
     if (status == HAL_OK) {
-        int16_t adc_val = (int16_t)(raw_adc & 0x0FFF);
-        
-        // Extenso de sinal do bit 11
-        if (adc_val & 0x0800) {
-            adc_val |= 0xF000;
-        }
+        *die_temp_C = bq25622_conv_tdie(raw_adc);
+    }
+    return status;
+}
 
-        *die_temp_C = (float)adc_val * BQ25622_TDIE_LSB_C;
+// L status e ADC em uma nica transao com auto-incremento
+HAL_StatusTypeDef bq25622_read_snapshot(I2C_HandleTypeDef *hi2c, BQ25622_Snapshot_t *snap) {
+    uint8_t buffer[BQ25622_SNAPSHOT_TAMANHO];
+    (void)hi2c;
+
+    if (snap == NULL) {
+        return HAL_ERROR;
+    }
+
+    HAL_StatusTypeDef status = I2C_Bus_Mem_Read_Blocking(BQ25622_I2C_ADDR_8BIT, BQ25622_SNAPSHOT_REG_INICIO, I2C_MEMADD_SIZE_8BIT,
+                                                         buffer, sizeof(buffer), BQ25622_I2C_TIMEOUT);
+    if (status == HAL_OK) {
+        bq25622_snapshot_decode(buffer, snap);
     }
     return status;
 }
 
+// Enfileira a rajada no gerenciador do barramento (concluso por interrupo)
+HAL_StatusTypeDef bq25622_snapshot_start(I2C_HandleTypeDef *hi2c) {
+    (void)hi2c;
+
+    if (s_snapshot_estado == SNAPSHOT_PENDENTE) {
+        return HAL_BUSY;
+    }
+
+    I2C_Bus_Transacao_t t = {0};
+    t.op            = I2C_BUS_OP_READ;
+    t.dev_addr      = BQ25622_I2C_ADDR_8BIT;
+    t.mem_addr      = BQ25622_SNAPSHOT_REG_INICIO;
+    t.mem_addr_size = I2C_MEMADD_SIZE_8BIT;
+    t.p_data        = s_snapshot_buf;
+    t.size          = sizeof(s_snapshot_buf);
+    t.timeout_ms    = BQ25622_I2C_TIMEOUT;
+    t.callback      = bq25622_snapshot_callback;
+    t.ctx           = NULL;
+
+    s_snapshot_estado = SNAPSHOT_PENDENTE;
+    if (!I2C_Bus_Submit(&t, I2C_BUS_PRIO_NORMAL)) {
+        s_snapshot_estado = SNAPSHOT_OCIOSO;
+        return HAL_BUSY;
+    }
+    return HAL_OK;
+}
+
+// Consome o resultado da ltima rajada
+HAL_StatusTypeDef bq25622_snapshot_poll(BQ25622_Snapshot_t *snap) {
+    switch (s_snapshot_estado) {
+        case SNAPSHOT_PRONTO:
+            if (snap != NULL) {
+                bq25622_snapshot_decode(s_snapshot_buf, snap);
+            }
+            s_snapshot_estado = SNAPSHOT_OCIOSO;
+            return HAL_OK;
+
+        case SNAPSHOT_FALHOU:
+            s_snapshot_estado = SNAPSHOT_OCIOSO;
+            return HAL_ERROR;
+
+        case SNAPSHOT_PENDENTE:
+            return HAL_BUSY;
+
+        default:
+            return HAL_ERROR;
+    }
+}
+
 // Habilita modo OTG (Boost) com proteo de tenso
 HAL_StatusTypeDef bq25622_enable_otg(I2C_HandleTypeDef *hi2c, uint8_t enable) {
     float vbus_V = 0.0f;
@@ -6,16 +6,20 @@
 
 #include "bq_soc.h"
 #include "bq25622_driver.h"
+#include "gerenciador_configuracoes.h"
 #include <stddef.h>
-#include <math.h>
+#include <string.h>
 
 // ============================================================
 // Defines e Constantes
 // ============================================================
 
-#define UPDATE_INTERVAL_MS      1000
-static const float UPDATE_INTERVAL_HOURS = (float)UPDATE_INTERVAL_MS / 3600000.0f;
-static const float CURRENT_DEADBAND_A    = 0.008f;
+// Carga em uA*ms: a corrente do ADC (LSB de 4 mA) vezes o dt em ms  exata,
+// sem arredondamento por amostra. 1 mAh = 1000 uA * 3 600 000 ms.
+#define UAMS_POR_UAH            3600000LL
+#define UAMS_POR_MAH            (UAMS_POR_UAH * 1000LL)
+
+static const int32_t CURRENT_DEADBAND_UA  = 8000;
 
 // ============================================================
 // Typedefs e Estruturas
@@ -26,6 +30,20 @@ typedef struct {
     float percentage;
 } SocPoint;
 
+// ltima ncora do aprendizado de capacidade
+typedef enum {
+    ANCORA_NENHUMA = 0,
+    ANCORA_CHEIA,
+    ANCORA_VAZIA
+} Ancora_t;
+
+// Ciclo de uma amostra: one-shot -> ADC_DONE (INT) -> rajada do snapshot
+typedef enum {
+    AMOSTRA_OCIOSA = 0,     // Aguardando o intervalo ou um evento do INT
+    AMOSTRA_CONVERTENDO,    // Converso one-shot em andamento no BQ25622
+    AMOSTRA_LENDO           // Snapshot no barramento
+} AmostraEstado_t;
+
 // ============================================================
 // Variveis Privadas
 // ============================================================
@@ -47,16 +65,38 @@ static const SocPoint soc_table[] = {
 static const size_t soc_table_size = sizeof(soc_table) / sizeof(SocPoint);
 
 // Variveis de Estado do Algoritmo
-static float             g_total_capacity_mAh    = 210.0f;
-static float             g_capacidade_atual_mAh  = 0.0f;
+static int64_t           g_capacidade_uAms       = 210LL * UAMS_POR_MAH;  // Plena carga (aprendida)
+static int64_t           g_carga_uAms            = 0;                     // Carga restante
+static int64_t           g_capacidade_nominal_uAms = 210LL * UAMS_POR_MAH;
 static volatile uint32_t g_systick_counter       = 0;
 static volatile uint8_t  g_update_soc_flag       = 0;
+static volatile uint8_t  g_int_flag              = 0;
+static volatile uint32_t g_intervalo_ms          = BQ_SOC_INTERVALO_RAPIDO_MS;
+
+// Agendamento das Amostras
+static AmostraEstado_t  g_amostra_estado        = AMOSTRA_OCIOSA;
+static uint32_t         g_conversao_tick        = 0;
+static uint32_t         g_ultima_amostra_tick   = 0;
+static uint8_t          g_modo_rapido_forcado   = 0;
+
+// Aprendizado, Ciclos e Checkpoint
+static Ancora_t         g_ancora                = ANCORA_NENHUMA;
+static int64_t          g_aprendizado_uAms      = 0;
+static int64_t          g_descarga_acum_uAms    = 0;
+static uint16_t         g_ciclos                = 0;
+static int64_t          g_checkpoint_uAms       = 0;
+static uint32_t         g_checkpoint_tick       = 0;
+
+// Estatsticas de Deriva
+static BQ_SOC_Stats_t   g_stats;
+static uint64_t         g_stats_tempo_ms        = 0;
 
 // Cache de Leituras Recentes
 static float            g_last_vbat             = 0.0f;
 static float            g_last_vbus             = 0.0f;
-static float            g_last_ibat             = 0.0f;
 static float            g_last_tdie             = 0.0f;
+static uint16_t         g_last_vbus_mV          = 0;
+static int32_t          g_last_ibat_mA          = 0;     // J com deadband
 static BQ25622_ChargeStatus_t g_last_chg_status = CHG_STAT_NOT_CHARGING;
 
 // ============================================================
@@ -93,6 +133,160 @@ static float bq_soc_estimate_percentage_from_voltage(float vbat_V) {
     return 0.0f;
 }
 
+// Rpido enquanto carrega, com cabo, sob carga ou com a tela de bateria aberta
+static uint32_t bq_soc_escolher_intervalo(void) {
+    if (g_modo_rapido_forcado ||
+        g_last_chg_status != CHG_STAT_NOT_CHARGING ||
+        g_last_vbus_mV > BQ_SOC_VBUS_PRESENTE_MV ||
+        g_last_ibat_mA >= BQ_SOC_CORRENTE_CARGA_MA ||
+        g_last_ibat_mA <= -BQ_SOC_CORRENTE_CARGA_MA) {
+        return BQ_SOC_INTERVALO_RAPIDO_MS;
+    }
+    return BQ_SOC_INTERVALO_LENTO_MS;
+}
+
+// Capacidade dentro da faixa plausvel em torno da nominal
+static uint8_t bq_soc_capacidade_plausivel(int64_t capacidade_uAms) {
+    return (capacidade_uAms * 100 >= g_capacidade_nominal_uAms * BQ_SOC_CAPACIDADE_MIN_PCT &&
+            capacidade_uAms * 100 <= g_capacidade_nominal_uAms * BQ_SOC_CAPACIDADE_MAX_PCT) ? 1 : 0;
+}
+
+// Ajuste forado da carga (ncora ou saturao): a diferena  a deriva do contador
+static void bq_soc_corrigir_carga(int64_t nova_uAms) {
+    int64_t correcao_uAh = (nova_uAms - g_carga_uAms) / UAMS_POR_UAH;
+    if (correcao_uAh != 0) {
+        g_stats.correcoes++;
+        g_stats.correcao_ultima_uAh = (int32_t)correcao_uAh;
+        g_stats.correcao_total_uAh += (uint32_t)((correcao_uAh < 0) ? -correcao_uAh : correcao_uAh);
+    }
+    g_carga_uAms = nova_uAms;
+}
+
+// Registra uma ncora (cheia/vazia). Vindo da ncora oposta, a carga lquida
+// acumulada no caminho  uma medida da capacidade real. Retorna 1 se mudou.
+static uint8_t bq_soc_ancorar(Ancora_t nova) {
+    if (g_ancora == nova) {
+        return 0;
+    }
+    if (g_ancora != ANCORA_NENHUMA && bq_soc_capacidade_plausivel(g_aprendizado_uAms)) {
+        // Mdia com a estimativa anterior: um ciclo ruim no derruba o valor
+        g_capacidade_uAms = (g_capacidade_uAms + g_aprendizado_uAms) / 2;
+    }
+    g_ancora = nova;
+    g_aprendizado_uAms = 0;
+    return 1;
+}
+
+// Agenda a gravao do estado: em eventos ou aps variao relevante de carga
+static void bq_soc_checkpoint(uint8_t forcar) {
+    uint32_t agora = HAL_GetTick();
+
+    if (!forcar) {
+        int64_t delta = g_carga_uAms - g_checkpoint_uAms;
+        if (delta < 0) {
+            delta = -delta;
+        }
+        if (delta * 100 < g_capacidade_uAms * BQ_SOC_CHECKPOINT_DELTA_PCT ||
+            (agora - g_checkpoint_tick) < BQ_SOC_CHECKPOINT_MIN_MS) {
+            return;
+        }
+    }
+
+    Config_Bateria_t reg = {0};
+    reg.carga_uAh         = (int32_t)(g_carga_uAms / UAMS_POR_UAH);
+    reg.capacidade_uAh    = (int32_t)(g_capacidade_uAms / UAMS_POR_UAH);
+    reg.aprendizado_uAh   = (int32_t)(g_aprendizado_uAms / UAMS_POR_UAH);
+    reg.descarga_acum_uAh = (int32_t)(g_descarga_acum_uAms / UAMS_POR_UAH);
+    reg.ciclos            = g_ciclos;
+    reg.ancora            = (uint8_t)g_ancora;
+    Gerenciador_Config_Set_Bateria(&reg);
+
+    g_checkpoint_uAms = g_carga_uAms;
+    g_checkpoint_tick = agora;
+}
+
+// Estatsticas do intervalo real entre amostras
+static void bq_soc_registrar_dt(uint32_t dt_ms) {
+    if (g_stats.amostras == 0 || dt_ms < g_stats.dt_min_ms) {
+        g_stats.dt_min_ms = dt_ms;
+    }
+    if (dt_ms > g_stats.dt_max_ms) {
+        g_stats.dt_max_ms = dt_ms;
+    }
+    // Atraso sobre o intervalo programado (amostras por INT chegam adiantadas)
+    if (dt_ms > g_intervalo_ms && (dt_ms - g_intervalo_ms) > g_stats.atraso_max_ms) {
+        g_stats.atraso_max_ms = dt_ms - g_intervalo_ms;
+    }
+    g_stats.amostras++;
+    g_stats_tempo_ms += dt_ms;
+}
+
+// Integrao de corrente (Coulomb Counting) em uA*ms sobre o dt medido
+static void bq_soc_integrar(const BQ25622_Snapshot_t *snap, uint32_t dt_ms) {
+    uint16_t vbus_mV = snap->vbus_mV;
+    uint16_t vbat_mV = snap->vbat_mV;
+    BQ25622_ChargeStatus_t status_now = snap->chg_status;
+
+    bq_soc_registrar_dt(dt_ms);
+
+    // 1. Filtragem de Corrente (Deadband)
+    int32_t ibat_uA = snap->ibat_mA * 1000;
+    if (ibat_uA > -CURRENT_DEADBAND_UA && ibat_uA < CURRENT_DEADBAND_UA) {
+        ibat_uA = 0;
+    }
+
+    // 2. Lgica de Integrao
+    uint8_t evento = 0;
+    // Se estiver conectado ao carregador, carga cheia e tenso alta: fora 100%
+    if (vbus_mV > BQ_SOC_VBUS_PRESENTE_MV && status_now == CHG_STAT_NOT_CHARGING && vbat_mV > BQ_SOC_VBAT_CHEIA_MV) {
+        evento = bq_soc_ancorar(ANCORA_CHEIA);
+        bq_soc_corrigir_carga(g_capacidade_uAms);
+        ibat_uA = 0;
+    } else {
+        int64_t delta_uAms = (int64_t)ibat_uA * dt_ms;
+        g_carga_uAms += delta_uAms;
+
+        // Carga lquida no sentido oposto ao da ltima ncora
+        g_aprendizado_uAms += (g_ancora == ANCORA_CHEIA) ? -delta_uAms : delta_uAms;
+
+        // Um ciclo a cada capacidade completa descarregada
+        if (delta_uAms < 0) {
+            g_descarga_acum_uAms -= delta_uAms;
+            if (g_descarga_acum_uAms >= g_capacidade_uAms) {
+                g_descarga_acum_uAms -= g_capacidade_uAms;
+                g_ciclos++;
+                evento = 1;
+            }
+        }
+
+        // Sem cabo, carga leve e tenso no corte: bateria vazia (zera a deriva)
+        if (vbus_mV < BQ_SOC_VBUS_PRESENTE_MV && vbat_mV < BQ_SOC_VBAT_VAZIA_MV &&
+            ibat_uA > -(BQ_SOC_CORRENTE_CARGA_MA * 1000) && ibat_uA < (BQ_SOC_CORRENTE_CARGA_MA * 1000)) {
+            evento |= bq_soc_ancorar(ANCORA_VAZIA);
+            bq_soc_corrigir_carga(0);
+        }
+    }
+
+    // 3. Clamp (Limites de Segurana)
+    if (g_carga_uAms > g_capacidade_uAms) {
+        bq_soc_corrigir_carga(g_capacidade_uAms);
+    }
+    if (g_carga_uAms < 0) {
+        bq_soc_corrigir_carga(0);
+    }
+
+    // 4. Atualizao do Cache Global
+    g_last_vbus = snap->vbus_V;
+    g_last_vbat = snap->vbat_V;
+    g_last_vbus_mV = vbus_mV;
+    g_last_ibat_mA = ibat_uA / 1000;
+    g_last_chg_status = status_now;
+    g_last_tdie = snap->tdie_C;
+
+    // 5. Persistncia (assncrona, pelo gerenciador de configuraes)
+    bq_soc_checkpoint(evento);
+}
+
 // ============================================================
 // Funes Pblicas
 // ============================================================
@@ -100,91 +294,162 @@ static float bq_soc_estimate_percentage_from_voltage(float vbat_V) {
 // Callback do timer do sistema para agendar atualizaes
 void bq_soc_systick_callback(void) {
     g_systick_counter++;
-    if (g_systick_counter >= UPDATE_INTERVAL_MS) {
+    if (g_systick_counter >= g_intervalo_ms) {
         g_systick_counter = 0;
         g_update_soc_flag = 1;
     }
 }
 
-// Inicializa o mdulo, definindo capacidade total e estimativa inicial
+// Pulso no INT do BQ25622 (contexto de ISR): fim de converso ou mudana de estado
+void bq_soc_int_callback(void) {
+    g_int_flag = 1;
+}
+
+// Fora o intervalo rpido (ex.: tela de diagnstico da bateria aberta)
+void bq_soc_set_modo_rapido(uint8_t ativo) {
+    if (g_modo_rapido_forcado == ativo) {
+        return;
+    }
+    g_modo_rapido_forcado = ativo;
+    g_intervalo_ms = bq_soc_escolher_intervalo();
+    if (ativo) {
+        g_update_soc_flag = 1; // Amostra imediata ao entrar na tela
+    }
+}
+
+// Inicializa o mdulo: restaura o ltimo checkpoint da EEPROM e, sem ele,
+// estima a carga pela tenso
 void bq_soc_coulomb_init(I2C_HandleTypeDef *hi2c, uint16_t battery_capacity_mah) {
-    g_total_capacity_mAh = (float)battery_capacity_mah;
-    float vbat_inicial = 0.0f;
+    g_capacidade_nominal_uAms = (int64_t)battery_capacity_mah * UAMS_POR_MAH;
+    g_capacidade_uAms = g_capacidade_nominal_uAms;
+    BQ25622_Snapshot_t snap;
+    int32_t perc_tensao = -1;
+
+    // Leitura inicial de todos os canais em uma nica rajada
+    if (bq25622_read_snapshot(hi2c, &snap) == HAL_OK) {
+        g_last_vbat = snap.vbat_V;
+        g_last_vbus = snap.vbus_V;
+        g_last_vbus_mV = snap.vbus_mV;
+        g_last_chg_status = snap.chg_status;
+        g_last_tdie = snap.tdie_C;
+        perc_tensao = (int32_t)bq_soc_estimate_percentage_from_voltage(snap.vbat_V);
+    }
 
-    if (bq25622_read_vbat(hi2c, &vbat_inicial) == HAL_OK) {
-        g_last_vbat = vbat_inicial;
-        float perc_inicial = bq_soc_estimate_percentage_from_voltage(vbat_inicial);
-        g_capacidade_atual_mAh = (perc_inicial / 100.0f) * g_total_capacity_mAh;
-    } else {
-        // Falha na leitura: assume 50%
-        g_capacidade_atual_mAh = g_total_capacity_mAh / 2.0f;
+    Config_Bateria_t reg;
+    uint8_t restaurado = 0;
+    if (Gerenciador_Config_Get_Bateria(&reg) &&
+        bq_soc_capacidade_plausivel((int64_t)reg.capacidade_uAh * UAMS_POR_UAH)) {
+        g_capacidade_uAms = (int64_t)reg.capacidade_uAh * UAMS_POR_UAH;
+        g_carga_uAms = (int64_t)reg.carga_uAh * UAMS_POR_UAH;
+        if (g_carga_uAms > g_capacidade_uAms) g_carga_uAms = g_capacidade_uAms;
+        if (g_carga_uAms < 0) g_carga_uAms = 0;
+        g_aprendizado_uAms = (int64_t)reg.aprendizado_uAh * UAMS_POR_UAH;
+        g_descarga_acum_uAms = (int64_t)reg.descarga_acum_uAh * UAMS_POR_UAH;
+        g_ciclos = reg.ciclos;
+        g_ancora = (reg.ancora <= ANCORA_VAZIA) ? (Ancora_t)reg.ancora : ANCORA_NENHUMA;
+        restaurado = 1;
+
+        // Bateria trocada ou longo perodo desligado: o checkpoint no representa
+        // mais a carga. No boot a carga  leve, ento a tenso  confivel aqui.
+        int32_t perc_restaurado = (int32_t)((g_carga_uAms * 100) / g_capacidade_uAms);
+        int32_t divergencia = perc_restaurado - perc_tensao;
+        if (divergencia < 0) {
+            divergencia = -divergencia;
+        }
+        if (perc_tensao >= 0 && divergencia > BQ_SOC_DIVERGENCIA_MAX_PCT) {
+            restaurado = 0;
+            g_ancora = ANCORA_NENHUMA;
+            g_aprendizado_uAms = 0;
+        }
     }
 
-    // Leituras iniciais de cache
-    bq25622_read_vbus(hi2c, &g_last_vbus);
-    bq25622_read_charge_status(hi2c, &g_last_chg_status);
-    bq25622_read_die_temp(hi2c, &g_last_tdie);
+    if (!restaurado) {
+        // Sem checkpoint coerente: estimativa por tenso ou, sem leitura, 50%
+        int32_t perc_inicial = (perc_tensao >= 0) ? perc_tensao : 50;
+        g_carga_uAms = (g_capacidade_uAms * perc_inicial) / 100;
+    }
+    g_checkpoint_uAms = g_carga_uAms;
+    g_checkpoint_tick = HAL_GetTick();
 
     g_systick_counter = 0;
     g_update_soc_flag = 0;
+    g_int_flag = 0;
+    g_amostra_estado = AMOSTRA_OCIOSA;
+    g_ultima_amostra_tick = HAL_GetTick();
+    g_intervalo_ms = bq_soc_escolher_intervalo();
 }
 
-// Executa a integrao de corrente (Coulomb Counting)
+// Conduz o ciclo de amostragem; a integrao s roda quando h snapshot novo
 void bq_soc_coulomb_update(I2C_HandleTypeDef *hi2c) {
-    if (!g_update_soc_flag) {
-        return;
-    }
-    g_update_soc_flag = 0;
-
-    float vbus_now, vbat_now, ibat_now_raw, tdie_now;
-    BQ25622_ChargeStatus_t status_now;
-
-    // 1. Coleta de Dados
-    bq25622_read_vbus(hi2c, &vbus_now);
-    bq25622_read_vbat(hi2c, &vbat_now);
-    bq25622_read_ibat(hi2c, &ibat_now_raw);
-    bq25622_read_charge_status(hi2c, &status_now);
-    bq25622_read_die_temp(hi2c, &tdie_now);
-
-    // 2. Filtragem de Corrente (Deadband)
-    float ibat_now = ibat_now_raw;
-    if (fabs(ibat_now) < CURRENT_DEADBAND_A) {
-        ibat_now = 0.0f;
+    BQ25622_Snapshot_t snap;
+    HAL_StatusTypeDef status;
+
+    switch (g_amostra_estado) {
+        case AMOSTRA_OCIOSA:
+            // Intervalo vencido ou evento no INT (cabo, status de carga, falha)
+            if (!g_update_soc_flag && !g_int_flag) {
+                return;
+            }
+            // Mdia mvel s entre amostras prximas; aps um intervalo longo reinicia
+            if (bq25622_adc_oneshot_start(hi2c, g_intervalo_ms == BQ_SOC_INTERVALO_RAPIDO_MS) != HAL_OK) {
+                return; // Fila do barramento cheia: tenta na prxima chamada
+            }
+            g_update_soc_flag = 0;
+            g_int_flag = 0;
+            g_conversao_tick = HAL_GetTick();
+            g_amostra_estado = AMOSTRA_CONVERTENDO;
+            return;
+
+        case AMOSTRA_CONVERTENDO:
+            // Sem o pulso de ADC_DONE a amostra sai pelo timeout (valores da converso anterior)
+            if (!g_int_flag && (HAL_GetTick() - g_conversao_tick) < BQ_SOC_ONESHOT_TIMEOUT_MS) {
+                return;
+            }
+            g_int_flag = 0;
+            if (bq25622_snapshot_start(hi2c) == HAL_OK) {
+                g_amostra_estado = AMOSTRA_LENDO;
+            }
+            return;
+
+        case AMOSTRA_LENDO:
+        default:
+            status = bq25622_snapshot_poll(&snap);
+            if (status == HAL_BUSY) {
+                return;
+            }
+            if (status != HAL_OK) {
+                g_amostra_estado = AMOSTRA_OCIOSA;
+                return;
+            }
+            break;
     }
 
-    // 3. Lgica de Integrao
-    // Se estiver conectado ao carregador, carga cheia e tenso alta: fora 100%
-    if (vbus_now > 4.5f && status_now == CHG_STAT_NOT_CHARGING && vbat_now > 4.15f) {
-        g_capacidade_atual_mAh = g_total_capacity_mAh;
-        ibat_now = 0.0f;
-    } else {
-        float ibat_mA = ibat_now * 1000.0f;
-        float delta_mAh = ibat_mA * UPDATE_INTERVAL_HOURS;
-        g_capacidade_atual_mAh += delta_mAh;
+    // INT de mudana de estado antes do fim da converso: o status  aproveitado,
+    // mas a integrao espera o ADC_DONE (a flag j foi limpa pela leitura)
+    if (!(snap.flag_0 & BQ25622_ADC_DONE_BIT) &&
+        (HAL_GetTick() - g_conversao_tick) < BQ_SOC_ONESHOT_TIMEOUT_MS) {
+        g_last_chg_status = snap.chg_status;
+        g_amostra_estado = AMOSTRA_CONVERTENDO;
+        return;
     }
 
-    // 4. Clamp (Limites de Segurana)
-    if (g_capacidade_atual_mAh > g_total_capacity_mAh) {
-        g_capacidade_atual_mAh = g_total_capacity_mAh;
-    }
-    if (g_capacidade_atual_mAh < 0.0f) {
-        g_capacidade_atual_mAh = 0.0f;
-    }
+    uint32_t agora = HAL_GetTick();
+    bq_soc_integrar(&snap, agora - g_ultima_amostra_tick);
+    g_ultima_amostra_tick = agora;
 
-    // 5. Atualizao do Cache Global
-    g_last_vbus = vbus_now;
-    g_last_vbat = vbat_now;
-    g_last_ibat = ibat_now;
-    g_last_chg_status = status_now;
-    g_last_tdie = tdie_now;
+    // Prximo intervalo conforme o novo estado; o contador recomea desta amostra
+    g_intervalo_ms = bq_soc_escolher_intervalo();
+    g_systick_counter = 0;
+    g_update_soc_flag = 0;
+    g_amostra_estado = AMOSTRA_OCIOSA;
 }
 
-// Retorna a porcentagem calculada
+// Retorna a porcentagem calculada (dcimos de % em inteiro, float s na sada)
 float bq_soc_get_percentage(void) {
-    if (g_total_capacity_mAh <= 0.0f) {
+    if (g_capacidade_uAms <= 0) {
         return 0.0f;
     }
-    return (g_capacidade_atual_mAh / g_total_capacity_mAh) * 100.0f;
+    return (float)((g_carga_uAms * 1000) / g_capacidade_uAms) / 10.0f;
 }
 
 // Retorna ltima leitura de Vbat
@@ -199,7 +464,7 @@ float bq_soc_get_last_vbus(void) {
 
 // Retorna ltima leitura de Ibat
 float bq_soc_get_last_ibat(void) {
-    return g_last_ibat;
+    return (float)g_last_ibat_mA / 1000.0f;
 }
 
 // Retorna ltimo status de carga
@@ -210,4 +475,36 @@ BQ25622_ChargeStatus_t bq_soc_get_last_chg_status(void) {
 // Retorna ltima leitura de temperatura
 float bq_soc_get_last_tdie(void) {
     return g_last_tdie;
+}
+
+// Retorna a capacidade de plena carga aprendida
+float bq_soc_get_capacidade_mAh(void) {
+    return (float)(g_capacidade_uAms / UAMS_POR_UAH) / 1000.0f;
+}
+
+// Retorna a carga restante (uAh)
+int32_t bq_soc_get_carga_uAh(void) {
+    return (int32_t)(g_carga_uAms / UAMS_POR_UAH);
+}
+
+// Retorna o nmero de ciclos completos
+uint16_t bq_soc_get_ciclos(void) {
+    return g_ciclos;
+}
+
+// Copia as estatsticas de deriva do integrador
+void bq_soc_get_stats(BQ_SOC_Stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    *stats = g_stats;
+    stats->intervalo_ms = g_intervalo_ms;
+    stats->dt_medio_ms = (g_stats.amostras > 0) ? (uint32_t)(g_stats_tempo_ms / g_stats.amostras) : 0;
+    stats->tempo_integrado_s = (uint32_t)(g_stats_tempo_ms / 1000);
+}
+
+// Zera as estatsticas (o estado do contador no  afetado)
+void bq_soc_reset_stats(void) {
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_stats_tempo_ms = 0;
 }
\ No newline at end of file
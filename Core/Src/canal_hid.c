@@ -0,0 +1,191 @@
+/*
+ * Nome do Arquivo: canal_hid.c
+ * Descricao: Canal HID de baixa latencia. O relatorio de entrada e montado a
+ *            partir das medicoes mais recentes e enfileirado a cada periodo;
+ *            a fila da classe tem um unico relatorio, entao se o host ainda nao
+ *            leu o anterior a amostra e pulada (a latencia fica limitada a um
+ *            periodo, sem acumular atraso). Os comandos chegam no contexto
+ *            do ux_device_stack_tasks_run (laco principal).
+ * Autor: Gabriel Agune
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "canal_hid.h"
+#include "ads1232_driver.h"
+#include "medicao_handler.h"
+#include "telemetria_stream.h"
+#include "main.h"
+#include "ux_api.h"
+#include "ux_device_class_hid.h"
+#include <string.h>
+
+// ============================================================
+// Variaveis Estaticas
+// ============================================================
+
+static struct {
+    UX_SLAVE_CLASS_HID* hid;
+    uint8_t             periodo_ms;
+    uint32_t            ultimo_tick;
+    uint16_t            sequencia;
+    uint32_t            ultimo_ads_contador;
+    uint8_t             cmd_sequencia;
+    uint8_t             cmd_codigo;
+    uint8_t             cmd_resultado;
+} s_hid = { .periodo_ms = CANAL_HID_PERIODO_PADRAO_MS };
+
+// ============================================================
+// Prototipos de Funcoes Privadas
+// ============================================================
+
+static uint8_t* Put_U16(uint8_t *p, uint16_t v);
+static uint8_t* Put_U32(uint8_t *p, uint32_t v);
+static uint32_t Montar_Relatorio(uint8_t *buf, uint32_t *ads_contador);
+static uint8_t  Executar_Comando(uint8_t codigo, const uint8_t *args);
+
+// ============================================================
+// Funcoes Privadas
+// ============================================================
+
+static uint8_t* Put_U16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)(v & 0xFFU);
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t* Put_U32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v & 0xFFU);
+    p[1] = (uint8_t)((v >> 8) & 0xFFU);
+    p[2] = (uint8_t)((v >> 16) & 0xFFU);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+// Preenche o relatorio de entrada (CANAL_HID_RELATORIO_IN_SIZE bytes)
+static uint32_t Montar_Relatorio(uint8_t *buf, uint32_t *ads_contador) {
+    int32_t ads_raw = 0;
+    ADS1232_GetLastRaw(&ads_raw, ads_contador);
+
+    DadosMedicao_t dados;
+    Medicao_Get_UltimaMedicao(&dados);
+
+    uint8_t status = 0;
+    if (*ads_contador != s_hid.ultimo_ads_contador) {
+        status |= CANAL_HID_STATUS_NOVA_AMOSTRA;
+    }
+    if (Medicao_Balanca_Ativa()) {
+        status |= CANAL_HID_STATUS_BALANCA_ATIVA;
+    }
+    if (Telemetria_Stream_Ativo()) {
+        status |= CANAL_HID_STATUS_STREAM_CDC;
+    }
+
+    memset(buf, 0, CANAL_HID_RELATORIO_IN_SIZE);
+    uint8_t *p = buf;
+    *p++ = CANAL_HID_VERSAO_FORMATO;
+    *p++ = status;
+    p = Put_U16(p, s_hid.sequencia);
+    p = Put_U32(p, HAL_GetTick());
+    p = Put_U32(p, (uint32_t)(int32_t)(dados.Peso * 1000.0f));
+    p = Put_U32(p, (uint32_t)(dados.Frequencia + 0.5f));
+    p = Put_U16(p, (uint16_t)(int16_t)(dados.Temp_Instru * 100.0f));
+    p = Put_U16(p, (uint16_t)(dados.Umidade * 100.0f));
+    p = Put_U32(p, (uint32_t)ads_raw);
+    *p++ = s_hid.cmd_sequencia;
+    *p++ = s_hid.cmd_codigo;
+    *p++ = s_hid.cmd_resultado;
+
+    return CANAL_HID_RELATORIO_IN_SIZE;
+}
+
+// Executa o comando e retorna o codigo de resultado (ecoado no relatorio)
+static uint8_t Executar_Comando(uint8_t codigo, const uint8_t *args) {
+    switch (codigo) {
+        case CANAL_HID_CMD_NENHUM:
+            return CANAL_HID_RES_OK;
+
+        case CANAL_HID_CMD_TARA:
+            if (!Medicao_Balanca_Ativa()) {
+                return CANAL_HID_RES_INVALIDO;
+            }
+            Medicao_Tare_Balanca();
+            return CANAL_HID_RES_OK;
+
+        case CANAL_HID_CMD_BALANCA_LIGAR:
+            Medicao_Start_Balanca();
+            return CANAL_HID_RES_OK;
+
+        case CANAL_HID_CMD_BALANCA_DESLIGAR:
+            // A telemetria da CDC depende da balanca ligada
+            if (Telemetria_Stream_Ativo()) {
+                return CANAL_HID_RES_INVALIDO;
+            }
+            Medicao_Stop_Balanca();
+            return CANAL_HID_RES_OK;
+
+        case CANAL_HID_CMD_PERIODO:
+            s_hid.periodo_ms = args[0];
+            s_hid.ultimo_tick = HAL_GetTick();
+            return CANAL_HID_RES_OK;
+
+        default:
+            return CANAL_HID_RES_DESCONHECIDO;
+    }
+}
+
+// ============================================================
+// API Publica
+// ============================================================
+
+void Canal_HID_Set_Instancia(void *hid) {
+    s_hid.hid = (UX_SLAVE_CLASS_HID*)hid;
+    s_hid.ultimo_tick = HAL_GetTick();
+}
+
+void Canal_HID_Receber_Comando(const uint8_t *dados, uint32_t tamanho) {
+    uint8_t cmd[CANAL_HID_RELATORIO_OUT_SIZE] = { 0 };
+
+    if (dados == NULL || tamanho < 2U) {
+        return;
+    }
+    if (tamanho > sizeof(cmd)) {
+        tamanho = sizeof(cmd);
+    }
+    memcpy(cmd, dados, tamanho);
+
+    s_hid.cmd_sequencia = cmd[0];
+    s_hid.cmd_codigo    = cmd[1];
+    s_hid.cmd_resultado = Executar_Comando(cmd[1], &cmd[2]);
+}
+
+uint32_t Canal_HID_Montar_Relatorio(uint8_t *buf) {
+    uint32_t ads_contador = 0;
+    return Montar_Relatorio(buf, &ads_contador);
+}
+
+void Canal_HID_Process(void) {
+    if (s_hid.hid == NULL || s_hid.periodo_ms == 0U) {
+        return;
+    }
+
+    uint32_t agora = HAL_GetTick();
+    if ((agora - s_hid.ultimo_tick) < s_hid.periodo_ms) {
+        return;
+    }
+    s_hid.ultimo_tick = agora;
+
+    UX_SLAVE_CLASS_HID_EVENT evento;
+    uint32_t ads_contador = 0;
+    evento.ux_device_class_hid_event_report_id   = 0;
+    evento.ux_device_class_hid_event_report_type = UX_DEVICE_CLASS_HID_REPORT_TYPE_INPUT;
+    evento.ux_device_class_hid_event_length      = Montar_Relatorio(evento.ux_device_class_hid_event_buffer, &ads_contador);
+
+    // Fila cheia: o host ainda nao leu o relatorio anterior, tenta no proximo tick
+    if (ux_device_class_hid_event_set(s_hid.hid, &evento) == UX_SUCCESS) {
+        s_hid.sequencia++;
+        s_hid.ultimo_ads_contador = ads_contador;
+    }
+}
@@ -11,6 +11,13 @@
 #include "medicao_handler.h"
 #include "temp_sensor.h"
 #include "relato.h"
+#include "telemetria_stream.h"
+#include "dfu_runtime.h"
+#include "usbx_memoria.h"
+#include "usb_bench.h"
+#include "bq_soc.h"
+#include "servo_controle.h"
+#include "gerenciador_configuracoes.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -53,6 +60,15 @@ static void Cmd_GetPeso(char* args);
 static void Cmd_GetTemp(char* args);
 static void Cmd_GetFreq(char* args);
 static void Cmd_Service(char* args);
+static void Cmd_Stream(char* args);
+static void Cmd_Dfu(char* args);
+static void Cmd_UsbMem(char* args);
+#if USB_BENCH_ENABLE
+static void Cmd_UsbBench(char* args);
+#endif
+static void Cmd_Bateria(char* args);
+static void Cmd_Sequencia(char* args);
+static void Cmd_Trim(char* args);
 
 // Handlers de Subcomandos DWIN
 static void Handle_Dwin_PIC(char* sub_args);
@@ -76,6 +92,15 @@ static const cli_command_t s_command_table[] = {
     { "FREQ",     Cmd_GetFreq },
     { "SERVICE",  Cmd_Service },
     { "WHO_AM_I", Cmd_WhoAmI  },
+    { "STREAM",   Cmd_Stream  },
+    { "DFU",      Cmd_Dfu     },
+    { "USBMEM",   Cmd_UsbMem  },
+#if USB_BENCH_ENABLE
+    { "USBBENCH", Cmd_UsbBench },
+#endif
+    { "BAT",      Cmd_Bateria  },
+    { "SEQ",      Cmd_Sequencia },
+    { "TRIM",     Cmd_Trim      },
 };
 
 static const size_t NUM_COMMANDS = sizeof(s_command_table) / sizeof(s_command_table[0]);
@@ -107,6 +132,18 @@ static const char HELP_TEXT[] =
     "| PESO                     | Mostra a leitura atual da balanca.            |\r\n"
     "| TEMP                     | Mostra a leitura do sensor de temperatura.    |\r\n"
     "| FREQ                     | Mostra a ultima leitura de frequencia.        |\r\n"
+    "| STREAM ON [hz] / OFF     | Telemetria binaria (padrao 100 Hz, max 1000). |\r\n"
+    "| DFU [BOOT]               | CRC da imagem / entra no bootloader USB DFU.  |\r\n"
+    "| USBMEM                   | Estatisticas de alocacao de memoria do USBX.  |\r\n"
+#if USB_BENCH_ENABLE
+    "| USBBENCH [RESET|TX <n>]  | Custo do tasks_run, latencia e vazao da CDC.  |\r\n"
+#endif
+    "| BAT [RESET]              | SoC, capacidade aprendida e deriva do SoC.    |\r\n"
+    "| SEQ <r>                  | Passos da receita de servos r (0-3).          |\r\n"
+    "| SEQ <r> <p> s a pf c ms  | Grava passo p: servo, ang, perfil, cond, ms.  |\r\n"
+    "| SEQ <r> FIM <n>          | Limita a receita r aos n primeiros passos.    |\r\n"
+    "| SEQ GRAO <g> <r>         | Associa a receita r ao grao g.                |\r\n"
+    "| TRIM [<s> <min> <max>]   | Trim do pulso do servo s em 0/180 graus (us). |\r\n"
     "============================================================================\r\n";
 
 // ============================================================
@@ -224,14 +261,15 @@ static void Cmd_SetDate(char* args) {
 
 static void Cmd_Date(char* args) {
     (void)args;
-    uint8_t h, m, s, d, mo, y;
-    char weekday_str[4] = {0};
-
-    const bool time_ok = RTC_Driver_GetTime(&h, &m, &s);
-    const bool date_ok = RTC_Driver_GetDate(&d, &mo, &y, weekday_str);
-
-    if (time_ok && date_ok) {
-        CLI_Printf("Data/Hora: %s %02u/%02u/20%02u %02u:%02u:%02u", weekday_str, d, mo, y, h, m, s);
+    RTC_Calendario_t cal;
+
+    if (RTC_Driver_Get_Calendario(&cal)) {
+        // Data e milissegundos tirados do mesmo carimbo
+        const uint64_t epoch_ms = RTC_Driver_Get_Epoch_ms();
+        RTC_Driver_Epoch_Para_Calendario((uint32_t)(epoch_ms / 1000U), &cal);
+        CLI_Printf("Data/Hora: %s %02u/%02u/20%02u %02u:%02u:%02u.%03u\r\n", RTC_Driver_Nome_Dia_Semana(cal.dia_semana),
+                   cal.dia, cal.mes, cal.ano, cal.hora, cal.minuto, cal.segundo, (unsigned)(epoch_ms % 1000U));
+        CLI_Printf("Tick do HAL: %ld ppm em relacao ao RTC", (long)RTC_Driver_Get_Desvio_Tick_ppm());
     } else {
         CLI_Puts("Erro ao ler data/hora do RTC.");
     }
@@ -259,6 +297,186 @@ static void Cmd_GetFreq(char* args) {
     CLI_Printf("  Escala A: %.2f\r\n", dados.Escala_A);
 }
 
+static void Cmd_Stream(char* args) {
+    if (args && strncasecmp(args, "ON", 2) == 0) {
+        const uint16_t taxa = Telemetria_Stream_Iniciar((uint16_t)atoi(args + 2));
+        CLI_Printf("Stream ativo a %u Hz (registros binarios, CRC-16/MODBUS).", taxa);
+        return;
+    }
+    if (args && strcasecmp(args, "OFF") == 0) {
+        Telemetria_Stream_Parar();
+        CLI_Printf("Stream encerrado. Registros descartados: %lu", (unsigned long)Telemetria_Stream_Descartados());
+        return;
+    }
+    CLI_Printf("Uso: STREAM ON [hz] | STREAM OFF (estado: %s)", Telemetria_Stream_Ativo() ? "ativo" : "parado");
+}
+
+static void Cmd_Dfu(char* args) {
+    if (args && strcasecmp(args, "BOOT") == 0) {
+        CLI_Puts("Entrando no bootloader USB DFU (dfu-util -a 0 -s 0x08000000:leave -D firmware.bin)...");
+        DFU_Runtime_Solicitar_Bootloader();
+        return;
+    }
+
+    static const char* const k_status[] = { "OK", "sem trailer (gravada pelo depurador)", "CORROMPIDA" };
+    uint32_t crc = 0, tamanho = 0;
+    DFU_Imagem_Status_t st = DFU_Runtime_Verificar_Imagem(&crc, &tamanho);
+    CLI_Printf("Imagem: %lu bytes, CRC-32 0x%08lX, %s. Use DFU BOOT para atualizar.",
+               (unsigned long)tamanho, (unsigned long)crc, k_status[st]);
+}
+
+static void Cmd_UsbMem(char* args) {
+    (void)args;
+    USBX_Memoria_Stats_t st;
+    USBX_Memoria_Get_Stats(&st);
+
+    CLI_Printf("Memoria USBX (%s):\r\n", st.arena ? "arena estatica" : "byte pool");
+    CLI_Printf("  Em uso: %lu de %lu bytes (pico %lu)\r\n",
+               (unsigned long)st.em_uso, (unsigned long)st.capacidade, (unsigned long)st.pico);
+    CLI_Printf("  Alocacoes: %lu  Liberacoes: %lu  Retidas: %lu\r\n",
+               (unsigned long)st.alocacoes, (unsigned long)st.liberacoes, (unsigned long)st.retidos);
+    CLI_Printf("  Falhas: %lu  Maior pedido: %lu bytes",
+               (unsigned long)st.falhas, (unsigned long)st.maior_pedido);
+}
+
+#if USB_BENCH_ENABLE
+static void Cmd_UsbBench(char* args) {
+    if (args && strcasecmp(args, "RESET") == 0) {
+        USB_Bench_Reset();
+        CLI_Puts("Medicoes USB zeradas.");
+        return;
+    }
+    if (args && strncasecmp(args, "TX", 2) == 0) {
+        // O padrao segue logo apos o prompt; o resumo fecha o envio
+        if (!USB_Bench_Iniciar_TX((uint32_t)strtoul(args + 2, NULL, 10))) {
+            CLI_Printf("Uso: USBBENCH TX <1..%lu bytes> (um envio por vez)", (unsigned long)USB_BENCH_TX_MAX_BYTES);
+        }
+        return;
+    }
+
+    USB_Bench_Stats_t st;
+    USB_Bench_Get_Stats(&st);
+    const uint32_t ciclos_us = SystemCoreClock / 1000000UL;
+
+    CLI_Printf("tasks_run: %lu chamadas, medio %lu ciclos (%lu us), max %lu ciclos (%lu us)\r\n",
+               (unsigned long)st.tasks_chamadas,
+               (unsigned long)st.tasks_ciclos_medio, (unsigned long)(st.tasks_ciclos_medio / ciclos_us),
+               (unsigned long)st.tasks_ciclos_max, (unsigned long)(st.tasks_ciclos_max / ciclos_us));
+    CLI_Printf("RX->TX: %lu amostras, min/medio/max %lu/%lu/%lu us",
+               (unsigned long)st.latencia_amostras,
+               (unsigned long)(st.latencia_ciclos_min / ciclos_us),
+               (unsigned long)(st.latencia_ciclos_medio / ciclos_us),
+               (unsigned long)(st.latencia_ciclos_max / ciclos_us));
+}
+#endif // USB_BENCH_ENABLE
+
+static void Cmd_Bateria(char* args) {
+    if (args && strcasecmp(args, "RESET") == 0) {
+        bq_soc_reset_stats();
+        CLI_Puts("Estatisticas do contador zeradas.");
+        return;
+    }
+
+    BQ_SOC_Stats_t st;
+    bq_soc_get_stats(&st);
+    int32_t carga_uAh = bq_soc_get_carga_uAh();
+    int32_t soc_decimos = (int32_t)(bq_soc_get_percentage() * 10.0f);
+
+    CLI_Printf("SoC: %ld.%ld%%  Carga: %ld mAh  Capacidade: %ld mAh  Ciclos: %u\r\n",
+               (long)(soc_decimos / 10), (long)(soc_decimos % 10),
+               (long)(carga_uAh / 1000), (long)bq_soc_get_capacidade_mAh(), (unsigned)bq_soc_get_ciclos());
+    CLI_Printf("Amostras: %lu (intervalo %lu ms), dt min/medio/max %lu/%lu/%lu ms, atraso max %lu ms, %lu s integrados\r\n",
+               (unsigned long)st.amostras, (unsigned long)st.intervalo_ms,
+               (unsigned long)st.dt_min_ms, (unsigned long)st.dt_medio_ms, (unsigned long)st.dt_max_ms,
+               (unsigned long)st.atraso_max_ms, (unsigned long)st.tempo_integrado_s);
+    CLI_Printf("Correcoes: %lu, ultima %ld uAh, total %lu uAh",
+               (unsigned long)st.correcoes, (long)st.correcao_ultima_uAh, (unsigned long)st.correcao_total_uAh);
+}
+
+static void Cmd_Sequencia(char* args) {
+    unsigned g, r;
+    if (args && strncasecmp(args, "GRAO", 4) == 0) {
+        if (sscanf(args + 4, "%u %u", &g, &r) == 2 && g < MAX_GRAOS &&
+            Gerenciador_Config_Set_Sequencia_Grao((uint8_t)g, (uint8_t)r)) {
+            CLI_Printf("Grao %u usa a receita %u.", g, r);
+        } else {
+            CLI_Printf("Uso: SEQ GRAO <0..%u> <0..%u>", MAX_GRAOS - 1, SEQ_NUM_RECEITAS - 1);
+        }
+        return;
+    }
+
+    char* resto = NULL;
+    const unsigned long id = args ? strtoul(args, &resto, 10) : SEQ_NUM_RECEITAS;
+    if (resto == args || id >= SEQ_NUM_RECEITAS) {
+        CLI_Printf("Uso: SEQ <0..%u> [<passo> <servo> <angulo> <perfil> <cond> <ms> | FIM <n>]", SEQ_NUM_RECEITAS - 1);
+        return;
+    }
+    while (isspace((unsigned char)*resto)) {
+        resto++;
+    }
+
+    Config_Receita_Servo_t receita;
+    bool gravada = Gerenciador_Config_Get_Receita_Servo((uint8_t)id, &receita);
+    if (!gravada) {
+        Servos_Get_Receita((uint8_t)id, &receita);
+    }
+
+    unsigned p, srv, ang, pf, cond, ms;
+    if (strncasecmp(resto, "FIM", 3) == 0) {
+        if (sscanf(resto + 3, "%u", &p) != 1 || p == 0 || p > receita.num_passos) {
+            CLI_Printf("Uso: SEQ %lu FIM <1..%u>", id, receita.num_passos);
+            return;
+        }
+        receita.num_passos = (uint8_t)p;
+        gravada = Gerenciador_Config_Set_Receita_Servo((uint8_t)id, &receita);
+    } else if (*resto != '\0') {
+        if (sscanf(resto, "%u %u %u %u %u %u", &p, &srv, &ang, &pf, &cond, &ms) != 6 ||
+            p > receita.num_passos || p >= SEQ_MAX_PASSOS || srv > 0xFFu || ang > 180u ||
+            pf >= NUM_SERVO_PERFIS || cond >= NUM_SERVO_CONDICOES || ms > 0xFFFFu) {
+            CLI_Printf("Passo invalido (passo ate %u, servo 0-%u ou %u p/ espera, angulo 0-180, perfil 0-%u, cond 0-%u, ms ate 65535).",
+                       receita.num_passos, NUM_SERVOS - 1, 0xFFu, NUM_SERVO_PERFIS - 1, NUM_SERVO_CONDICOES - 1);
+            return;
+        }
+        Config_Passo_Servo_t* passo = &receita.passos[p];
+        passo->servo     = (uint8_t)srv;
+        passo->angulo    = (uint8_t)ang;
+        passo->perfil    = (uint8_t)pf;
+        passo->condicao  = (uint8_t)cond;
+        passo->espera_ms = (uint16_t)ms;
+        passo->reservado = 0;
+        if (p == receita.num_passos) {
+            receita.num_passos++;
+        }
+        gravada = Gerenciador_Config_Set_Receita_Servo((uint8_t)id, &receita);
+    }
+
+    CLI_Printf("Receita %lu (%s), %u passos:\r\n", id, gravada ? "EEPROM" : "padrao", receita.num_passos);
+    for (unsigned i = 0; i < receita.num_passos; i++) {
+        const Config_Passo_Servo_t* passo = &receita.passos[i];
+        CLI_Printf("  %u: servo %u  angulo %u  perfil %u  cond %u  espera %u ms\r\n",
+                   i, passo->servo, passo->angulo, passo->perfil, passo->condicao, passo->espera_ms);
+    }
+}
+
+static void Cmd_Trim(char* args) {
+    unsigned servo;
+    int trim_min, trim_max;
+    if (args) {
+        if (sscanf(args, "%u %d %d", &servo, &trim_min, &trim_max) != 3 || servo >= NUM_SERVOS ||
+            trim_min < -500 || trim_min > 500 || trim_max < -500 || trim_max > 500 ||
+            !Servos_Set_Trim((ServoId_t)servo, (int16_t)trim_min, (int16_t)trim_max)) {
+            CLI_Printf("Uso: TRIM <0..%u> <min_us> <max_us> (-500..500)", NUM_SERVOS - 1);
+            return;
+        }
+    }
+
+    for (unsigned i = 0; i < NUM_SERVOS; i++) {
+        int16_t t_min, t_max;
+        Servos_Get_Trim((ServoId_t)i, &t_min, &t_max);
+        CLI_Printf("Servo %u: trim %d us em 0 graus, %d us em 180 graus\r\n", i, t_min, t_max);
+    }
+}
+
 // ============================================================
 // Funes Privadas (Handlers DWIN)
 // ============================================================
@@ -5,7 +5,9 @@
  */
 
 #include "cli_driver.h"
+#include "ring_buffer.h"
 #include "ux_device_cdc_acm.h"
+#include "usb_bench.h"
 #include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
@@ -15,9 +17,11 @@
 // Defines e Constantes
 // ============================================================
 
-#define CLI_TX_FIFO_SIZE        1536
+#define CLI_TX_FIFO_SIZE        1024    // Potncia de 2 (ndices mascarados)
 #define CLI_BUFFER_SIZE        	 256
 #define CLI_USB_MAX_PKT         	64      
+#define CLI_PUMP_MAX_TRANSFERS     4    // Transferncias encadeadas por chamada do pump
+#define CLI_PRINTF_MAX           256    // Maior sada de um nico CLI_Printf
 
 // ============================================================
 // Variveis Externas
@@ -29,10 +33,22 @@ extern UX_SLAVE_CLASS_CDC_ACM *cdc_acm;
 // Variveis Privadas
 // ============================================================
 
-// FIFO de Transmisso
-static uint8_t              s_cli_tx_fifo[CLI_TX_FIFO_SIZE];
-static uint16_t             s_cli_tx_head       = 0;
-static uint16_t             s_cli_tx_tail       = 0;
+// FIFO de Transmisso (+ rea extra onde o CLI_Printf transborda ao cruzar o fim do anel).
+// Com o zero-copy da CDC o endpoint l direto daqui: o trecho em envio s  liberado
+// no UX_STATE_NEXT, e os produtores s escrevem no espao livre.
+static uint8_t              s_cli_tx_fifo[CLI_TX_FIFO_SIZE + CLI_PRINTF_MAX];
+static RingBuffer_t         s_cli_tx;
+
+// Estado do pump USB (no bloqueante)
+static struct {
+    bool     enviando;      // Transferncia em andamento no write_run
+    bool     zlp_pendente;  // ltima transferncia terminou em pacote cheio
+    uint8_t* ptr;
+    uint32_t len;
+} s_pump;
+
+// Buffer do endpoint Bulk OUT (zero-copy: o DCD grava aqui e a linha  montada daqui)
+static uint32_t             s_cli_rx_pacote[CLI_USB_MAX_PKT / sizeof(uint32_t)];
 
 // Buffer de Recepo de Linha
 static char                 s_cli_buffer[CLI_BUFFER_SIZE];
@@ -49,8 +65,8 @@ static cli_line_callback_t  s_line_callback     = NULL;
 // Inicializa as estruturas internas e registra o callback
 void CLI_Init(cli_line_callback_t line_cb) {
     s_line_callback     = line_cb;
-    s_cli_tx_head       = 0;
-    s_cli_tx_tail       = 0;
+    RingBuffer_Init(&s_cli_tx, s_cli_tx_fifo, CLI_TX_FIFO_SIZE);
+    memset(&s_pump, 0, sizeof(s_pump));
     s_cli_buffer_index  = 0;
     s_command_ready     = false;
     
@@ -62,69 +78,146 @@ bool CLI_Is_USB_Connected(void) {
     return (cdc_acm != NULL);
 }
 
-// Adiciona string ao FIFO de transmisso
-void CLI_Puts(const char* str) {
-    if (!str || !CLI_Is_USB_Connected()) {
-        return;
+// Copia um bloco para o FIFO (seguro tambm a partir de ISRs); retorna os bytes aceitos
+size_t CLI_Write(const void* data, size_t len) {
+    if (!data || len == 0u || !CLI_Is_USB_Connected()) {
+        return 0;
     }
+    // FIFO cheio: descarta o restante
+    return RingBuffer_Escrever(&s_cli_tx, data, (uint32_t)len);
+}
 
-    const uint32_t len = (uint32_t)strlen(str);
-    if (len == 0u) {
-        return;
+// Enfileira um quadro inteiro ou nada (registros binrios no podem ser cortados)
+bool CLI_Write_Frame(const void* data, size_t len) {
+    if (!data || len == 0u || !CLI_Is_USB_Connected()) {
+        return false;
     }
+    return RingBuffer_Escrever_Inteiro(&s_cli_tx, data, (uint32_t)len);
+}
 
-    for (uint32_t i = 0; i < len; i++) {
-        const uint16_t next_head = (uint16_t)((s_cli_tx_head + 1u) % CLI_TX_FIFO_SIZE);
-
-        if (next_head == s_cli_tx_tail) {
-            // FIFO cheio: descarta o restante
-            break;
-        }
-        s_cli_tx_fifo[s_cli_tx_head] = (uint8_t)str[i];
-        s_cli_tx_head = next_head;
+// Adiciona string ao FIFO de transmisso
+void CLI_Puts(const char* str) {
+    if (!str) {
+        return;
     }
+    (void)CLI_Write(str, strlen(str));
 }
 
-// Formata string e envia para o FIFO
+// Formata diretamente no espao livre do FIFO (sem buffer intermedirio)
 void CLI_Printf(const char* format, ...) {
-    if (!format) {
+    if (!format || !CLI_Is_USB_Connected()) {
+        return;
+    }
+
+    RingBuffer_Reserva_t reserva;
+    if (RingBuffer_Reservar(&s_cli_tx, CLI_PRINTF_MAX, &reserva) == 0u) {
         return;
     }
 
-    static char printf_buffer[256];
+    // O vsnprintf escreve em sequncia a partir do incio da reserva; o que passar do
+    // fim do anel cai na rea extra e  movido para o incio. O '\0' fica dentro da
+    // reserva e nunca  publicado.
+    char* destino = (char*)RingBuffer_Ponteiro(&s_cli_tx, reserva.inicio);
 
     va_list args;
     va_start(args, format);
-    const int len = vsnprintf(printf_buffer, sizeof(printf_buffer), format, args);
+    int len = vsnprintf(destino, reserva.tamanho, format, args);
     va_end(args);
 
+    uint32_t usados = 0;
     if (len > 0) {
-        CLI_Puts(printf_buffer);
+        usados = ((uint32_t)len < reserva.tamanho) ? (uint32_t)len : (reserva.tamanho - 1u);
+
+        const uint32_t fim = (uint32_t)(destino - (char*)s_cli_tx_fifo) + usados;
+        if (fim > CLI_TX_FIFO_SIZE) {
+            memcpy(&s_cli_tx_fifo[0], &s_cli_tx_fifo[CLI_TX_FIFO_SIZE], fim - CLI_TX_FIFO_SIZE);
+        }
     }
+    RingBuffer_Confirmar(&s_cli_tx, &reserva, usados);
 }
 
-// Move dados do FIFO para o endpoint USB CDC
+// Prepara a prxima transferncia: o trecho contguo pronto do anel, sem cpia.
+// A volta do anel segue na transferncia seguinte.
+static bool CLI_Pump_Preparar(void) {
+    uint8_t* p;
+    uint32_t n = RingBuffer_Ler_Contiguo(&s_cli_tx, &p);
+
+    if (n == 0u) {
+        if (!s_pump.zlp_pendente) {
+            return false;
+        }
+        // Pacote de tamanho zero encerra a transferncia anterior no host
+        s_pump.ptr = s_cli_tx_fifo;
+        s_pump.len = 0;
+        return true;
+    }
+
+    s_pump.ptr = p;
+    s_pump.len = n;
+    return true;
+}
+
+// Move dados do FIFO para o endpoint USB CDC sem bloquear. Em zero-copy o write_run
+// entrega o trecho do anel ao DCD, que o divide em pacotes de 64 bytes direto para a
+// PMA; a concluso  detectada aqui (UX_STATE_NEXT) e a prxima transferncia 
+// encadeada na mesma chamada.
 void CLI_TX_Pump(void) {
-    if (!CLI_Is_USB_Connected() || (s_cli_tx_head == s_cli_tx_tail)) {
+    if (!CLI_Is_USB_Connected()) {
+        s_pump.enviando = false;
+        s_pump.zlp_pendente = false;
         return;
     }
 
-    uint16_t bytes_to_send;
-    if (s_cli_tx_head > s_cli_tx_tail) {
-        bytes_to_send = (uint16_t)(s_cli_tx_head - s_cli_tx_tail);
-    } else {
-        bytes_to_send = (uint16_t)(CLI_TX_FIFO_SIZE - s_cli_tx_tail);
+    for (uint8_t i = 0; i < CLI_PUMP_MAX_TRANSFERS; i++) {
+        if (!s_pump.enviando) {
+            if (!CLI_Pump_Preparar()) {
+                return;
+            }
+            s_pump.enviando = true;
+        }
+
+        ULONG enviados = 0;
+        UINT status = ux_device_class_cdc_acm_write_run(cdc_acm, s_pump.ptr, s_pump.len, &enviados);
+
+        if (status == UX_STATE_NEXT) {
+#if USB_BENCH_ENABLE
+            USB_Bench_Marcar_TX();
+#endif
+            RingBuffer_Descartar(&s_cli_tx, s_pump.len);
+            s_pump.zlp_pendente = (s_pump.len > 0u) && ((s_pump.len % CLI_USB_MAX_PKT) == 0u);
+            s_pump.enviando = false;
+            continue;
+        }
+
+        if (status < UX_STATE_NEXT) {
+            // Erro/desconfigurao: os dados continuam no FIFO para nova tentativa
+            s_pump.enviando = false;
+        }
+        // UX_STATE_WAIT: transferncia em andamento, continua na prxima chamada
+        return;
     }
+}
 
-    if (bytes_to_send > CLI_USB_MAX_PKT) {
-        bytes_to_send = CLI_USB_MAX_PKT;
+// Recebe do endpoint Bulk OUT e processa os bytes no prprio buffer do endpoint.
+// O read_run s devolve o pacote no UX_STATE_NEXT; a prxima chamada rearma a recepo.
+void CLI_RX_Pump(void) {
+    if (!CLI_Is_USB_Connected()) {
+        return;
     }
 
-    uint32_t sent_bytes = 0;
-    if (USBD_CDC_ACM_Transmit(&s_cli_tx_fifo[s_cli_tx_tail], bytes_to_send, &sent_bytes) == UX_SUCCESS) {
-        if (sent_bytes > 0u) {
-            s_cli_tx_tail = (uint16_t)((s_cli_tx_tail + sent_bytes) % CLI_TX_FIFO_SIZE);
-        }
+    uint8_t* pacote = (uint8_t*)s_cli_rx_pacote;
+    ULONG recebidos = 0;
+    if (ux_device_class_cdc_acm_read_run(cdc_acm, pacote, CLI_USB_MAX_PKT, &recebidos) != UX_STATE_NEXT) {
+        return;
+    }
+
+#if USB_BENCH_ENABLE
+    if (recebidos > 0u) {
+        USB_Bench_Marcar_RX();
+    }
+#endif
+    for (ULONG i = 0; i < recebidos; i++) {
+        CLI_Receive_Char(pacote[i]);
     }
 }
 
@@ -165,7 +258,6 @@ void CLI_Receive_Char(uint8_t received_char) {
         s_cli_buffer[s_cli_buffer_index++] = (char)received_char;
 
         // Eco local
-        char echo[2] = { (char)received_char, '\0' };
-        CLI_Puts(echo);
+        (void)CLI_Write(&received_char, 1);
     }
 }
@@ -0,0 +1,261 @@
+/*
+ * Nome do Arquivo: crc_service.c
+ * Descricao: Servico de CRC por hardware sobre o periferico CRC (crc.c).
+ *            Calculo incremental com tamanho em bytes, CRC-32 / CRC-16/MODBUS
+ *            e alimentacao por DMA (memoria -> CRC->DR) para buffers grandes.
+ * Autor: Gabriel Agune
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "crc_service.h"
+#include <stddef.h>
+
+// ============================================================
+// Definicoes e Constantes Privadas
+// ============================================================
+
+#define CRC16_MODBUS_POLY      0x8005U
+#define CRC16_MODBUS_INIT      0xFFFFU
+#define CRC32_INIT             0xFFFFFFFFUL
+#define CRC_DMA_BLOCO_MAX      0xFFFFU   // Limite do CNDTR
+
+// ============================================================
+// Variaveis Estaticas
+// ============================================================
+
+static struct {
+    CRC_HandleTypeDef* hcrc;
+    DMA_HandleTypeDef   hdma;
+    bool                dma_ok;
+    bool                tipo_valido;
+    CRC_Service_Tipo_t  tipo_hw;
+    CRC_Service_Ctx_t* ctx_dma;      // Contexto que esta sendo alimentado por DMA
+    const uint8_t* dma_ptr;
+    uint32_t            dma_restante;
+} s_crc;
+
+// ============================================================
+// Prototipos de Funcoes Privadas
+// ============================================================
+
+static void CRC_Configurar_Tipo(CRC_Service_Tipo_t tipo);
+static void CRC_Carregar_Contexto(CRC_Service_Ctx_t *ctx);
+static void CRC_Alimentar_CPU(const uint8_t *p, uint32_t tamanho);
+static bool CRC_Iniciar_Bloco_DMA(void);
+static void CRC_Aguardar_DMA(void);
+static uint16_t CRC_Refletir16(uint16_t valor);
+
+// ============================================================
+// Funcoes Privadas
+// ============================================================
+
+// Reprograma o periferico somente quando o tipo muda
+static void CRC_Configurar_Tipo(CRC_Service_Tipo_t tipo) {
+    if (s_crc.tipo_valido && s_crc.tipo_hw == tipo) {
+        return;
+    }
+
+    CRC_HandleTypeDef* h = s_crc.hcrc;
+    if (tipo == CRC_SERVICE_CRC16_MODBUS) {
+        h->Init.DefaultPolynomialUse    = DEFAULT_POLYNOMIAL_DISABLE;
+        h->Init.GeneratingPolynomial    = CRC16_MODBUS_POLY;
+        h->Init.CRCLength               = CRC_POLYLENGTH_16B;
+        h->Init.DefaultInitValueUse     = DEFAULT_INIT_VALUE_DISABLE;
+        h->Init.InitValue               = CRC16_MODBUS_INIT;
+        h->Init.InputDataInversionMode  = CRC_INPUTDATA_INVERSION_BYTE;
+    } else {
+        h->Init.DefaultPolynomialUse    = DEFAULT_POLYNOMIAL_ENABLE;
+        h->Init.DefaultInitValueUse     = DEFAULT_INIT_VALUE_ENABLE;
+        h->Init.InputDataInversionMode  = CRC_INPUTDATA_INVERSION_NONE;
+    }
+    // A reflexao de saida e feita em software no Finalizar, para que o DR
+    // sempre contenha o registrador "cru" (permite salvar/restaurar contextos)
+    h->Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
+    h->InputDataFormat              = CRC_INPUTDATA_FORMAT_BYTES;
+
+    HAL_CRC_Init(h);
+    s_crc.tipo_hw = tipo;
+    s_crc.tipo_valido = true;
+}
+
+// Restaura o estado do contexto no periferico (INIT + reset do DR)
+static void CRC_Carregar_Contexto(CRC_Service_Ctx_t *ctx) {
+    CRC_Aguardar_DMA();
+    CRC_Configurar_Tipo(ctx->tipo);
+    WRITE_REG(s_crc.hcrc->Instance->INIT, ctx->estado);
+    __HAL_CRC_DR_RESET(s_crc.hcrc);
+}
+
+// Alimenta o DR pela CPU: palavras de 32 bits (ordem big-endian) e bytes nas pontas
+static void CRC_Alimentar_CPU(const uint8_t *p, uint32_t tamanho) {
+    __IO uint32_t* dr = &s_crc.hcrc->Instance->DR;
+
+    while (tamanho > 0U && (((uintptr_t)p & 3U) != 0U)) {
+        *(__IO uint8_t*)dr = *p++;
+        tamanho--;
+    }
+    while (tamanho >= 4U) {
+        *dr = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+        p += 4;
+        tamanho -= 4U;
+    }
+    while (tamanho > 0U) {
+        *(__IO uint8_t*)dr = *p++;
+        tamanho--;
+    }
+}
+
+// Dispara o proximo bloco de DMA (acessos de 8 bits ao DR preservam a ordem dos bytes)
+static bool CRC_Iniciar_Bloco_DMA(void) {
+    uint32_t n = s_crc.dma_restante;
+    if (n > CRC_DMA_BLOCO_MAX) {
+        n = CRC_DMA_BLOCO_MAX;
+    }
+
+    if (HAL_DMA_Start(&s_crc.hdma, (uint32_t)s_crc.dma_ptr, (uint32_t)&s_crc.hcrc->Instance->DR, n) != HAL_OK) {
+        return false;
+    }
+    s_crc.dma_ptr += n;
+    s_crc.dma_restante -= n;
+    return true;
+}
+
+// Aguarda (com limite) a alimentacao por DMA pendente e salva o estado do contexto
+static void CRC_Aguardar_DMA(void) {
+    uint32_t inicio = HAL_GetTick();
+    while (!CRC_Service_DMA_Concluido()) {
+        if (HAL_GetTick() - inicio > CRC_SERVICE_DMA_TIMEOUT) {
+            // Nao deveria ocorrer (mem2mem); o CRC resultante ficara invalido e sera rejeitado
+            HAL_DMA_Abort(&s_crc.hdma);
+            s_crc.ctx_dma = NULL;
+            break;
+        }
+    }
+}
+
+// Inverte a ordem dos 16 bits (reflexao de saida do CRC-16/MODBUS)
+static uint16_t CRC_Refletir16(uint16_t valor) {
+    uint16_t r = 0;
+    for (uint8_t i = 0; i < 16; i++) {
+        r = (uint16_t)((r << 1) | (valor & 1U));
+        valor >>= 1;
+    }
+    return r;
+}
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Inicializa o servico e o canal DMA mem2mem
+void CRC_Service_Init(CRC_HandleTypeDef *hcrc) {
+    s_crc.hcrc = hcrc;
+    s_crc.tipo_valido = false;
+    s_crc.ctx_dma = NULL;
+
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    s_crc.hdma.Instance                 = CRC_SERVICE_DMA_CANAL;
+    s_crc.hdma.Init.Request             = DMA_REQUEST_MEM2MEM;
+    s_crc.hdma.Init.Direction           = DMA_MEMORY_TO_MEMORY;
+    s_crc.hdma.Init.PeriphInc           = DMA_PINC_ENABLE;    // Origem: buffer
+    s_crc.hdma.Init.MemInc              = DMA_MINC_DISABLE;   // Destino: CRC->DR
+    s_crc.hdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    s_crc.hdma.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+    s_crc.hdma.Init.Mode                = DMA_NORMAL;
+    s_crc.hdma.Init.Priority            = DMA_PRIORITY_LOW;
+    s_crc.dma_ok = (HAL_DMA_Init(&s_crc.hdma) == HAL_OK);
+}
+
+// Inicia um calculo incremental
+void CRC_Service_Iniciar(CRC_Service_Ctx_t *ctx, CRC_Service_Tipo_t tipo) {
+    ctx->tipo = tipo;
+    ctx->estado = (tipo == CRC_SERVICE_CRC16_MODBUS) ? CRC16_MODBUS_INIT : CRC32_INIT;
+}
+
+// Acumula 'tamanho' bytes pela CPU
+void CRC_Service_Atualizar(CRC_Service_Ctx_t *ctx, const void *dados, uint32_t tamanho) {
+    if (s_crc.hcrc == NULL || ctx == NULL || dados == NULL || tamanho == 0U) {
+        return;
+    }
+    CRC_Carregar_Contexto(ctx);
+    CRC_Alimentar_CPU((const uint8_t*)dados, tamanho);
+    ctx->estado = s_crc.hcrc->Instance->DR;
+}
+
+// Acumula via DMA (nao-bloqueante); sem DMA disponivel, calcula pela CPU e retorna false
+bool CRC_Service_Atualizar_DMA(CRC_Service_Ctx_t *ctx, const void *dados, uint32_t tamanho) {
+    if (s_crc.hcrc == NULL || ctx == NULL || dados == NULL || tamanho == 0U) {
+        return false;
+    }
+
+    CRC_Carregar_Contexto(ctx);
+    s_crc.dma_ptr = (const uint8_t*)dados;
+    s_crc.dma_restante = tamanho;
+
+    if (!s_crc.dma_ok || !CRC_Iniciar_Bloco_DMA()) {
+        CRC_Alimentar_CPU((const uint8_t*)dados, tamanho);
+        ctx->estado = s_crc.hcrc->Instance->DR;
+        return false;
+    }
+    s_crc.ctx_dma = ctx;
+    return true;
+}
+
+// Verifica/avanca a alimentacao por DMA; retorna true quando nao ha DMA pendente
+bool CRC_Service_DMA_Concluido(void) {
+    if (s_crc.ctx_dma == NULL) {
+        return true;
+    }
+
+    uint32_t flags = __HAL_DMA_GET_TC_FLAG_INDEX(&s_crc.hdma) | __HAL_DMA_GET_TE_FLAG_INDEX(&s_crc.hdma);
+    if (__HAL_DMA_GET_FLAG(&s_crc.hdma, flags) == 0U) {
+        return false;
+    }
+
+    // Flag ja ativa: o poll apenas limpa as flags e libera o handle
+    HAL_DMA_PollForTransfer(&s_crc.hdma, HAL_DMA_FULL_TRANSFER, 0);
+
+    if (s_crc.dma_restante > 0U && CRC_Iniciar_Bloco_DMA()) {
+        return false;
+    }
+
+    s_crc.ctx_dma->estado = s_crc.hcrc->Instance->DR;
+    s_crc.ctx_dma = NULL;
+    return true;
+}
+
+// Retorna o CRC final do contexto
+uint32_t CRC_Service_Finalizar(CRC_Service_Ctx_t *ctx) {
+    if (ctx == s_crc.ctx_dma) {
+        CRC_Aguardar_DMA();
+    }
+    if (ctx->tipo == CRC_SERVICE_CRC16_MODBUS) {
+        return CRC_Refletir16((uint16_t)ctx->estado);
+    }
+    return ctx->estado;
+}
+
+// Calculo de uma vez so
+uint32_t CRC_Service_Calcular(CRC_Service_Tipo_t tipo, const void *dados, uint32_t tamanho) {
+    CRC_Service_Ctx_t ctx;
+    CRC_Service_Iniciar(&ctx, tipo);
+    CRC_Service_Atualizar(&ctx, dados, tamanho);
+    return CRC_Service_Finalizar(&ctx);
+}
+
+// Confere o periferico contra os valores de verificacao conhecidos (inclui caminho incremental)
+bool CRC_Service_Auto_Teste(void) {
+    static const uint8_t check[] = "123456789";
+    CRC_Service_Ctx_t ctx;
+
+    CRC_Service_Iniciar(&ctx, CRC_SERVICE_CRC32);
+    CRC_Service_Atualizar(&ctx, check, 4);
+    CRC_Service_Atualizar(&ctx, &check[4], 5);
+    if (CRC_Service_Finalizar(&ctx) != CRC_SERVICE_CHECK_CRC32) {
+        return false;
+    }
+    return (CRC_Service_Calcular(CRC_SERVICE_CRC16_MODBUS, check, 9) == CRC_SERVICE_CHECK_CRC16_MODBUS);
+}
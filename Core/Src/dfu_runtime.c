@@ -0,0 +1,114 @@
+/*
+ * Nome do Arquivo: dfu_runtime.c
+ * Descricao: Interface DFU runtime. O firmware ocupa ~93 KB dos 128 KB de flash
+ *            (sem banco duplo), entao nao ha area inativa para uma segunda imagem:
+ *            o download e feito pelo bootloader DFU da ROM apos o DFU_DETACH.
+ *            A integridade da imagem gravada e conferida no boot pelo periferico
+ *            CRC contra o trailer anexado pelo Tools/dfu_preparar.py.
+ * Autor: Gabriel Agune
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "dfu_runtime.h"
+#include "crc_service.h"
+#include "usb.h"
+#include "ux_api.h"
+#include "ux_device_class_dfu.h"
+#include <string.h>
+
+// ============================================================
+// Definicoes e Constantes Privadas
+// ============================================================
+
+// Fim da regiao de carga gerado pelo armlink (= tamanho do .bin)
+extern const uint8_t Load$$LR$$LR_IROM1$$Limit[];
+
+// ============================================================
+// Variaveis Estaticas
+// ============================================================
+
+static struct {
+    UX_SLAVE_CLASS_DFU* dfu;
+    bool                detach;
+    uint32_t            tick_detach;
+} s_dfu;
+
+// ============================================================
+// API Publica
+// ============================================================
+
+void DFU_Runtime_Set_Instancia(void *dfu) {
+    s_dfu.dfu = (UX_SLAVE_CLASS_DFU*)dfu;
+}
+
+void DFU_Runtime_Solicitar_Bootloader(void) {
+    s_dfu.detach = true;
+    s_dfu.tick_detach = HAL_GetTick();
+}
+
+// O DFU_DETACH chega por controle; a classe faz o soft-disconnect no tasks_run e
+// aqui so aguardamos o host perceber a desconexao antes de trocar para a ROM
+void DFU_Runtime_Process(void) {
+    if (!s_dfu.detach) {
+        if (s_dfu.dfu != NULL && ux_device_class_dfu_state_get(s_dfu.dfu) == UX_SYSTEM_DFU_STATE_APP_DETACH) {
+            DFU_Runtime_Solicitar_Bootloader();
+        }
+        return;
+    }
+
+    if ((HAL_GetTick() - s_dfu.tick_detach) >= DFU_RUNTIME_ATRASO_MS) {
+        DFU_Runtime_Entrar_Bootloader();
+    }
+}
+
+void DFU_Runtime_Entrar_Bootloader(void) {
+    const uint32_t* vetores = (const uint32_t*)DFU_RUNTIME_SISTEMA_BASE;
+
+    __disable_irq();
+
+    // Solta o pull-up de D+ para o host re-enumerar o dispositivo como DFU da ROM
+    HAL_PCD_Stop(&hpcd_USB_DRD_FS);
+
+    HAL_RCC_DeInit();
+    HAL_DeInit();
+
+    SysTick->CTRL = 0;
+    SysTick->LOAD = 0;
+    SysTick->VAL  = 0;
+    NVIC->ICER[0] = 0xFFFFFFFFUL;
+    NVIC->ICPR[0] = 0xFFFFFFFFUL;
+
+    __HAL_RCC_SYSCFG_CLK_ENABLE();
+    __HAL_SYSCFG_REMAPMEMORY_SYSTEMFLASH();
+
+    __set_MSP(vetores[0]);
+    __enable_irq();
+    ((void (*)(void))vetores[1])();
+
+    while (1) {
+    }
+}
+
+// Sem trailer (gravacao pelo depurador) a imagem nao e julgada; com trailer de
+// outro tamanho trata-se de lixo de uma gravacao anterior e tambem e ignorado
+DFU_Imagem_Status_t DFU_Runtime_Verificar_Imagem(uint32_t *crc_calculado, uint32_t *tamanho) {
+    uint32_t tam = (uint32_t)(Load$$LR$$LR_IROM1$$Limit - (const uint8_t*)DFU_RUNTIME_FLASH_BASE);
+    DFU_Trailer_t trailer;
+    memcpy(&trailer, Load$$LR$$LR_IROM1$$Limit, sizeof(trailer));
+
+    uint32_t crc = CRC_Service_Calcular(CRC_SERVICE_CRC32, (const void*)DFU_RUNTIME_FLASH_BASE, tam);
+    if (crc_calculado != NULL) {
+        *crc_calculado = crc;
+    }
+    if (tamanho != NULL) {
+        *tamanho = tam;
+    }
+
+    if (trailer.magico != DFU_RUNTIME_MAGICO || trailer.tamanho != tam) {
+        return DFU_IMAGEM_SEM_TRAILER;
+    }
+    return (trailer.crc32 == crc) ? DFU_IMAGEM_OK : DFU_IMAGEM_CORROMPIDA;
+}
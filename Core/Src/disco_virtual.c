@@ -0,0 +1,391 @@
+/*
+ * Nome do Arquivo: disco_virtual.c
+ * Descricao: Disco FAT12 somente-leitura sintetizado sob demanda. Nenhum setor
+ *            fica em RAM: boot, FATs e diretorio sao gerados a partir da
+ *            tabela fixa de arquivos; o conteudo vem da configuracao (INFO.TXT,
+ *            GRAOS.CSV) ou da EEPROM lida por setor (EEPROM.BIN, com a regiao
+ *            de configuracao mascarada: ela guarda a senha do sistema).
+ * Autor: Gabriel Agune
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "disco_virtual.h"
+#include "gerenciador_configuracoes.h"
+#include "eeprom_driver.h"
+#include "rtc_driver.h"
+#include "stm32c0xx_hal.h"
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================
+// Definicoes e Constantes Privadas
+// ============================================================
+
+// Layout do volume (1 setor por cluster)
+#define DISCO_LBA_BOOT          0u
+#define DISCO_LBA_FAT1          1u
+#define DISCO_LBA_FAT2          2u
+#define DISCO_LBA_RAIZ          3u
+#define DISCO_LBA_DADOS         4u      // Cluster 2
+#define DISCO_ENTRADAS_RAIZ     16u
+
+// GRAOS.CSV: linhas de largura fixa para localizar qualquer linha pelo offset
+#define DISCO_CSV_LINHA         64u
+#define DISCO_CSV_POR_SETOR     (DISCO_VIRTUAL_SETOR / DISCO_CSV_LINHA)
+
+#define DISCO_CLUSTERS_INFO     1u
+#define DISCO_CLUSTERS_GRAOS    ((((MAX_GRAOS + 1u) * DISCO_CSV_LINHA) + DISCO_VIRTUAL_SETOR - 1u) / DISCO_VIRTUAL_SETOR)
+#define DISCO_CLUSTERS_EEPROM   (DISCO_VIRTUAL_EEPROM_BYTES / DISCO_VIRTUAL_SETOR)
+#define DISCO_CLUSTERS          (DISCO_CLUSTERS_INFO + DISCO_CLUSTERS_GRAOS + DISCO_CLUSTERS_EEPROM)
+#define DISCO_TOTAL_SETORES     (DISCO_LBA_DADOS + DISCO_CLUSTERS)
+
+#define FAT_ATTR_SOMENTE_LEITURA 0x01u
+#define FAT_ATTR_VOLUME          0x08u
+#define FAT12_FIM_CADEIA         0xFFFu
+
+typedef enum {
+    ARQ_INFO = 0,
+    ARQ_GRAOS,
+    ARQ_EEPROM,
+    ARQ_QTD
+} Disco_Arquivo_t;
+
+typedef enum {
+    LEITURA_LIVRE = 0,
+    LEITURA_AGUARDANDO,
+    LEITURA_CONCLUIDA,
+    LEITURA_FALHA
+} Disco_Leitura_t;
+
+// Tabela fixa de arquivos (nome 8.3 sem ponto, primeiro cluster, clusters reservados)
+static const struct {
+    char     nome[12];
+    uint16_t cluster;
+    uint16_t clusters;
+} k_arquivos[ARQ_QTD] = {
+    { "INFO    TXT", 2u,                                          DISCO_CLUSTERS_INFO   },
+    { "GRAOS   CSV", 2u + DISCO_CLUSTERS_INFO,                    DISCO_CLUSTERS_GRAOS  },
+    { "EEPROM  BIN", 2u + DISCO_CLUSTERS_INFO + DISCO_CLUSTERS_GRAOS, DISCO_CLUSTERS_EEPROM },
+};
+
+static const char k_rotulo[] = "MEDIDOR    ";
+
+// ============================================================
+// Variaveis Estaticas
+// ============================================================
+
+static struct {
+    uint32_t                 tamanho[ARQ_QTD];  // Congelados no Montar
+    uint16_t                 data_fat;
+    uint16_t                 hora_fat;
+    volatile Disco_Leitura_t leitura;           // Leitura da EEPROM em andamento
+    uint32_t                 lba_leitura;
+} s_disco;
+
+// ============================================================
+// Prototipos de Funcoes Privadas
+// ============================================================
+
+static void Disco_Put16(uint8_t *p, uint16_t v);
+static void Disco_Put32(uint8_t *p, uint32_t v);
+static int Disco_Gerar_Info(char *buf, size_t tamanho);
+static void Disco_Gerar_Boot(uint8_t *p);
+static void Disco_Gerar_FAT(uint8_t *p);
+static void Disco_Gerar_Raiz(uint8_t *p);
+static void Disco_Gerar_Graos(uint8_t *p, uint32_t offset);
+static uint16_t Disco_Valor_FAT(uint32_t cluster);
+static Disco_Virtual_Status_t Disco_Ler_EEPROM(uint32_t lba, uint32_t offset, uint8_t *p);
+static void Disco_EEPROM_Callback(bool sucesso, void *ctx);
+static void Disco_Mascarar_Config(uint32_t offset, uint8_t *p);
+
+// ============================================================
+// Funcoes Privadas
+// ============================================================
+
+static void Disco_Put16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void Disco_Put32(uint8_t *p, uint32_t v) {
+    Disco_Put16(p, (uint16_t)v);
+    Disco_Put16(&p[2], (uint16_t)(v >> 16));
+}
+
+// Formata o INFO.TXT; com buf NULL apenas mede o tamanho
+static int Disco_Gerar_Info(char *buf, size_t tamanho) {
+    char serial[17] = {0};
+    char usuario[21] = {0};
+    char empresa[21] = {0};
+    float ganho = 0.0f, zero = 0.0f;
+    uint8_t ativo = 0;
+
+    Gerenciador_Config_Get_Serial(serial, sizeof(serial));
+    Gerenciador_Config_Get_Usuario(usuario, sizeof(usuario));
+    Gerenciador_Config_Get_Company(empresa, sizeof(empresa));
+    Gerenciador_Config_Get_Cal_A(&ganho, &zero);
+    Gerenciador_Config_Get_Grao_Ativo(&ativo);
+
+    return snprintf(buf, tamanho,
+                    "Firmware: %s\r\nIHM: %s\r\nHardware: %s\r\nSerie: %s\r\n"
+                    "Usuario: %s\r\nEmpresa: %s\r\n"
+                    "Graos cadastrados: %u\r\nGrao ativo: %u\r\n"
+                    "Cal A ganho: %.6f\r\nCal A zero: %.6f\r\n"
+                    "Repeticoes: %u\r\nDecimais: %u\r\n",
+                    FIRMWARE, FIRM_IHM, HARDWARE, serial, usuario, empresa,
+                    (unsigned)Gerenciador_Config_Get_Num_Graos(), (unsigned)ativo,
+                    (double)ganho, (double)zero,
+                    (unsigned)Gerenciador_Config_Get_NR_Repetition(),
+                    (unsigned)Gerenciador_Config_Get_NR_Decimals());
+}
+
+// Setor de boot com BPB FAT12
+static void Disco_Gerar_Boot(uint8_t *p) {
+    static const uint8_t salto[3] = { 0xEB, 0x3C, 0x90 };
+
+    memcpy(p, salto, sizeof(salto));
+    memcpy(&p[3], "MSWIN4.1", 8);
+    Disco_Put16(&p[11], DISCO_VIRTUAL_SETOR);  // Bytes por setor
+    p[13] = 1;                                 // Setores por cluster
+    Disco_Put16(&p[14], DISCO_LBA_FAT1);       // Setores reservados
+    p[16] = 2;                                 // Numero de FATs
+    Disco_Put16(&p[17], DISCO_ENTRADAS_RAIZ);
+    Disco_Put16(&p[19], DISCO_TOTAL_SETORES);
+    p[21] = 0xF8;                              // Midia fixa
+    Disco_Put16(&p[22], 1);                    // Setores por FAT
+    Disco_Put16(&p[24], 1);                    // Setores por trilha
+    Disco_Put16(&p[26], 1);                    // Cabecas
+    p[36] = 0x80;                              // Numero do drive
+    p[38] = 0x29;                              // Assinatura estendida
+    Disco_Put32(&p[39], HAL_GetUIDw0() ^ HAL_GetUIDw1());
+    memcpy(&p[43], k_rotulo, 11);
+    memcpy(&p[54], "FAT12   ", 8);
+    p[510] = 0x55;
+    p[511] = 0xAA;
+}
+
+// Entrada da FAT para um cluster: cadeia linear ate o fim do arquivo, demais livres
+static uint16_t Disco_Valor_FAT(uint32_t cluster) {
+    if (cluster == 0u) {
+        return 0xFF8u;
+    }
+    if (cluster == 1u) {
+        return FAT12_FIM_CADEIA;
+    }
+    for (uint8_t i = 0; i < ARQ_QTD; i++) {
+        uint32_t usados = (s_disco.tamanho[i] + DISCO_VIRTUAL_SETOR - 1u) / DISCO_VIRTUAL_SETOR;
+        if (cluster >= k_arquivos[i].cluster && cluster < (k_arquivos[i].cluster + usados)) {
+            return (cluster == k_arquivos[i].cluster + usados - 1u) ? FAT12_FIM_CADEIA : (uint16_t)(cluster + 1u);
+        }
+    }
+    return 0u;
+}
+
+// FAT12: entradas de 12 bits empacotadas (duas a cada tres bytes)
+static void Disco_Gerar_FAT(uint8_t *p) {
+    for (uint32_t c = 0; c < (2u + DISCO_CLUSTERS); c++) {
+        uint16_t v = Disco_Valor_FAT(c);
+        uint32_t o = (c * 3u) / 2u;
+        if ((c & 1u) == 0u) {
+            p[o]     = (uint8_t)v;
+            p[o + 1] = (uint8_t)((p[o + 1] & 0xF0u) | ((v >> 8) & 0x0Fu));
+        } else {
+            p[o]     = (uint8_t)((p[o] & 0x0Fu) | ((v & 0x0Fu) << 4));
+            p[o + 1] = (uint8_t)(v >> 4);
+        }
+    }
+}
+
+// Diretorio raiz: rotulo do volume + arquivos
+static void Disco_Gerar_Raiz(uint8_t *p) {
+    memcpy(p, k_rotulo, 11);
+    p[11] = FAT_ATTR_VOLUME;
+    Disco_Put16(&p[22], s_disco.hora_fat);
+    Disco_Put16(&p[24], s_disco.data_fat);
+
+    for (uint8_t i = 0; i < ARQ_QTD; i++) {
+        uint8_t *e = &p[32u * (i + 1u)];
+        memcpy(e, k_arquivos[i].nome, 11);
+        e[11] = FAT_ATTR_SOMENTE_LEITURA;
+        Disco_Put16(&e[14], s_disco.hora_fat);  // Criacao
+        Disco_Put16(&e[16], s_disco.data_fat);
+        Disco_Put16(&e[18], s_disco.data_fat);  // Ultimo acesso
+        Disco_Put16(&e[22], s_disco.hora_fat);  // Escrita
+        Disco_Put16(&e[24], s_disco.data_fat);
+        Disco_Put16(&e[26], k_arquivos[i].cluster);
+        Disco_Put32(&e[28], s_disco.tamanho[i]);
+    }
+}
+
+// GRAOS.CSV: gera as linhas de largura fixa que caem no setor
+static void Disco_Gerar_Graos(uint8_t *p, uint32_t offset) {
+    uint8_t num_graos = Gerenciador_Config_Get_Num_Graos();
+    uint32_t primeira = offset / DISCO_CSV_LINHA;
+    char linha[DISCO_CSV_LINHA];
+
+    for (uint32_t k = 0; k < DISCO_CSV_POR_SETOR; k++) {
+        uint32_t idx = primeira + k;
+        uint8_t *dest = &p[k * DISCO_CSV_LINHA];
+        int n;
+
+        if (idx == 0u) {
+            n = snprintf(linha, sizeof(linha), "IDX;NOME;VALIDADE;CURVA;UMID_MIN;UMID_MAX");
+        } else if ((idx - 1u) < num_graos) {
+            Config_Grao_t g;
+            memset(&g, 0, sizeof(g));
+            Gerenciador_Config_Get_Dados_Grao((uint8_t)(idx - 1u), &g);
+            n = snprintf(linha, sizeof(linha), "%03u;%-16.16s;%-10.10s;%10lu;%6d;%6d",
+                         (unsigned)(idx - 1u), g.nome, g.validade, (unsigned long)g.id_curva,
+                         (int)g.umidade_min, (int)g.umidade_max);
+        } else {
+            break;  // Alem do fim do arquivo
+        }
+
+        if (n < 0) {
+            n = 0;
+        } else if (n > (int)(DISCO_CSV_LINHA - 2u)) {
+            n = (int)(DISCO_CSV_LINHA - 2u);
+        }
+        memset(dest, ' ', DISCO_CSV_LINHA - 2u);
+        memcpy(dest, linha, (size_t)n);
+        dest[DISCO_CSV_LINHA - 2u] = '\r';
+        dest[DISCO_CSV_LINHA - 1u] = '\n';
+    }
+}
+
+// EEPROM.BIN: um setor por leitura assincrona; o host repete a chamada com o mesmo LBA
+static Disco_Virtual_Status_t Disco_Ler_EEPROM(uint32_t lba, uint32_t offset, uint8_t *p) {
+    // Setor inteiro dentro da configuracao: nem chega a ler a EEPROM
+    if (offset + DISCO_VIRTUAL_SETOR <= (uint32_t)END_OF_CONFIG_DATA) {
+        Disco_Mascarar_Config(offset, p);
+        return DISCO_VIRTUAL_OK;
+    }
+
+    switch (s_disco.leitura) {
+        case LEITURA_LIVRE:
+            if (EEPROM_Driver_Read_Async((uint16_t)offset, p, DISCO_VIRTUAL_SETOR, Disco_EEPROM_Callback, NULL)) {
+                s_disco.lba_leitura = lba;
+                s_disco.leitura = LEITURA_AGUARDANDO;
+            }
+            return DISCO_VIRTUAL_PENDENTE;  // Fila cheia: tenta na proxima chamada
+
+        case LEITURA_CONCLUIDA:
+        case LEITURA_FALHA:
+            if (s_disco.lba_leitura != lba) {
+                // Resultado orfao (host abortou o comando): descarta e recomeca
+                s_disco.leitura = LEITURA_LIVRE;
+                return DISCO_VIRTUAL_PENDENTE;
+            }
+            {
+                bool ok = (s_disco.leitura == LEITURA_CONCLUIDA);
+                s_disco.leitura = LEITURA_LIVRE;
+                if (ok) {
+                    Disco_Mascarar_Config(offset, p);
+                }
+                return ok ? DISCO_VIRTUAL_OK : DISCO_VIRTUAL_ERRO;
+            }
+
+        case LEITURA_AGUARDANDO:
+        default:
+            return DISCO_VIRTUAL_PENDENTE;
+    }
+}
+
+// Apaga (0xFF) o trecho do setor que cai na regiao de configuracao: copias legadas e
+// slots A/B guardam senha_sistema em texto puro e nao podem sair pelo USB
+static void Disco_Mascarar_Config(uint32_t offset, uint8_t *p) {
+    if (offset >= (uint32_t)END_OF_CONFIG_DATA) {
+        return;
+    }
+    uint32_t n = (uint32_t)END_OF_CONFIG_DATA - offset;
+    if (n > DISCO_VIRTUAL_SETOR) {
+        n = DISCO_VIRTUAL_SETOR;
+    }
+    memset(p, 0xFF, n);
+}
+
+// Conclusao da leitura da EEPROM. Roda em contexto de interrupcao (fim da
+// transacao no gerenciador do barramento I2C): so publica o resultado em
+// s_disco.leitura. Nada bloqueante aqui; o mascaramento fica no Disco_Ler_EEPROM
+static void Disco_EEPROM_Callback(bool sucesso, void *ctx) {
+    (void)ctx;
+    s_disco.leitura = sucesso ? LEITURA_CONCLUIDA : LEITURA_FALHA;
+}
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Congela tamanhos e carimbo de data para que diretorio e FAT fiquem coerentes
+void Disco_Virtual_Montar(void) {
+    int info = Disco_Gerar_Info(NULL, 0);
+    if (info < 0) {
+        info = 0;
+    } else if (info >= (int)DISCO_VIRTUAL_SETOR) {
+        info = (int)DISCO_VIRTUAL_SETOR - 1;  // snprintf reserva o terminador
+    }
+    s_disco.tamanho[ARQ_INFO]   = (uint32_t)info;
+    s_disco.tamanho[ARQ_GRAOS]  = (1u + Gerenciador_Config_Get_Num_Graos()) * DISCO_CSV_LINHA;
+    s_disco.tamanho[ARQ_EEPROM] = DISCO_VIRTUAL_EEPROM_BYTES;
+
+    RTC_Calendario_t cal = { .dia = 1, .mes = 1 };
+    RTC_Driver_Get_Calendario(&cal);
+    // FAT: ano desde 1980; o RTC guarda 20AA
+    s_disco.data_fat = (uint16_t)(((cal.ano + 20u) << 9) | ((uint16_t)cal.mes << 5) | cal.dia);
+    s_disco.hora_fat = (uint16_t)(((uint16_t)cal.hora << 11) | ((uint16_t)cal.minuto << 5) | (cal.segundo / 2u));
+}
+
+uint32_t Disco_Virtual_Total_Setores(void) {
+    return DISCO_TOTAL_SETORES;
+}
+
+Disco_Virtual_Status_t Disco_Virtual_Ler_Setor(uint32_t lba, uint8_t *buf) {
+    if (buf == NULL || lba >= DISCO_TOTAL_SETORES) {
+        return DISCO_VIRTUAL_ERRO;
+    }
+
+    // Setores de dados: localiza o arquivo dono do cluster
+    if (lba >= DISCO_LBA_DADOS) {
+        uint32_t cluster = (lba - DISCO_LBA_DADOS) + 2u;
+        for (uint8_t i = 0; i < ARQ_QTD; i++) {
+            if (cluster < k_arquivos[i].cluster || cluster >= (uint32_t)(k_arquivos[i].cluster + k_arquivos[i].clusters)) {
+                continue;
+            }
+            uint32_t offset = (cluster - k_arquivos[i].cluster) * DISCO_VIRTUAL_SETOR;
+            if (offset >= s_disco.tamanho[i]) {
+                break;
+            }
+            if (i == ARQ_EEPROM) {
+                return Disco_Ler_EEPROM(lba, offset, buf);
+            }
+            memset(buf, 0, DISCO_VIRTUAL_SETOR);
+            if (i == ARQ_INFO) {
+                Disco_Gerar_Info((char*)buf, DISCO_VIRTUAL_SETOR);
+            } else {
+                Disco_Gerar_Graos(buf, offset);
+            }
+            return DISCO_VIRTUAL_OK;
+        }
+        memset(buf, 0, DISCO_VIRTUAL_SETOR);
+        return DISCO_VIRTUAL_OK;
+    }
+
+    memset(buf, 0, DISCO_VIRTUAL_SETOR);
+    switch (lba) {
+        case DISCO_LBA_BOOT:
+            Disco_Gerar_Boot(buf);
+            break;
+        case DISCO_LBA_FAT1:
+        case DISCO_LBA_FAT2:
+            Disco_Gerar_FAT(buf);
+            break;
+        case DISCO_LBA_RAIZ:
+        default:
+            Disco_Gerar_Raiz(buf);
+            break;
+    }
+    return DISCO_VIRTUAL_OK;
+}
@@ -13,6 +13,7 @@
 #include "relato.h"
 #include "temp_sensor.h"
 #include "dwin_parser.h"
+#include "servo_controle.h"
 
 
 // ============================================================
@@ -85,6 +86,7 @@ void Display_StartMeasurementSequence(void) {
         printf("DISPLAY: Iniciando sequencia de medicao...\r\n");
         s_mede_state = MEDE_STATE_ENCHE_CAMARA;
         s_mede_last_tick = HAL_GetTick();
+        Servos_Start_Sequence();
         Controller_SetScreen(MEDE_ENCHE_CAMARA);
     }
 }
@@ -159,8 +161,11 @@ void Display_SetDecimals(uint16_t received_value) {
         DWIN_Driver_WriteString(VP_MESSAGES, buffer, strlen(buffer));
         Controller_SetScreen(TELA_SET_DECIMALS);
     } else {
-        Gerenciador_Config_Set_NR_Decimals(received_value);
-        sprintf(buffer, "Casas decimais: %u", received_value);
+        if (Gerenciador_Config_Set_NR_Decimals(received_value)) {
+            sprintf(buffer, "Casas decimais: %u", received_value);
+        } else {
+            sprintf(buffer, "Casas decimais: 0 a %u", (unsigned)MAX_NR_DECIMALS);
+        }
 		DWIN_Driver_WriteString(VP_MESSAGES, buffer, strlen(buffer));
     }
 }
@@ -283,7 +288,12 @@ static void ProcessMeasurementSequenceFSM(void) {
         return;
     }
 
-    if (HAL_GetTick() - s_mede_last_tick < MEDE_INTERVAL_MS) {
+    // A raspagem termina pelo evento dos servos, sem esperar o intervalo de tela
+    if (s_mede_state == MEDE_STATE_RASPA_CAMARA) {
+        if (!Servos_Sequencia_Concluida()) {
+            return;
+        }
+    } else if (HAL_GetTick() - s_mede_last_tick < MEDE_INTERVAL_MS) {
         return;
     }
     s_mede_last_tick = HAL_GetTick();
@@ -372,26 +382,18 @@ static void UpdateClockOnMainScreen(void) {
         case TELA_SET_JUST_TIME:
         case TELA_ABOUT_SYSTEM:
         case TELA_ADJUST_TIME: {
-            uint8_t h, m, s, d, mo, y;
-            char weekday_dummy[4];
+            RTC_Calendario_t cal;
 
-            if (RTC_Driver_GetTime(&h, &m, &s) && RTC_Driver_GetDate(&d, &mo, &y, weekday_dummy)) {
+            if (RTC_Driver_Get_Calendario(&cal)) {
                 // Montagem do comando DWIN para escrita da data e hora
-                uint8_t rtc_command[] = {
+                uint8_t rtc_command[6 + RTC_DWIN_DATA_HORA_BYTES] = {
                     0x5A, 0xA5,
-                    0x0B,
+                    3 + RTC_DWIN_DATA_HORA_BYTES,
                     0x82,
                     (VP_DATA_HORA >> 8) & 0xFF,
-                    VP_DATA_HORA & 0xFF,
-                    y,
-                    mo,
-                    d,
-                    0x03,
-                    h,
-                    m,
-                    s,
-                    0x00
+                    VP_DATA_HORA & 0xFF
                 };
+                RTC_Driver_Calendario_Para_DWIN(&cal, &rtc_command[6]);
                 DWIN_Driver_WriteRawBytes(rtc_command, sizeof(rtc_command));
             }
         }
@@ -5,6 +5,7 @@
  */
 
 #include "dwin_driver.h"
+#include "ring_buffer.h"
 #include <string.h>
 
 // ============================================================
@@ -19,6 +20,11 @@ static volatile bool       s_frame_received     = false;
 static volatile uint16_t   s_received_len       = 0;
 static volatile uint32_t   s_rx_packet_counter  = 0;
 
+// Transmisso por interrupo a partir de um anel (no bloqueia o loop principal)
+static uint8_t             s_tx_buffer[DWIN_TX_BUFFER_SIZE];
+static RingBuffer_t        s_tx_ring;
+static volatile uint32_t   s_tx_em_andamento    = 0;
+
 // ============================================================
 // Funes Privadas
 // ============================================================
@@ -34,6 +40,39 @@ static void DWIN_Restart_Rx(void) {
     }
 }
 
+// Inicia a prxima transmisso se a UART estiver livre (chamada pelo main e pelo TxCplt)
+static void DWIN_Iniciar_Tx(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (s_tx_em_andamento == 0u) {
+        uint8_t* p;
+        uint32_t n = RingBuffer_Ler_Contiguo(&s_tx_ring, &p);
+        if ((n > 0u) && (HAL_UART_Transmit_IT(s_huart, p, (uint16_t)n) == HAL_OK)) {
+            s_tx_em_andamento = n;
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+// Enfileira um quadro inteiro. Com o anel cheio, aguarda espao por at
+// DWIN_UART_TIMEOUT_MS (somente fora de ISR); quadros nunca so cortados.
+static bool DWIN_Enviar(const uint8_t *frame, uint16_t len) {
+    const uint32_t inicio = HAL_GetTick();
+
+    while (!RingBuffer_Escrever_Inteiro(&s_tx_ring, frame, len)) {
+        if ((len > DWIN_TX_BUFFER_SIZE) || (__get_IPSR() != 0u) ||
+            ((HAL_GetTick() - inicio) >= DWIN_UART_TIMEOUT_MS)) {
+            return false;
+        }
+        DWIN_Iniciar_Tx();
+    }
+
+    DWIN_Iniciar_Tx();
+    return true;
+}
+
 // ============================================================
 // Funes Pblicas
 // ============================================================
@@ -47,6 +86,9 @@ void DWIN_Driver_Init(UART_HandleTypeDef *huart, dwin_rx_callback_t callback) {
     s_received_len = 0;
     s_rx_packet_counter = 0;
 
+    RingBuffer_Init(&s_tx_ring, s_tx_buffer, DWIN_TX_BUFFER_SIZE);
+    s_tx_em_andamento = 0;
+
     DWIN_Restart_Rx();
 }
 
@@ -99,7 +141,7 @@ bool DWIN_Driver_SetScreen(uint16_t screen_id) {
         (uint8_t)(screen_id & 0xFF)
     };
 
-    return (HAL_UART_Transmit(s_huart, cmd_buffer, sizeof(cmd_buffer), DWIN_UART_TIMEOUT_MS) == HAL_OK);
+    return DWIN_Enviar(cmd_buffer, sizeof(cmd_buffer));
 }
 
 // Escreve um valor inteiro de 16 bits em um endereo VP
@@ -118,7 +160,7 @@ bool DWIN_Driver_WriteInt(uint16_t vp_address, int16_t value) {
         (uint8_t)(value & 0xFF)
     };
 
-    return (HAL_UART_Transmit(s_huart, cmd_buffer, sizeof(cmd_buffer), DWIN_UART_TIMEOUT_MS) == HAL_OK);
+    return DWIN_Enviar(cmd_buffer, sizeof(cmd_buffer));
 }
 
 // Escreve um valor inteiro de 32 bits em um endereo VP
@@ -139,7 +181,7 @@ bool DWIN_Driver_WriteInt32(uint16_t vp_address, int32_t value) {
         (uint8_t)(value & 0xFF)
     };
 
-    return (HAL_UART_Transmit(s_huart, cmd_buffer, sizeof(cmd_buffer), DWIN_UART_TIMEOUT_MS) == HAL_OK);
+    return DWIN_Enviar(cmd_buffer, sizeof(cmd_buffer));
 }
 
 // Escreve uma string ASCII em um endereo VP
@@ -169,7 +211,7 @@ bool DWIN_Driver_WriteString(uint16_t vp_address, const char *text, uint16_t max
     frame[6 + text_len] = 0xFF;
     frame[6 + text_len + 1] = 0xFF;
 
-    return (HAL_UART_Transmit(s_huart, frame, total_frame_size, DWIN_UART_TIMEOUT_MS) == HAL_OK);
+    return DWIN_Enviar(frame, total_frame_size);
 }
 
 // Escreve string formatada para QR Code (sem terminadores 0xFF)
@@ -199,7 +241,7 @@ bool DWIN_Driver_Write_QR_String(uint16_t vp_address, const char *text, uint16_t
 
     memcpy(&frame[6], text, text_len);
 
-    return (HAL_UART_Transmit(s_huart, frame, total_frame_size, DWIN_UART_TIMEOUT_MS) == HAL_OK);
+    return DWIN_Enviar(frame, total_frame_size);
 }
 
 // Envia bytes brutos diretamente para o display
@@ -208,7 +250,18 @@ bool DWIN_Driver_WriteRawBytes(const uint8_t *data, uint16_t size) {
         return false;
     }
 
-    return (HAL_UART_Transmit(s_huart, (uint8_t *)data, size, DWIN_UART_TIMEOUT_MS) == HAL_OK);
+    return DWIN_Enviar(data, size);
+}
+
+// Libera o trecho transmitido e encadeia o prximo
+void DWIN_Driver_HandleTxCplt(UART_HandleTypeDef *huart) {
+    if ((s_huart == NULL) || (huart->Instance != s_huart->Instance)) {
+        return;
+    }
+
+    RingBuffer_Descartar(&s_tx_ring, s_tx_em_andamento);
+    s_tx_em_andamento = 0;
+    DWIN_Iniciar_Tx();
 }
 
 // Trata o evento de recepo UART (Idle Line)
@@ -1,6 +1,6 @@
 /*
  * Nome do Arquivo: eeprom_driver.c
- * Descrio: Driver no-bloqueante para EEPROM I2C com FSM de escrita
+ * Descrio: Driver no-bloqueante para EEPROM I2C com fila de requisies (leitura/escrita)
  * Autor: Gabriel Agune
  */
 
@@ -9,8 +9,10 @@
 // ============================================================
 
 #include "eeprom_driver.h"
+#include "i2c_bus_manager.h"
 #include <stdio.h>
 #include <string.h>
+#include <stddef.h>
 
 // ============================================================
 // Definies e Constantes Privadas
@@ -19,20 +21,44 @@
 // Endereo I2C de 8 bits para o HAL
 #define EEPROM_I2C_ADDR (0x50 << 1)
 
+// Janela de ACK polling: a EEPROM no responde (NACK) enquanto conclui um ciclo de escrita.
+// Limite superior para o tWR; acima disso a escrita  considerada falha.
+#define EEPROM_ACK_POLL_MS  (EEPROM_WRITE_TIME_MS * 2)
+
 // ============================================================
 // Tipos de Dados Privados
 // ============================================================
 
-// Estados da Mquina de Estados Finitos (FSM) para escrita assncrona
+// Estados da Mquina de Estados Finitos (FSM) das requisies assncronas
 typedef enum {
     FSM_IDLE,
+    FSM_READ,
     FSM_WRITE_CHUNK,
     FSM_WAIT_I2C_IT,
-    FSM_WAIT_PAGE_WRITE_DELAY,
+    FSM_ACK_POLL,        // Sonda de ACK pendente (fila do barramento estava cheia)
+    FSM_WAIT_ACK_POLL,   // Aguardando ACK da EEPROM (fim do ciclo interno de escrita)
+    FSM_REQUEST_DONE,   // Sinalizado pela ISR, finalizado no contexto principal
+    FSM_REQUEST_FAILED, // Sinalizado pela ISR, finalizado no contexto principal
     FSM_FINISHED,
     FSM_ERROR
 } EepromFsmState_t;
 
+// Tipo de operao de uma requisio da fila
+typedef enum {
+    EEPROM_OP_READ,
+    EEPROM_OP_WRITE
+} EepromOp_t;
+
+// Requisio enfileirada
+typedef struct {
+    EepromOp_t          op;
+    uint16_t            addr;
+    uint8_t* p_data;
+    uint16_t            size;
+    EEPROM_Callback_t   callback;
+    void* ctx;
+} EepromRequest_t;
+
 // ============================================================
 // Variveis Estticas
 // ============================================================
@@ -40,33 +66,151 @@ typedef enum {
 // Estrutura de controle da mquina de estados (FSM)
 static struct {
     I2C_HandleTypeDef* i2c_handle;
-    EepromFsmState_t    state;
-    const uint8_t* p_data;
+    volatile EepromFsmState_t state;
+    EepromRequest_t     atual;
+    uint8_t* p_data;
     uint16_t            current_addr;
     uint16_t            bytes_remaining;
-    uint32_t            delay_start_tick;
     bool                error_flag;
 } s_fsm;
 
+// Fila circular de requisies (acessada apenas no contexto principal)
+static struct {
+    EepromRequest_t itens[EEPROM_QUEUE_SIZE];
+    uint8_t         head;
+    uint8_t         tail;
+    uint8_t         count;
+} s_fila;
+
 // ============================================================
 // Prottipos de Funes Privadas
 // ============================================================
 
 static void EEPROM_Driver_ResetPeripheral(void);
+static bool EEPROM_Driver_Enfileirar(EepromOp_t op, uint16_t addr, uint8_t *data, uint16_t size, EEPROM_Callback_t cb, void *ctx);
+static bool EEPROM_Driver_Iniciar_Proxima(void);
+static void EEPROM_Driver_Finalizar_Requisicao(bool sucesso);
+static bool EEPROM_Driver_Submeter(I2C_Bus_Op_t op, uint16_t addr, uint8_t *data, uint16_t size);
+static void EEPROM_Driver_Escrever_Pagina(void);
+static void EEPROM_Driver_Sondar_ACK(void);
+static void EEPROM_Driver_Bus_Callback(bool sucesso, void *ctx);
 
 // ============================================================
 // Funes Privadas
 // ============================================================
 
-// Tenta recuperar o perifrico I2C em caso de travamento
+// Tenta recuperar o barramento I2C em caso de travamento
 static void EEPROM_Driver_ResetPeripheral(void) {
-    if (s_fsm.i2c_handle == NULL) {
+    if (s_fsm.i2c_handle == NULL || !I2C_Bus_IsIdle()) {
         return;
     }
-    printf("EEPROM Driver: Resetando perifrico I2C...\r\n");
-    HAL_I2C_DeInit(s_fsm.i2c_handle);
-    HAL_Delay(5);
-    HAL_I2C_Init(s_fsm.i2c_handle);
+    printf("EEPROM Driver: Recuperando barramento I2C...\r\n");
+    I2C_Bus_Recover();
+}
+
+// Entrega uma transao da FSM ao gerenciador do barramento
+static bool EEPROM_Driver_Submeter(I2C_Bus_Op_t op, uint16_t addr, uint8_t *data, uint16_t size) {
+    I2C_Bus_Transacao_t t = {0};
+    t.op            = op;
+    t.dev_addr      = EEPROM_I2C_ADDR;
+    t.mem_addr      = addr;
+    t.mem_addr_size = I2C_MEMADD_SIZE_16BIT;
+    t.p_data        = data;
+    t.size          = size;
+    t.timeout_ms    = (uint16_t)(EEPROM_I2C_TIMEOUT_BOOT + size / 4);
+    t.ack_poll_ms   = EEPROM_ACK_POLL_MS;
+    t.callback      = EEPROM_Driver_Bus_Callback;
+    t.ctx           = NULL;
+    return I2C_Bus_Submit(&t, I2C_BUS_PRIO_NORMAL);
+}
+
+// Enfileira a escrita da prxima pgina (contexto principal ou ISR)
+static void EEPROM_Driver_Escrever_Pagina(void) {
+    uint16_t chunk_size = EEPROM_PAGE_SIZE - (s_fsm.current_addr % EEPROM_PAGE_SIZE);
+    uint8_t* p_chunk = s_fsm.p_data;
+    uint16_t addr_chunk = s_fsm.current_addr;
+
+    if (chunk_size > s_fsm.bytes_remaining) {
+        chunk_size = s_fsm.bytes_remaining;
+    }
+
+    // Estado e contadores so atualizados antes do submit: a concluso pode chegar pela ISR imediatamente
+    s_fsm.p_data += chunk_size;
+    s_fsm.bytes_remaining -= chunk_size;
+    s_fsm.current_addr += chunk_size;
+    s_fsm.state = FSM_WAIT_I2C_IT;
+
+    if (!EEPROM_Driver_Submeter(I2C_BUS_OP_WRITE, addr_chunk, p_chunk, chunk_size)) {
+        // Fila do barramento cheia: desfaz e tenta novamente no prximo ciclo
+        s_fsm.p_data = p_chunk;
+        s_fsm.bytes_remaining += chunk_size;
+        s_fsm.current_addr = addr_chunk;
+        s_fsm.state = FSM_WRITE_CHUNK;
+    }
+}
+
+// Enfileira uma sonda de endereo; o gerenciador repete enquanto houver NACK (at EEPROM_ACK_POLL_MS)
+static void EEPROM_Driver_Sondar_ACK(void) {
+    s_fsm.state = FSM_WAIT_ACK_POLL;
+    if (!EEPROM_Driver_Submeter(I2C_BUS_OP_PROBE, 0, NULL, 0)) {
+        s_fsm.state = FSM_ACK_POLL;
+    }
+}
+
+// Insere uma requisio no fim da fila
+static bool EEPROM_Driver_Enfileirar(EepromOp_t op, uint16_t addr, uint8_t *data, uint16_t size, EEPROM_Callback_t cb, void *ctx) {
+    if (s_fsm.i2c_handle == NULL || data == NULL || size == 0) {
+        return false;
+    }
+    if (s_fila.count >= EEPROM_QUEUE_SIZE) {
+        return false;
+    }
+
+    EepromRequest_t* req = &s_fila.itens[s_fila.tail];
+    req->op       = op;
+    req->addr     = addr;
+    req->p_data   = data;
+    req->size     = size;
+    req->callback = cb;
+    req->ctx      = ctx;
+
+    s_fila.tail = (uint8_t)((s_fila.tail + 1) % EEPROM_QUEUE_SIZE);
+    s_fila.count++;
+    return true;
+}
+
+// Retira a prxima requisio da fila e prepara a FSM para execut-la
+static bool EEPROM_Driver_Iniciar_Proxima(void) {
+    if (s_fila.count == 0) {
+        return false;
+    }
+
+    s_fsm.atual = s_fila.itens[s_fila.head];
+    s_fila.head = (uint8_t)((s_fila.head + 1) % EEPROM_QUEUE_SIZE);
+    s_fila.count--;
+
+    s_fsm.p_data          = s_fsm.atual.p_data;
+    s_fsm.current_addr    = s_fsm.atual.addr;
+    s_fsm.bytes_remaining = s_fsm.atual.size;
+    s_fsm.state = (s_fsm.atual.op == EEPROM_OP_READ) ? FSM_READ : FSM_WRITE_CHUNK;
+    return true;
+}
+
+// Encerra a requisio atual e notifica o solicitante (contexto principal)
+static void EEPROM_Driver_Finalizar_Requisicao(bool sucesso) {
+    EEPROM_Callback_t cb = s_fsm.atual.callback;
+    void* ctx = s_fsm.atual.ctx;
+
+    // A flag global  s das requisies sem callback (Write_Async_Start do gerenciador);
+    // quem tem callback recebe o resultado nele e no pode derrubar a FSM de configurao
+    if (!sucesso && cb == NULL) {
+        s_fsm.error_flag = true;
+    }
+    s_fsm.state = sucesso ? FSM_FINISHED : FSM_ERROR;
+
+    if (cb != NULL) {
+        cb(sucesso, ctx);
+    }
 }
 
 // ============================================================
@@ -78,6 +222,7 @@ void EEPROM_Driver_Init(I2C_HandleTypeDef *hi2c) {
     s_fsm.i2c_handle = hi2c;
     s_fsm.state = FSM_IDLE;
     s_fsm.error_flag = false;
+    memset(&s_fila, 0, sizeof(s_fila));
 }
 
 // Verifica se a EEPROM est presente e pronta (ACK) no barramento I2C
@@ -86,9 +231,9 @@ bool EEPROM_Driver_IsReady(void) {
         return false;
     }
 
-    if (HAL_I2C_IsDeviceReady(s_fsm.i2c_handle, EEPROM_I2C_ADDR, 2, 100) != HAL_OK) {
+    if (I2C_Bus_Probe_Blocking(EEPROM_I2C_ADDR, 100) != HAL_OK) {
         EEPROM_Driver_ResetPeripheral();
-        return (HAL_I2C_IsDeviceReady(s_fsm.i2c_handle, EEPROM_I2C_ADDR, 2, 100) == HAL_OK);
+        return (I2C_Bus_Probe_Blocking(EEPROM_I2C_ADDR, 100) == HAL_OK);
     }
     return true;
 }
@@ -103,9 +248,9 @@ bool EEPROM_Driver_Read_Blocking(uint16_t addr, uint8_t *data, uint16_t size) {
         return false;
     }
 
-    if (HAL_I2C_Mem_Read(s_fsm.i2c_handle, EEPROM_I2C_ADDR, addr, I2C_MEMADD_SIZE_16BIT, data, size, 1000) != HAL_OK) {
+    if (I2C_Bus_Mem_Read_Blocking(EEPROM_I2C_ADDR, addr, I2C_MEMADD_SIZE_16BIT, data, size, 1000) != HAL_OK) {
         EEPROM_Driver_ResetPeripheral();
-        return (HAL_I2C_Mem_Read(s_fsm.i2c_handle, EEPROM_I2C_ADDR, addr, I2C_MEMADD_SIZE_16BIT, data, size, 1000) == HAL_OK);
+        return (I2C_Bus_Mem_Read_Blocking(EEPROM_I2C_ADDR, addr, I2C_MEMADD_SIZE_16BIT, data, size, 1000) == HAL_OK);
     }
     return true;
 }
@@ -117,7 +262,7 @@ bool EEPROM_Driver_Write_Blocking(uint16_t addr, const uint8_t *data, uint16_t s
     }
 
     const uint8_t  max_retries  = 3;
-    const uint32_t timeout_ms   = 1000;
+    const uint16_t timeout_ms   = 1000;
     const uint16_t page_size    = EEPROM_PAGE_SIZE;
 
     uint16_t bytes_written = 0;
@@ -132,12 +277,12 @@ bool EEPROM_Driver_Write_Blocking(uint16_t addr, const uint8_t *data, uint16_t s
 
         bool success = false;
         for (uint8_t retry = 0; retry < max_retries; retry++) {
-            if (HAL_I2C_IsDeviceReady(s_fsm.i2c_handle, EEPROM_I2C_ADDR, 2, 100) != HAL_OK) {
+            if (I2C_Bus_Probe_Blocking(EEPROM_I2C_ADDR, 100) != HAL_OK) {
                 HAL_Delay(5);
                 continue;
             }
 
-            if (HAL_I2C_Mem_Write(s_fsm.i2c_handle, EEPROM_I2C_ADDR, addr, I2C_MEMADD_SIZE_16BIT, (uint8_t*)(data + bytes_written), bytes_to_write_now, timeout_ms) == HAL_OK) {
+            if (I2C_Bus_Mem_Write_Blocking(EEPROM_I2C_ADDR, addr, I2C_MEMADD_SIZE_16BIT, data + bytes_written, bytes_to_write_now, timeout_ms) == HAL_OK) {
                 success = true;
                 break;
             }
@@ -153,7 +298,14 @@ bool EEPROM_Driver_Write_Blocking(uint16_t addr, const uint8_t *data, uint16_t s
         bytes_written += bytes_to_write_now;
         addr += bytes_to_write_now;
 
-        while(HAL_I2C_IsDeviceReady(s_fsm.i2c_handle, EEPROM_I2C_ADDR, 5, 100) != HAL_OK);
+        // ACK polling com limite: aguarda o fim do ciclo interno de escrita
+        uint32_t poll_start = HAL_GetTick();
+        while (I2C_Bus_Probe_Blocking(EEPROM_I2C_ADDR, 10) != HAL_OK) {
+            if (HAL_GetTick() - poll_start > EEPROM_ACK_POLL_MS) {
+                printf("EEPROM Write ERROR: Timeout no ACK polling (0x%04X)\r\n", addr);
+                return false;
+            }
+        }
     }
 
     return true;
@@ -163,62 +315,76 @@ bool EEPROM_Driver_Write_Blocking(uint16_t addr, const uint8_t *data, uint16_t s
 // API Pblica - Funes Assncronas (FSM)
 // ============================================================
 
-// Verifica se a mquina de estados (FSM) de escrita est ocupada
+// Verifica se h requisio em andamento ou pendente na fila
 bool EEPROM_Driver_IsBusy(void) {
     EepromFsmState_t current_state = s_fsm.state;
-    return (current_state != FSM_IDLE &&
-            current_state != FSM_FINISHED &&
-            current_state != FSM_ERROR);
+    return (s_fila.count > 0 ||
+            (current_state != FSM_IDLE &&
+             current_state != FSM_FINISHED &&
+             current_state != FSM_ERROR));
 }
 
-// Inicia uma operao de escrita assncrona
-bool EEPROM_Driver_Write_Async_Start(uint16_t addr, const uint8_t *data, uint16_t size) {
-    if (EEPROM_Driver_IsBusy() || data == NULL || size == 0) {
-        return false;
-    }
+// Enfileira uma leitura assncrona (sequencial, atravessa pginas numa nica transao)
+bool EEPROM_Driver_Read_Async(uint16_t addr, uint8_t *data, uint16_t size, EEPROM_Callback_t cb, void *ctx) {
+    return EEPROM_Driver_Enfileirar(EEPROM_OP_READ, addr, data, size, cb, ctx);
+}
 
-    s_fsm.current_addr = addr;
-    s_fsm.p_data = data;
-    s_fsm.bytes_remaining = size;
-    s_fsm.error_flag = false;
-    s_fsm.state = FSM_WRITE_CHUNK;
-    return true;
+// Enfileira uma escrita assncrona (dividida em pginas pela FSM)
+bool EEPROM_Driver_Write_Async(uint16_t addr, const uint8_t *data, uint16_t size, EEPROM_Callback_t cb, void *ctx) {
+    return EEPROM_Driver_Enfileirar(EEPROM_OP_WRITE, addr, (uint8_t*)data, size, cb, ctx);
 }
 
-// Processa a mquina de estados (FSM) de escrita assncrona
+// Inicia uma operao de escrita assncrona (sem callback, status via IsBusy/flag de erro)
+bool EEPROM_Driver_Write_Async_Start(uint16_t addr, const uint8_t *data, uint16_t size) {
+    return EEPROM_Driver_Write_Async(addr, data, size, NULL, NULL);
+}
+
+// Processa a mquina de estados (FSM) das requisies assncronas
 void EEPROM_Driver_FSM_Process(void) {
+    EepromFsmState_t current_state = s_fsm.state;
+
+    // Sem requisio em andamento: retira a prxima da fila
+    if (current_state == FSM_IDLE || current_state == FSM_FINISHED || current_state == FSM_ERROR) {
+        if (!EEPROM_Driver_Iniciar_Proxima()) {
+            return;
+        }
+    }
+
     switch (s_fsm.state) {
+        case FSM_READ:
+            // Leitura sequencial: a EEPROM incrementa o endereo internamente,
+            // ento o bloco inteiro  lido numa nica transao (o HAL usa RELOAD acima de 255 bytes).
+            // O estado muda antes do submit pois a concluso pode chegar pela ISR imediatamente.
+            s_fsm.state = FSM_WAIT_I2C_IT;
+            if (!EEPROM_Driver_Submeter(I2C_BUS_OP_READ, s_fsm.current_addr, s_fsm.p_data, s_fsm.bytes_remaining)) {
+                // Fila do barramento cheia: tenta novamente no prximo ciclo
+                s_fsm.state = FSM_READ;
+            }
+            break;
+
         case FSM_WRITE_CHUNK:
             if (s_fsm.bytes_remaining == 0) {
-                s_fsm.state = FSM_FINISHED;
+                EEPROM_Driver_Finalizar_Requisicao(true);
                 break;
             }
+            EEPROM_Driver_Escrever_Pagina();
+            break;
 
-            uint16_t chunk_size = EEPROM_PAGE_SIZE - (s_fsm.current_addr % EEPROM_PAGE_SIZE);
-
-            if (chunk_size > s_fsm.bytes_remaining) {
-                chunk_size = s_fsm.bytes_remaining;
-            }
-
-            // Inicia a escrita I2C usando Interrupo (IT)
-            if (HAL_I2C_Mem_Write_IT(s_fsm.i2c_handle, EEPROM_I2C_ADDR, s_fsm.current_addr, I2C_MEMADD_SIZE_16BIT, (uint8_t*)s_fsm.p_data, chunk_size) != HAL_OK) {
-                s_fsm.error_flag = true;
-                s_fsm.state = FSM_ERROR;
-            } else {
-                s_fsm.p_data += chunk_size;
-                s_fsm.bytes_remaining -= chunk_size;
-                s_fsm.current_addr += chunk_size;
-                s_fsm.state = FSM_WAIT_I2C_IT;
-            }
+        case FSM_ACK_POLL:
+            EEPROM_Driver_Sondar_ACK();
             break;
 
         case FSM_WAIT_I2C_IT:
+        case FSM_WAIT_ACK_POLL:
+            // Pginas seguintes so encadeadas diretamente pelo callback do barramento
             break;
 
-        case FSM_WAIT_PAGE_WRITE_DELAY:
-            if (HAL_GetTick() - s_fsm.delay_start_tick >= EEPROM_WRITE_TIME_MS) {
-                s_fsm.state = FSM_WRITE_CHUNK;
-            }
+        case FSM_REQUEST_DONE:
+            EEPROM_Driver_Finalizar_Requisicao(true);
+            break;
+
+        case FSM_REQUEST_FAILED:
+            EEPROM_Driver_Finalizar_Requisicao(false);
             break;
 
         case FSM_IDLE:
@@ -229,7 +395,7 @@ void EEPROM_Driver_FSM_Process(void) {
     }
 }
 
-// Obtm o status de erro da FSM e limpa a flag
+// Obtm o erro das requisies sem callback e limpa a flag
 bool EEPROM_Driver_GetAndClearErrorFlag(void) {
     if (s_fsm.error_flag) {
         s_fsm.error_flag = false;
@@ -239,22 +405,29 @@ bool EEPROM_Driver_GetAndClearErrorFlag(void) {
 }
 
 // ============================================================
-// Callbacks do HAL I2C (Contexto de ISR)
+// Callback do Gerenciador do Barramento (Contexto de ISR)
 // ============================================================
 
-// Callback chamado pelo HAL ao concluir uma transmisso I2C
-void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) {
-    if (hi2c->Instance == s_fsm.i2c_handle->Instance && s_fsm.state == FSM_WAIT_I2C_IT) {
-        s_fsm.delay_start_tick = HAL_GetTick();
-        s_fsm.state = FSM_WAIT_PAGE_WRITE_DELAY;
+// Chamado pelo i2c_bus_manager ao concluir uma transao da FSM.
+// Escrita: pgina transferida -> sonda de ACK -> ACK recebido -> prxima pgina (sem esperar o Process).
+static void EEPROM_Driver_Bus_Callback(bool sucesso, void *ctx) {
+    (void)ctx;
+    EepromFsmState_t estado = s_fsm.state;
+
+    if (estado != FSM_WAIT_I2C_IT && estado != FSM_WAIT_ACK_POLL) {
+        return;
     }
-}
 
-// Callback chamado pelo HAL ao ocorrer um erro no barramento I2C
-void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
-    if (hi2c->Instance == s_fsm.i2c_handle->Instance) {
-        printf("EEPROM Driver: HAL_I2C_ErrorCallback acionado! Erro: 0x%lX\r\n", (unsigned long)hi2c->ErrorCode);
-        s_fsm.error_flag = true;
-        s_fsm.state = FSM_ERROR;
+    if (!sucesso) {
+        s_fsm.state = FSM_REQUEST_FAILED;
+    } else if (s_fsm.atual.op == EEPROM_OP_READ) {
+        s_fsm.state = FSM_REQUEST_DONE;
+    } else if (estado == FSM_WAIT_I2C_IT) {
+        // Pgina enviada: a EEPROM entrou no ciclo interno de escrita
+        EEPROM_Driver_Sondar_ACK();
+    } else if (s_fsm.bytes_remaining == 0) {
+        s_fsm.state = FSM_REQUEST_DONE;
+    } else {
+        EEPROM_Driver_Escrever_Pagina();
     }
-}
\ No newline at end of file
+}
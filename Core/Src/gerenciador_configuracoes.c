@@ -10,6 +10,7 @@
 
 #include "gerenciador_configuracoes.h"
 #include "eeprom_driver.h"
+#include "crc_service.h"
 #include "GXXX_Equacoes.h"
 #include "retarget.h"
 #include <string.h>
@@ -20,20 +21,51 @@
 // Typedefs e Enums
 // ============================================================
 
-// Estados da FSM de gerenciamento de salvamento
+// Estados da FSM de gerenciamento de salvamento (commit A/B)
 typedef enum {
     MGR_FSM_IDLE,
     MGR_FSM_START_SAVE,
-    MGR_FSM_WRITE_PRIMARY,
-    MGR_FSM_WAIT_PRIMARY_DONE,
-    MGR_FSM_WRITE_BACKUP1,
-    MGR_FSM_WAIT_BACKUP1_DONE,
-    MGR_FSM_WRITE_BACKUP2,
-    MGR_FSM_WAIT_BACKUP2_DONE,
+    MGR_FSM_WRITE_IMAGE,
+    MGR_FSM_WAIT_IMAGE_DONE,
+    MGR_FSM_WRITE_COMMIT,
+    MGR_FSM_WAIT_COMMIT_DONE,
     MGR_FSM_FINISH,
-    MGR_FSM_ERROR
+    MGR_FSM_ERROR,
+    MGR_FSM_BACKOFF,
+    MGR_FSM_WRITE_BATERIA,
+    MGR_FSM_WAIT_BATERIA_DONE,
+    MGR_FSM_ERRO_BATERIA,
+    MGR_FSM_WRITE_SEQUENCIAS,
+    MGR_FSM_WAIT_SEQUENCIAS_DONE,
+    MGR_FSM_ERRO_SEQUENCIAS
 } GerenciadorFsmState_t;
 
+// Marcador de commit: gravado por ltimo, logo aps a imagem do slot.
+// S  vlido se a imagem foi gravada por completo antes dele.
+typedef struct {
+    uint32_t magic;
+    uint32_t sequencia;     // Monotnica: o slot com maior sequncia  o atual
+    uint32_t crc_imagem;    // Deve coincidir com Config_Aplicacao_t.crc
+    uint32_t crc_marcador;  // CRC dos 12 bytes anteriores
+} Config_Marcador_t;
+
+// ============================================================
+// Definies e Constantes Privadas
+// ============================================================
+
+#define CONFIG_MARCADOR_MAGIC     0xC0FF1A7BUL
+#define MGR_MAX_TENTATIVAS        3
+#define MGR_BACKOFF_MS            5000
+#define SLOT_NENHUM               0xFF
+#define BATERIA_VERSAO            2   // 2: campos inteiros em uAh
+#define SEQUENCIAS_VERSAO         2   // 2: trims dos servos
+
+// O registro da bateria precisa caber na sua posio do anel
+typedef char Config_Bateria_Cabe_No_Registro[(sizeof(Config_Bateria_t) <= BATERIA_REGISTRO_SIZE) ? 1 : -1];
+
+// id_sequencia usa o preenchimento de Config_Grao_t: imagens j gravadas continuam vlidas
+typedef char Config_Grao_Layout_Inalterado[(offsetof(Config_Grao_t, id_curva) == 32 && sizeof(Config_Grao_t) == 40) ? 1 : -1];
+
 // ============================================================
 // Variveis Estticas
 // ============================================================
@@ -43,6 +75,29 @@ static Config_Aplicacao_t      s_config_cache;
 static volatile bool           s_config_dirty   = false;
 static GerenciadorFsmState_t   s_mgr_state      = MGR_FSM_IDLE;
 static volatile bool           s_mgr_error_flag = false;
+static bool                    s_crc_legado     = false;
+
+// Estado do commit A/B
+static uint8_t                 s_slot_ativo     = SLOT_NENHUM;  // 0 = A, 1 = B
+static uint32_t                s_sequencia      = 0;
+static uint8_t                 s_slot_destino   = 0;
+static Config_Marcador_t       s_marcador;                      // Buffer do commit (escrita assncrona)
+static uint8_t                 s_tentativas     = 0;
+static uint32_t                s_backoff_inicio = 0;
+
+// Anel de checkpoints da bateria
+static Config_Bateria_t        s_bateria_cache;
+static Config_Bateria_t        s_bateria_buf;                   // Buffer da escrita assncrona
+static volatile bool           s_bateria_pendente  = false;
+static bool                    s_bateria_carregada = false;
+static bool                    s_bateria_valida    = false;
+static uint8_t                 s_bateria_indice    = 0;         // Prximo registro a gravar
+static uint32_t                s_bateria_sequencia = 0;
+
+// Bloco dos servos (receitas e trims)
+static Config_Sequencias_t     s_sequencias_cache;
+static volatile bool           s_sequencias_pendente  = false;
+static bool                    s_sequencias_carregada = false;
 
 // ============================================================
 // Prottipos de Funes Privadas
@@ -50,6 +105,14 @@ static volatile bool           s_mgr_error_flag = false;
 
 static void Recalcular_E_Atualizar_CRC_Cache(void);
 static bool Tentar_Carregar_De_Endereco(uint16_t address, Config_Aplicacao_t* config);
+static uint16_t Endereco_Slot(uint8_t slot);
+static uint32_t Calcular_CRC_Marcador(const Config_Marcador_t* m);
+static bool Ler_Marcador_Slot(uint8_t slot, Config_Marcador_t* m);
+static bool Carregar_Slot(uint8_t slot, const Config_Marcador_t* m);
+static void Sanear_Config_Cache(void);
+static uint16_t Endereco_Registro_Bateria(uint8_t indice);
+static bool Carregar_Bateria(void);
+static bool Carregar_Sequencias(void);
 
 // ============================================================
 // Funes de Inicializao e Status
@@ -85,16 +148,19 @@ bool Gerenciador_Config_GetAndClearErrorFlag(void) {
 // Mquina de Estados (Salva Assncrono)
 // ============================================================
 
-// Mquina de estados NO-BLOQUEANTE para salvar configuraes
+// Mquina de estados NO-BLOQUEANTE para salvar configuraes.
+// Cada salvamento grava uma nica imagem no slot inativo e, por ltimo, o marcador
+// de commit. Uma queda de energia em qualquer ponto mantm o slot anterior vlido.
 void Gerenciador_Config_Run_FSM(void) {
     // 1. Sempre processa o driver de baixo nvel
     EEPROM_Driver_FSM_Process();
 
     // 2. Verifica se o driver de baixo nvel est ocupado (e pausa a FSM principal)
     if (EEPROM_Driver_IsBusy()) {
-        if (s_mgr_state != MGR_FSM_WAIT_PRIMARY_DONE &&
-            s_mgr_state != MGR_FSM_WAIT_BACKUP1_DONE &&
-            s_mgr_state != MGR_FSM_WAIT_BACKUP2_DONE) {
+        if (s_mgr_state != MGR_FSM_WAIT_IMAGE_DONE &&
+            s_mgr_state != MGR_FSM_WAIT_COMMIT_DONE &&
+            s_mgr_state != MGR_FSM_WAIT_BATERIA_DONE &&
+            s_mgr_state != MGR_FSM_WAIT_SEQUENCIAS_DONE) {
             return;
         }
     }
@@ -102,83 +168,165 @@ void Gerenciador_Config_Run_FSM(void) {
     // 3. Verifica se o driver de baixo nvel relatou um erro
     if (EEPROM_Driver_GetAndClearErrorFlag()) {
         printf("FSM Gerenciador: ERRO detectado no eeprom_driver!\r\n");
-        s_mgr_state = MGR_FSM_ERROR;
+        if (s_mgr_state == MGR_FSM_WAIT_BATERIA_DONE) {
+            s_mgr_state = MGR_FSM_ERRO_BATERIA;
+        } else if (s_mgr_state == MGR_FSM_WAIT_SEQUENCIAS_DONE) {
+            s_mgr_state = MGR_FSM_ERRO_SEQUENCIAS;
+        } else {
+            s_mgr_state = MGR_FSM_ERROR;
+        }
     }
 
     // 4. Processa a FSM de alto nvel
     switch (s_mgr_state) {
         case MGR_FSM_IDLE:
             if (s_config_dirty) {
+                s_tentativas = 0;
                 s_mgr_state = MGR_FSM_START_SAVE;
+            } else if (s_bateria_pendente) {
+                s_mgr_state = MGR_FSM_WRITE_BATERIA;
+            } else if (s_sequencias_pendente) {
+                s_mgr_state = MGR_FSM_WRITE_SEQUENCIAS;
             }
             break;
 
         case MGR_FSM_START_SAVE:
             printf("FSM Gerenciador: Iniciando salvamento assincrono...\r\n");
+            // Limpa antes de gravar: alteraes feitas durante a gravao geram novo salvamento
+            s_config_dirty = false;
             Recalcular_E_Atualizar_CRC_Cache();
+            s_slot_destino = (s_slot_ativo == 0) ? 1 : 0;
             s_mgr_error_flag = false;
-            s_mgr_state = MGR_FSM_WRITE_PRIMARY;
+            s_mgr_state = MGR_FSM_WRITE_IMAGE;
             break;
 
-        // --- Bloco Primrio ---
-        case MGR_FSM_WRITE_PRIMARY:
-            printf("FSM Gerenciador: Escrevendo bloco primario...\r\n");
-            if (EEPROM_Driver_Write_Async_Start(ADDR_CONFIG_PRIMARY, (const uint8_t*)&s_config_cache, sizeof(Config_Aplicacao_t))) {
-                s_mgr_state = MGR_FSM_WAIT_PRIMARY_DONE;
+        // --- Imagem no slot inativo ---
+        case MGR_FSM_WRITE_IMAGE:
+            printf("FSM Gerenciador: Escrevendo slot %c...\r\n", (s_slot_destino == 0) ? 'A' : 'B');
+            if (EEPROM_Driver_Write_Async_Start(Endereco_Slot(s_slot_destino), (const uint8_t*)&s_config_cache, sizeof(Config_Aplicacao_t))) {
+                s_mgr_state = MGR_FSM_WAIT_IMAGE_DONE;
             } else {
                 s_mgr_state = MGR_FSM_ERROR;
             }
             break;
 
-        case MGR_FSM_WAIT_PRIMARY_DONE:
+        case MGR_FSM_WAIT_IMAGE_DONE:
             if (!EEPROM_Driver_IsBusy()) {
-                s_mgr_state = MGR_FSM_WRITE_BACKUP1;
+                s_mgr_state = MGR_FSM_WRITE_COMMIT;
             }
             break;
 
-        // --- Bloco Backup 1 ---
-        case MGR_FSM_WRITE_BACKUP1:
-            printf("FSM Gerenciador: Escrevendo backup 1...\r\n");
-            if (EEPROM_Driver_Write_Async_Start(ADDR_CONFIG_BACKUP1, (const uint8_t*)&s_config_cache, sizeof(Config_Aplicacao_t))) {
-                s_mgr_state = MGR_FSM_WAIT_BACKUP1_DONE;
+        // --- Marcador de commit (gravado por ltimo) ---
+        case MGR_FSM_WRITE_COMMIT:
+            // O cache mudou durante a gravao: a imagem gravada no confere com o CRC, regrava
+            if (CRC_Service_Calcular(CRC_SERVICE_CRC32, &s_config_cache, offsetof(Config_Aplicacao_t, crc)) != s_config_cache.crc) {
+                s_mgr_state = MGR_FSM_START_SAVE;
+                break;
+            }
+            s_marcador.magic        = CONFIG_MARCADOR_MAGIC;
+            s_marcador.sequencia    = s_sequencia + 1;
+            s_marcador.crc_imagem   = s_config_cache.crc;
+            s_marcador.crc_marcador = Calcular_CRC_Marcador(&s_marcador);
+            if (EEPROM_Driver_Write_Async_Start(Endereco_Slot(s_slot_destino) + CONFIG_BLOCK_SIZE, (const uint8_t*)&s_marcador, sizeof(Config_Marcador_t))) {
+                s_mgr_state = MGR_FSM_WAIT_COMMIT_DONE;
             } else {
                 s_mgr_state = MGR_FSM_ERROR;
             }
             break;
 
-        case MGR_FSM_WAIT_BACKUP1_DONE:
+        case MGR_FSM_WAIT_COMMIT_DONE:
             if (!EEPROM_Driver_IsBusy()) {
-                s_mgr_state = MGR_FSM_WRITE_BACKUP2;
+                s_mgr_state = MGR_FSM_FINISH;
+            }
+            break;
+
+        // --- Concluso ---
+        case MGR_FSM_FINISH:
+            s_slot_ativo = s_slot_destino;
+            s_sequencia  = s_marcador.sequencia;
+            printf("FSM Gerenciador: Salvamento concluido (slot %c, seq %lu).\r\n",
+                   (s_slot_ativo == 0) ? 'A' : 'B', (unsigned long)s_sequencia);
+            s_mgr_state = MGR_FSM_IDLE;
+            break;
+
+        case MGR_FSM_ERROR:
+            s_config_dirty = true;
+            if (++s_tentativas < MGR_MAX_TENTATIVAS) {
+                printf("FSM Gerenciador: Erro. Nova tentativa (%u/%u).\r\n", s_tentativas + 1, MGR_MAX_TENTATIVAS);
+                s_mgr_state = MGR_FSM_START_SAVE;
+            } else {
+                printf("FSM Gerenciador: Erro persistente. Aguardando para tentar novamente.\r\n");
+                s_mgr_error_flag = true;
+                s_backoff_inicio = HAL_GetTick();
+                s_mgr_state = MGR_FSM_BACKOFF;
             }
             break;
 
-        // --- Bloco Backup 2 ---
-        case MGR_FSM_WRITE_BACKUP2:
-            printf("FSM Gerenciador: Escrevendo backup 2...\r\n");
-            if (EEPROM_Driver_Write_Async_Start(ADDR_CONFIG_BACKUP2, (const uint8_t*)&s_config_cache, sizeof(Config_Aplicacao_t))) {
-                s_mgr_state = MGR_FSM_WAIT_BACKUP2_DONE;
+        case MGR_FSM_BACKOFF:
+            if (HAL_GetTick() - s_backoff_inicio >= MGR_BACKOFF_MS) {
+                s_mgr_state = MGR_FSM_IDLE;
+            }
+            break;
+
+        // --- Checkpoint da bateria (um registro do anel, sem commit A/B) ---
+        case MGR_FSM_WRITE_BATERIA:
+            // Sem o anel lido o ndice de gravao  desconhecido: nada  gravado
+            if (!s_bateria_carregada && !Carregar_Bateria()) {
+                s_mgr_state = MGR_FSM_ERRO_BATERIA;
+                break;
+            }
+            // Limpa antes de gravar: um Set durante a gravao gera novo checkpoint
+            s_bateria_pendente = false;
+            s_bateria_buf = s_bateria_cache;
+            s_bateria_buf.sequencia = s_bateria_sequencia + 1;
+            s_bateria_buf.versao = BATERIA_VERSAO;
+            s_bateria_buf.crc = CRC_Service_Calcular(CRC_SERVICE_CRC32, &s_bateria_buf, offsetof(Config_Bateria_t, crc));
+            if (EEPROM_Driver_Write_Async_Start(Endereco_Registro_Bateria(s_bateria_indice), (const uint8_t*)&s_bateria_buf, sizeof(Config_Bateria_t))) {
+                s_mgr_state = MGR_FSM_WAIT_BATERIA_DONE;
             } else {
-                s_mgr_state = MGR_FSM_ERROR;
+                s_mgr_state = MGR_FSM_ERRO_BATERIA;
             }
             break;
 
-        case MGR_FSM_WAIT_BACKUP2_DONE:
+        case MGR_FSM_WAIT_BATERIA_DONE:
             if (!EEPROM_Driver_IsBusy()) {
-                s_mgr_state = MGR_FSM_FINISH;
+                s_bateria_sequencia = s_bateria_buf.sequencia;
+                s_bateria_indice = (uint8_t)((s_bateria_indice + 1) % BATERIA_NUM_REGISTROS);
+                s_mgr_state = MGR_FSM_IDLE;
             }
             break;
 
-        // --- Concluso ---
-        case MGR_FSM_FINISH:
-            printf("FSM Gerenciador: Salvamento assincrono concluido.\r\n");
-            s_config_dirty = false;
-            s_mgr_state = MGR_FSM_IDLE;
+        case MGR_FSM_ERRO_BATERIA:
+            // O registro anterior continua vlido; tenta o mesmo ndice aps o backoff
+            s_bateria_pendente = true;
+            s_backoff_inicio = HAL_GetTick();
+            s_mgr_state = MGR_FSM_BACKOFF;
             break;
 
-        case MGR_FSM_ERROR:
-            printf("FSM Gerenciador: Erro. Abortando e tentando mais tarde.\r\n");
-            s_mgr_error_flag = true;
-            s_mgr_state = MGR_FSM_IDLE;
+        // --- Bloco dos servos (receitas e trims) ---
+        case MGR_FSM_WRITE_SEQUENCIAS:
+            // Um Set durante a gravao marca de novo e o bloco  regravado com o CRC novo
+            s_sequencias_pendente = false;
+            s_sequencias_cache.versao = SEQUENCIAS_VERSAO;
+            s_sequencias_cache.crc = CRC_Service_Calcular(CRC_SERVICE_CRC32, &s_sequencias_cache, offsetof(Config_Sequencias_t, crc));
+            if (EEPROM_Driver_Write_Async_Start(ADDR_SEQUENCIAS_INICIO, (const uint8_t*)&s_sequencias_cache, sizeof(Config_Sequencias_t))) {
+                s_mgr_state = MGR_FSM_WAIT_SEQUENCIAS_DONE;
+            } else {
+                s_mgr_state = MGR_FSM_ERRO_SEQUENCIAS;
+            }
+            break;
+
+        case MGR_FSM_WAIT_SEQUENCIAS_DONE:
+            if (!EEPROM_Driver_IsBusy()) {
+                printf("FSM Gerenciador: Receitas e trims dos servos salvos.\r\n");
+                s_mgr_state = MGR_FSM_IDLE;
+            }
+            break;
+
+        case MGR_FSM_ERRO_SEQUENCIAS:
+            s_sequencias_pendente = true;
+            s_backoff_inicio = HAL_GetTick();
+            s_mgr_state = MGR_FSM_BACKOFF;
             break;
     }
 }
@@ -187,18 +335,43 @@ void Gerenciador_Config_Run_FSM(void) {
 // Funes de Load e Default
 // ============================================================
 
-// Valida as cpias na EEPROM e carrega a configurao vlida para o cache
+// Valida os slots A/B na EEPROM e carrega a configurao mais recente para o cache.
+// L apenas os dois marcadores e a imagem escolhida; o layout legado  lido s na migrao.
 bool Gerenciador_Config_Validar_e_Restaurar(void) {
     if (s_crc_handle == NULL) return false;
 
-    if (Tentar_Carregar_De_Endereco(ADDR_CONFIG_PRIMARY, &s_config_cache)) {
-        return true;
+    Config_Marcador_t marcador[2];
+    bool valido[2];
+    valido[0] = Ler_Marcador_Slot(0, &marcador[0]);
+    valido[1] = Ler_Marcador_Slot(1, &marcador[1]);
+
+    // Ordena: o slot com maior sequncia (comparao com wrap-around)  tentado primeiro
+    uint8_t primeiro = 0;
+    if (valido[1] && (!valido[0] || (int32_t)(marcador[1].sequencia - marcador[0].sequencia) > 0)) {
+        primeiro = 1;
     }
-    if (Tentar_Carregar_De_Endereco(ADDR_CONFIG_BACKUP1, &s_config_cache)) {
-        Gerenciador_Config_Marcar_Como_Pendente();
-        return true;
+
+    for (uint8_t n = 0; n < 2; n++) {
+        uint8_t slot = (n == 0) ? primeiro : (uint8_t)(1 - primeiro);
+        if (valido[slot] && Carregar_Slot(slot, &marcador[slot])) {
+            s_slot_ativo = slot;
+            // Mantm a sequncia mais alta j vista, mesmo que o slot mais novo estivesse corrompido
+            s_sequencia = marcador[primeiro].sequencia;
+            if (n > 0) {
+                printf("EEPROM Check: Slot mais recente invalido, usando slot %c\r\n", (slot == 0) ? 'A' : 'B');
+            }
+            Sanear_Config_Cache();
+            return true;
+        }
     }
-    if (Tentar_Carregar_De_Endereco(ADDR_CONFIG_BACKUP2, &s_config_cache)) {
+
+    // Migrao do layout antigo (cpia tripla)
+    s_crc_legado = false;
+    if (Tentar_Carregar_De_Endereco(ADDR_CONFIG_PRIMARY, &s_config_cache) ||
+        Tentar_Carregar_De_Endereco(ADDR_CONFIG_BACKUP1, &s_config_cache) ||
+        Tentar_Carregar_De_Endereco(ADDR_CONFIG_BACKUP2, &s_config_cache)) {
+        printf("EEPROM Check: Configuracao legada encontrada, migrando para slots A/B\r\n");
+        Sanear_Config_Cache();
         Gerenciador_Config_Marcar_Como_Pendente();
         return true;
     }
@@ -273,6 +446,7 @@ bool Gerenciador_Config_Set_NR_Repetitions(uint16_t nr_repetitions) {
 }
 
 bool Gerenciador_Config_Set_NR_Decimals(uint16_t nr_decimals) {
+    if (nr_decimals > MAX_NR_DECIMALS) return false;
     s_config_cache.nr_decimals = nr_decimals;
     Gerenciador_Config_Marcar_Como_Pendente();
     return true;
@@ -327,6 +501,13 @@ bool Gerenciador_Config_Get_Senha(char* buffer, uint8_t tamanho_buffer) {
 
 uint8_t Gerenciador_Config_Get_Num_Graos(void) { return MAX_GRAOS; }
 
+bool Gerenciador_Config_Set_Sequencia_Grao(uint8_t indice, uint8_t id_receita) {
+    if (indice >= MAX_GRAOS || id_receita >= SEQ_NUM_RECEITAS) return false;
+    s_config_cache.graos[indice].id_sequencia = id_receita;
+    Gerenciador_Config_Marcar_Como_Pendente();
+    return true;
+}
+
 bool Gerenciador_Config_Get_Grao_Ativo(uint8_t* indice_ativo) {
     if (indice_ativo == NULL) return false;
     *indice_ativo = (s_config_cache.indice_grao_ativo < MAX_GRAOS) ? s_config_cache.indice_grao_ativo : 0;
@@ -365,6 +546,71 @@ bool Gerenciador_Config_Get_Serial(char* serial, uint8_t tamanho_buffer) {
     return true;
 }
 
+// ============================================================
+// Estado da Bateria (Anel de Checkpoints)
+// ============================================================
+
+bool Gerenciador_Config_Set_Bateria(const Config_Bateria_t* dados) {
+    if (dados == NULL) return false;
+    if (!s_bateria_carregada) {
+        (void)Carregar_Bateria(); // Posiciona o anel; se a leitura falhar, o checkpoint tenta de novo
+    }
+    s_bateria_cache = *dados;
+    s_bateria_valida = true;
+    s_bateria_pendente = true;
+    return true;
+}
+
+bool Gerenciador_Config_Get_Bateria(Config_Bateria_t* dados) {
+    if (dados == NULL) return false;
+    if (!s_bateria_carregada) {
+        (void)Carregar_Bateria();
+    }
+    if (!s_bateria_valida) return false;
+    *dados = s_bateria_cache;
+    return true;
+}
+
+// ============================================================
+// Receitas de Sequncia e Trims dos Servos
+// ============================================================
+
+bool Gerenciador_Config_Set_Receita_Servo(uint8_t id, const Config_Receita_Servo_t* receita) {
+    if (receita == NULL || id >= SEQ_NUM_RECEITAS || receita->num_passos > SEQ_MAX_PASSOS) return false;
+    // Sem o bloco lido, gravar apagaria as outras receitas e os trims da EEPROM
+    if (!s_sequencias_carregada && !Carregar_Sequencias()) return false;
+    s_sequencias_cache.receitas[id] = *receita;
+    s_sequencias_pendente = true;
+    return true;
+}
+
+bool Gerenciador_Config_Get_Receita_Servo(uint8_t id, Config_Receita_Servo_t* receita) {
+    if (receita == NULL || id >= SEQ_NUM_RECEITAS) return false;
+    if (!s_sequencias_carregada && !Carregar_Sequencias()) return false;
+    const Config_Receita_Servo_t* r = &s_sequencias_cache.receitas[id];
+    if (r->num_passos == 0 || r->num_passos > SEQ_MAX_PASSOS) return false;
+    *receita = *r;
+    return true;
+}
+
+bool Gerenciador_Config_Set_Trim_Servo(uint8_t id, const Config_Trim_Servo_t* trim) {
+    if (trim == NULL || id >= CONFIG_NUM_SERVOS) return false;
+    if (!s_sequencias_carregada && !Carregar_Sequencias()) return false;
+    s_sequencias_cache.trims[id] = *trim;
+    s_sequencias_pendente = true;
+    return true;
+}
+
+bool Gerenciador_Config_Get_Trim_Servo(uint8_t id, Config_Trim_Servo_t* trim) {
+    if (trim == NULL || id >= CONFIG_NUM_SERVOS) return false;
+    if (!s_sequencias_carregada && !Carregar_Sequencias()) {
+        memset(trim, 0, sizeof(Config_Trim_Servo_t)); // Padro at uma leitura dar certo
+        return true;
+    }
+    *trim = s_sequencias_cache.trims[id];
+    return true;
+}
+
 // ============================================================
 // Funes Privadas
 // ============================================================
@@ -374,8 +620,103 @@ static void Recalcular_E_Atualizar_CRC_Cache(void) {
     if (s_crc_handle == NULL) return;
     // O clculo do CRC  feito sobre todos os dados da struct EXCETO o campo do prprio CRC
     uint32_t tamanho_dados_crc = offsetof(Config_Aplicacao_t, crc);
-    uint32_t novo_crc = HAL_CRC_Calculate(s_crc_handle, (uint32_t*)&s_config_cache, tamanho_dados_crc / 4);
-    s_config_cache.crc = novo_crc;
+    s_config_cache.crc = CRC_Service_Calcular(CRC_SERVICE_CRC32, &s_config_cache, tamanho_dados_crc);
+}
+
+// Endereo inicial de um slot (0 = A, 1 = B)
+static uint16_t Endereco_Slot(uint8_t slot) {
+    return (slot == 0) ? ADDR_CONFIG_SLOT_A : ADDR_CONFIG_SLOT_B;
+}
+
+// CRC do marcador (todos os campos exceto o prprio crc_marcador)
+static uint32_t Calcular_CRC_Marcador(const Config_Marcador_t* m) {
+    return CRC_Service_Calcular(CRC_SERVICE_CRC32, m, offsetof(Config_Marcador_t, crc_marcador));
+}
+
+// L e valida apenas o marcador de commit de um slot
+static bool Ler_Marcador_Slot(uint8_t slot, Config_Marcador_t* m) {
+    if (!EEPROM_Driver_Read_Blocking(Endereco_Slot(slot) + CONFIG_BLOCK_SIZE, (uint8_t*)m, sizeof(Config_Marcador_t))) {
+        return false;
+    }
+    return (m->magic == CONFIG_MARCADOR_MAGIC && m->crc_marcador == Calcular_CRC_Marcador(m));
+}
+
+// Carrega a imagem de um slot j com marcador vlido e confere com o commit
+static bool Carregar_Slot(uint8_t slot, const Config_Marcador_t* m) {
+    s_crc_legado = false;
+    if (!Tentar_Carregar_De_Endereco(Endereco_Slot(slot), &s_config_cache)) {
+        return false;
+    }
+    return (!s_crc_legado && s_config_cache.crc == m->crc_imagem);
+}
+
+// Campos gravados antes dos limites atuais voltam ao padro de fbrica
+static void Sanear_Config_Cache(void) {
+    if (s_config_cache.nr_decimals > MAX_NR_DECIMALS) {
+        printf("EEPROM Check: NR_Decimals %u fora do limite, usando 2\r\n", (unsigned)s_config_cache.nr_decimals);
+        s_config_cache.nr_decimals = 2;
+        Gerenciador_Config_Marcar_Como_Pendente();
+    }
+}
+
+// Endereo de um registro do anel da bateria
+static uint16_t Endereco_Registro_Bateria(uint8_t indice) {
+    return (uint16_t)(ADDR_BATERIA_INICIO + (indice * BATERIA_REGISTRO_SIZE));
+}
+
+// Varre o anel e carrega o registro vlido com maior sequncia; a prxima
+// gravao vai para o registro seguinte a ele. Uma falha de leitura aborta a
+// varredura (o registro ilegvel pode ser o mais novo) e o anel segue no
+// carregado at a prxima tentativa
+static bool Carregar_Bateria(void) {
+    Config_Bateria_t reg;
+    Config_Bateria_t mais_novo;
+    bool     achou     = false;
+    uint8_t  indice    = 0;
+    uint32_t sequencia = 0;
+
+    for (uint8_t i = 0; i < BATERIA_NUM_REGISTROS; i++) {
+        if (!EEPROM_Driver_Read_Blocking(Endereco_Registro_Bateria(i), (uint8_t*)&reg, sizeof(reg))) {
+            printf("EEPROM Check: Falha na leitura I2C do registro %u da bateria\r\n", (unsigned)i);
+            return false;
+        }
+        if (reg.versao != BATERIA_VERSAO ||
+            reg.crc != CRC_Service_Calcular(CRC_SERVICE_CRC32, &reg, offsetof(Config_Bateria_t, crc))) {
+            continue;
+        }
+        if (!achou || (int32_t)(reg.sequencia - sequencia) > 0) {
+            mais_novo = reg;
+            achou     = true;
+            sequencia = reg.sequencia;
+            indice    = (uint8_t)((i + 1) % BATERIA_NUM_REGISTROS);
+        }
+    }
+
+    s_bateria_carregada = true;
+    s_bateria_indice    = indice;
+    s_bateria_sequencia = sequencia;
+    // Um Set feito enquanto o anel no era lido  mais novo que qualquer registro
+    if (achou && !s_bateria_pendente) {
+        s_bateria_cache  = mais_novo;
+        s_bateria_valida = true;
+    }
+    return true;
+}
+
+// L o bloco dos servos; verso ou CRC invlidos deixam receitas vazias e trims zerados.
+// Falha de leitura no conta como carregado: o prximo acesso tenta de novo
+static bool Carregar_Sequencias(void) {
+    if (!EEPROM_Driver_Read_Blocking(ADDR_SEQUENCIAS_INICIO, (uint8_t*)&s_sequencias_cache, sizeof(Config_Sequencias_t))) {
+        printf("EEPROM Check: Falha na leitura I2C do bloco dos servos\r\n");
+        return false;
+    }
+    s_sequencias_carregada = true;
+
+    if (s_sequencias_cache.versao != SEQUENCIAS_VERSAO ||
+        s_sequencias_cache.crc != CRC_Service_Calcular(CRC_SERVICE_CRC32, &s_sequencias_cache, offsetof(Config_Sequencias_t, crc))) {
+        memset(&s_sequencias_cache, 0, sizeof(Config_Sequencias_t));
+    }
+    return true;
 }
 
 // Tenta carregar e validar uma cpia da EEPROM em um endereo especfico
@@ -387,12 +728,19 @@ static bool Tentar_Carregar_De_Endereco(uint16_t address, Config_Aplicacao_t* co
 
     uint32_t crc_armazenado = config_out->crc;
     uint32_t tamanho_dados_crc = offsetof(Config_Aplicacao_t, crc);
-    uint32_t crc_calculado = HAL_CRC_Calculate(s_crc_handle, (uint32_t*)config_out, tamanho_dados_crc / 4);
+    uint32_t crc_calculado = CRC_Service_Calcular(CRC_SERVICE_CRC32, config_out, tamanho_dados_crc);
 
     if(crc_calculado == crc_armazenado) {
         return true;
     }
 
+    // Compatibilidade: verses anteriores passavam (bytes / 4) ao HAL e cobriam s 1/4 da struct
+    if (CRC_Service_Calcular(CRC_SERVICE_CRC32, config_out, tamanho_dados_crc / 4) == crc_armazenado) {
+        printf("EEPROM Check: CRC legado no endereco 0x%X, sera regravado\r\n", address);
+        s_crc_legado = true;
+        return true;
+    }
+
     printf("EEPROM Check: Falha de CRC no endereco 0x%X. Esperado [0x%lX] vs Lido [0x%lX]\r\n",
            address, (unsigned long)crc_calculado, (unsigned long)crc_armazenado);
     return false;
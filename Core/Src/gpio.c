@@ -108,11 +108,17 @@ void MX_GPIO_Init(void)
   GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
   HAL_GPIO_Init(GPIOD, &GPIO_InitStruct);
 
-  /*Configure GPIO pins : POWER_GOOD_Pin FAIL_INT_Pin */
-  GPIO_InitStruct.Pin = POWER_GOOD_Pin|FAIL_INT_Pin;
+  /*Configure GPIO pin : POWER_GOOD_Pin */
+  GPIO_InitStruct.Pin = POWER_GOOD_Pin;
   GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
   GPIO_InitStruct.Pull = GPIO_NOPULL;
-  HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+  HAL_GPIO_Init(POWER_GOOD_GPIO_Port, &GPIO_InitStruct);
+
+  /*Configure GPIO pin : FAIL_INT_Pin */
+  GPIO_InitStruct.Pin = FAIL_INT_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_FALLING;
+  GPIO_InitStruct.Pull = GPIO_PULLUP;
+  HAL_GPIO_Init(FAIL_INT_GPIO_Port, &GPIO_InitStruct);
 
   /* EXTI interrupt init*/
   HAL_NVIC_SetPriority(EXTI4_15_IRQn, 2, 0);
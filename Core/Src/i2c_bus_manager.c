@@ -0,0 +1,398 @@
+/*
+ * Nome do Arquivo: i2c_bus_manager.c
+ * Descricao: Arbitro do barramento I2C1. Fila de transacoes com prioridade,
+ *            executadas em sequencia por interrupcao, com ACK polling,
+ *            timeout por transacao e recuperacao do barramento.
+ * Autor: Gabriel Agune
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "i2c_bus_manager.h"
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================
+// Definicoes e Constantes Privadas
+// ============================================================
+
+#define I2C_BUS_PULSOS_RECUPERACAO   9
+#define I2C_BUS_MEIO_CICLO_LOOPS    50   // ~5us @ 48MHz (SCL de recuperacao ~100kHz)
+#define I2C_BUS_NENHUM              (-1)
+
+// ============================================================
+// Tipos de Dados Privados
+// ============================================================
+
+typedef enum {
+    BUS_IDLE,
+    BUS_ATIVO,              // Transacao em andamento no HAL
+    BUS_ACK_POLL_PENDENTE,  // NACK recebido; sera repetida pelo I2C_Bus_Process
+    BUS_CONCLUINDO,         // Executando o callback do solicitante
+    BUS_RECUPERANDO         // Timeout; recuperacao em andamento
+} BusEstado_t;
+
+typedef struct {
+    I2C_Bus_Transacao_t t;
+    uint32_t            seq;
+    uint8_t             prio;
+    bool                ocupado;
+} BusSlot_t;
+
+// ============================================================
+// Variaveis Estaticas
+// ============================================================
+
+static struct {
+    I2C_HandleTypeDef* hi2c;
+    BusSlot_t           slots[I2C_BUS_QUEUE_SIZE];
+    volatile BusEstado_t estado;
+    volatile int8_t     atual;
+    uint32_t            inicio_tick;
+    uint32_t            seq;
+} s_bus;
+
+// ============================================================
+// Prototipos de Funcoes Privadas
+// ============================================================
+
+static int8_t Bus_Selecionar_Proxima(void);
+static HAL_StatusTypeDef Bus_Executar(const I2C_Bus_Transacao_t *t);
+static void Bus_Iniciar_Proxima(void);
+static void Bus_Concluir(bool sucesso);
+static void Bus_Atraso_Meio_Ciclo(void);
+static void Bus_Callback_Blocking(bool sucesso, void *ctx);
+static HAL_StatusTypeDef Bus_Transferir_Blocking(I2C_Bus_Transacao_t *t);
+
+// ============================================================
+// Funcoes Privadas
+// ============================================================
+
+// Escolhe a transacao de maior prioridade (e mais antiga dentro da prioridade)
+static int8_t Bus_Selecionar_Proxima(void) {
+    int8_t melhor = I2C_BUS_NENHUM;
+    for (int8_t i = 0; i < I2C_BUS_QUEUE_SIZE; i++) {
+        const BusSlot_t* s = &s_bus.slots[i];
+        if (!s->ocupado) {
+            continue;
+        }
+        if (melhor == I2C_BUS_NENHUM ||
+            s->prio < s_bus.slots[melhor].prio ||
+            (s->prio == s_bus.slots[melhor].prio && (int32_t)(s->seq - s_bus.slots[melhor].seq) < 0)) {
+            melhor = i;
+        }
+    }
+    return melhor;
+}
+
+// Dispara a transacao no HAL (modo interrupcao)
+static HAL_StatusTypeDef Bus_Executar(const I2C_Bus_Transacao_t *t) {
+    switch (t->op) {
+        case I2C_BUS_OP_READ:
+            return HAL_I2C_Mem_Read_IT(s_bus.hi2c, t->dev_addr, t->mem_addr, t->mem_addr_size, t->p_data, t->size);
+        case I2C_BUS_OP_WRITE:
+            return HAL_I2C_Mem_Write_IT(s_bus.hi2c, t->dev_addr, t->mem_addr, t->mem_addr_size, t->p_data, t->size);
+        case I2C_BUS_OP_PROBE:
+            // Transmissao de 0 bytes: START + endereco + STOP (NACK -> ErrorCallback com AF)
+            return HAL_I2C_Master_Transmit_IT(s_bus.hi2c, t->dev_addr, NULL, 0);
+        default:
+            return HAL_ERROR;
+    }
+}
+
+// Inicia a proxima transacao da fila (chamar com interrupcoes desabilitadas ou na ISR)
+static void Bus_Iniciar_Proxima(void) {
+    int8_t idx = Bus_Selecionar_Proxima();
+    if (idx == I2C_BUS_NENHUM) {
+        s_bus.atual = I2C_BUS_NENHUM;
+        s_bus.estado = BUS_IDLE;
+        return;
+    }
+
+    s_bus.atual = idx;
+    s_bus.inicio_tick = HAL_GetTick();
+    s_bus.estado = BUS_ATIVO;
+
+    if (Bus_Executar(&s_bus.slots[idx].t) != HAL_OK) {
+        // Periferico ocupado/travado (ex.: flag BUSY presa): recuperacao fica para o Process
+        s_bus.estado = BUS_RECUPERANDO;
+    }
+}
+
+// Libera o slot atual, notifica o solicitante e encadeia a proxima transacao
+static void Bus_Concluir(bool sucesso) {
+    int8_t idx = s_bus.atual;
+    if (idx == I2C_BUS_NENHUM) {
+        return;
+    }
+
+    I2C_Bus_Callback_t cb = s_bus.slots[idx].t.callback;
+    void* ctx = s_bus.slots[idx].t.ctx;
+
+    s_bus.slots[idx].ocupado = false;
+    s_bus.atual = I2C_BUS_NENHUM;
+    s_bus.estado = BUS_CONCLUINDO;
+
+    // Submits feitos dentro do callback apenas enfileiram; a ordem de prioridade e mantida
+    if (cb != NULL) {
+        cb(sucesso, ctx);
+    }
+
+    s_bus.estado = BUS_IDLE;
+}
+
+// Espera curta para os pulsos de recuperacao (sem depender do SysTick)
+static void Bus_Atraso_Meio_Ciclo(void) {
+    for (volatile uint32_t i = 0; i < I2C_BUS_MEIO_CICLO_LOOPS; i++) {
+    }
+}
+
+// Sinaliza a conclusao de uma transacao bloqueante
+static void Bus_Callback_Blocking(bool sucesso, void *ctx) {
+    *(volatile int8_t*)ctx = sucesso ? 1 : 0;
+}
+
+// Enfileira com prioridade alta e aguarda; os timeouts do Process garantem o retorno
+static HAL_StatusTypeDef Bus_Transferir_Blocking(I2C_Bus_Transacao_t *t) {
+    volatile int8_t resultado = -1;
+    uint32_t inicio = HAL_GetTick();
+
+    t->callback = Bus_Callback_Blocking;
+    t->ctx = (void*)&resultado;
+
+    while (!I2C_Bus_Submit(t, I2C_BUS_PRIO_ALTA)) {
+        I2C_Bus_Process();
+        if (HAL_GetTick() - inicio > t->timeout_ms) {
+            return HAL_TIMEOUT;
+        }
+    }
+
+    while (resultado < 0) {
+        I2C_Bus_Process();
+    }
+    return (resultado == 1) ? HAL_OK : HAL_ERROR;
+}
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Inicializa o gerenciador com o handle do barramento
+void I2C_Bus_Init(I2C_HandleTypeDef *hi2c) {
+    memset(&s_bus, 0, sizeof(s_bus));
+    s_bus.hi2c = hi2c;
+    s_bus.atual = I2C_BUS_NENHUM;
+    s_bus.estado = BUS_IDLE;
+}
+
+// Enfileira uma transacao nao-bloqueante (seguro tambem a partir de callbacks)
+bool I2C_Bus_Submit(const I2C_Bus_Transacao_t *t, I2C_Bus_Prioridade_t prio) {
+    if (s_bus.hi2c == NULL || t == NULL) {
+        return false;
+    }
+    if (t->op != I2C_BUS_OP_PROBE && (t->p_data == NULL || t->size == 0)) {
+        return false;
+    }
+
+    bool ok = false;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    for (uint8_t i = 0; i < I2C_BUS_QUEUE_SIZE; i++) {
+        BusSlot_t* s = &s_bus.slots[i];
+        if (!s->ocupado) {
+            s->t = *t;
+            if (s->t.timeout_ms == 0) {
+                s->t.timeout_ms = I2C_BUS_TIMEOUT_PADRAO;
+            }
+            s->prio = (uint8_t)prio;
+            s->seq = s_bus.seq++;
+            s->ocupado = true;
+            ok = true;
+            break;
+        }
+    }
+
+    if (ok && s_bus.estado == BUS_IDLE) {
+        Bus_Iniciar_Proxima();
+    }
+
+    __set_PRIMASK(primask);
+    return ok;
+}
+
+// Trata timeouts, repeticoes de ACK polling e recuperacao
+void I2C_Bus_Process(void) {
+    bool recuperar = false;
+    uint32_t agora = HAL_GetTick();
+    uint32_t primask = __get_PRIMASK();
+
+    // Os wrappers bloqueantes chamam o Process em laco: preserva uma secao critica do chamador
+    __disable_irq();
+    if (s_bus.atual != I2C_BUS_NENHUM) {
+        const I2C_Bus_Transacao_t* t = &s_bus.slots[s_bus.atual].t;
+        uint32_t decorrido = agora - s_bus.inicio_tick;
+
+        if (s_bus.estado == BUS_ACK_POLL_PENDENTE) {
+            if (decorrido >= t->ack_poll_ms) {
+                Bus_Concluir(false);
+                Bus_Iniciar_Proxima();
+            } else {
+                s_bus.estado = BUS_ATIVO;
+                if (Bus_Executar(t) != HAL_OK) {
+                    s_bus.estado = BUS_RECUPERANDO;
+                }
+            }
+        } else if (s_bus.estado == BUS_ATIVO && decorrido > (uint32_t)t->timeout_ms + t->ack_poll_ms) {
+            // A ISR ignora eventos a partir daqui; a transacao sera concluida com erro
+            s_bus.estado = BUS_RECUPERANDO;
+        }
+
+        recuperar = (s_bus.estado == BUS_RECUPERANDO);
+    }
+    __set_PRIMASK(primask);
+
+    if (recuperar) {
+        printf("I2C Bus: falha/timeout na transacao, recuperando barramento...\r\n");
+        I2C_Bus_Recover();
+
+        __disable_irq();
+        Bus_Concluir(false);
+        Bus_Iniciar_Proxima();
+        __set_PRIMASK(primask);
+    }
+}
+
+// Verifica se nao ha transacao em andamento nem pendente
+bool I2C_Bus_IsIdle(void) {
+    if (s_bus.estado != BUS_IDLE) {
+        return false;
+    }
+    for (uint8_t i = 0; i < I2C_BUS_QUEUE_SIZE; i++) {
+        if (s_bus.slots[i].ocupado) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Libera um escravo que ficou segurando SDA: 9 pulsos de SCL + condicao de STOP
+void I2C_Bus_Recover(void) {
+    if (s_bus.hi2c == NULL) {
+        return;
+    }
+
+    GPIO_InitTypeDef gpio = {0};
+
+    HAL_I2C_DeInit(s_bus.hi2c);
+
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    HAL_GPIO_WritePin(I2C_BUS_SCL_PORT, I2C_BUS_SCL_PIN, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(I2C_BUS_SDA_PORT, I2C_BUS_SDA_PIN, GPIO_PIN_SET);
+
+    gpio.Mode  = GPIO_MODE_OUTPUT_OD;
+    gpio.Pull  = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_LOW;
+    gpio.Pin   = I2C_BUS_SCL_PIN;
+    HAL_GPIO_Init(I2C_BUS_SCL_PORT, &gpio);
+    gpio.Pin   = I2C_BUS_SDA_PIN;
+    HAL_GPIO_Init(I2C_BUS_SDA_PORT, &gpio);
+
+    for (uint8_t i = 0; i < I2C_BUS_PULSOS_RECUPERACAO; i++) {
+        if (HAL_GPIO_ReadPin(I2C_BUS_SDA_PORT, I2C_BUS_SDA_PIN) == GPIO_PIN_SET) {
+            break;
+        }
+        HAL_GPIO_WritePin(I2C_BUS_SCL_PORT, I2C_BUS_SCL_PIN, GPIO_PIN_RESET);
+        Bus_Atraso_Meio_Ciclo();
+        HAL_GPIO_WritePin(I2C_BUS_SCL_PORT, I2C_BUS_SCL_PIN, GPIO_PIN_SET);
+        Bus_Atraso_Meio_Ciclo();
+    }
+
+    // STOP: SDA sobe com SCL em nivel alto
+    HAL_GPIO_WritePin(I2C_BUS_SDA_PORT, I2C_BUS_SDA_PIN, GPIO_PIN_RESET);
+    Bus_Atraso_Meio_Ciclo();
+    HAL_GPIO_WritePin(I2C_BUS_SDA_PORT, I2C_BUS_SDA_PIN, GPIO_PIN_SET);
+    Bus_Atraso_Meio_Ciclo();
+
+    // HAL_I2C_Init -> MspInit devolve os pinos para a funcao alternativa
+    HAL_I2C_Init(s_bus.hi2c);
+}
+
+// Leitura bloqueante via fila
+HAL_StatusTypeDef I2C_Bus_Mem_Read_Blocking(uint16_t dev_addr, uint16_t mem_addr, uint16_t mem_addr_size, uint8_t *data, uint16_t size, uint16_t timeout_ms) {
+    I2C_Bus_Transacao_t t = {0};
+    t.op            = I2C_BUS_OP_READ;
+    t.dev_addr      = dev_addr;
+    t.mem_addr      = mem_addr;
+    t.mem_addr_size = mem_addr_size;
+    t.p_data        = data;
+    t.size          = size;
+    t.timeout_ms    = timeout_ms;
+    return Bus_Transferir_Blocking(&t);
+}
+
+// Escrita bloqueante via fila
+HAL_StatusTypeDef I2C_Bus_Mem_Write_Blocking(uint16_t dev_addr, uint16_t mem_addr, uint16_t mem_addr_size, const uint8_t *data, uint16_t size, uint16_t timeout_ms) {
+    I2C_Bus_Transacao_t t = {0};
+    t.op            = I2C_BUS_OP_WRITE;
+    t.dev_addr      = dev_addr;
+    t.mem_addr      = mem_addr;
+    t.mem_addr_size = mem_addr_size;
+    t.p_data        = (uint8_t*)data;
+    t.size          = size;
+    t.timeout_ms    = timeout_ms;
+    return Bus_Transferir_Blocking(&t);
+}
+
+// Teste de presenca (ACK) bloqueante via fila
+HAL_StatusTypeDef I2C_Bus_Probe_Blocking(uint16_t dev_addr, uint16_t timeout_ms) {
+    I2C_Bus_Transacao_t t = {0};
+    t.op         = I2C_BUS_OP_PROBE;
+    t.dev_addr   = dev_addr;
+    t.timeout_ms = timeout_ms;
+    return Bus_Transferir_Blocking(&t);
+}
+
+// ============================================================
+// Callbacks do HAL I2C (Contexto de ISR)
+// ============================================================
+
+// Conclusao de uma transacao com sucesso: notifica e encadeia a proxima
+static void Bus_Evento_Sucesso(I2C_HandleTypeDef *hi2c) {
+    if (s_bus.hi2c == NULL || hi2c->Instance != s_bus.hi2c->Instance || s_bus.estado != BUS_ATIVO) {
+        return;
+    }
+    Bus_Concluir(true);
+    Bus_Iniciar_Proxima();
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    Bus_Evento_Sucesso(hi2c);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    Bus_Evento_Sucesso(hi2c);
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    Bus_Evento_Sucesso(hi2c);
+}
+
+// Erro no barramento: NACK dentro da janela de ACK polling e repetido, demais falham
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+    if (s_bus.hi2c == NULL || hi2c->Instance != s_bus.hi2c->Instance || s_bus.estado != BUS_ATIVO) {
+        return;
+    }
+
+    const I2C_Bus_Transacao_t* t = &s_bus.slots[s_bus.atual].t;
+    if ((hi2c->ErrorCode & HAL_I2C_ERROR_AF) != 0U && t->ack_poll_ms > 0 &&
+        (HAL_GetTick() - s_bus.inicio_tick) < t->ack_poll_ms) {
+        s_bus.estado = BUS_ACK_POLL_PENDENTE;
+        return;
+    }
+
+    Bus_Concluir(false);
+    Bus_Iniciar_Proxima();
+}
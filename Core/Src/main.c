@@ -34,6 +34,7 @@
 #include "dwin_driver.h"
 #include "cli_driver.h"
 #include "cli_controller.h"
+#include "usb_bench.h"
 #include <stdio.h>
 #include <string.h>
 /* USER CODE END Includes */
@@ -56,7 +57,6 @@
 /* Private variables ---------------------------------------------------------*/
 
 /* USER CODE BEGIN PV */
-uint8_t usb_rx_buffer[64];
 void USB_Process(void);
 /* USER CODE END PV */
 
@@ -140,18 +140,18 @@ int main(void)
 
 void USB_Process(void)
 {
+#if USB_BENCH_ENABLE
+	uint32_t ciclos = USB_Bench_Ciclos();
 	ux_device_stack_tasks_run();
-		
-    uint32_t bytes_received = 0;
-    USBD_CDC_ACM_Receive(usb_rx_buffer, sizeof(usb_rx_buffer), &bytes_received);
-
-    if (bytes_received > 0)
-    {
-      for (int i = 0; i < bytes_received; i++)
-      {
-        CLI_Receive_Char(usb_rx_buffer[i]);
-      }
-    }
+	USB_Bench_Registrar_Tasks(ciclos);
+#else
+	ux_device_stack_tasks_run();
+#endif
+
+	CLI_RX_Pump();
+#if USB_BENCH_ENABLE
+	USB_Bench_Process();
+#endif
 }
 
 /**
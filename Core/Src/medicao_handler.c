@@ -8,6 +8,7 @@
 #include "ads1232_driver.h"
 #include "pcb_frequency.h"
 #include "gerenciador_configuracoes.h"
+#include "rtc_driver.h"
 #include "main.h"
 #include <string.h>
 #include <math.h>
@@ -58,6 +59,10 @@ void Medicao_Stop_Balanca(void) {
     }
 }
 
+bool Medicao_Balanca_Ativa(void) {
+    return s_balanca_ativa;
+}
+
 // Executa a lgica de aquisio de dados
 void Medicao_Process(void) {
 		ADS1232_Process();
@@ -82,6 +87,7 @@ void Medicao_Get_UltimaMedicao(DadosMedicao_t* dados_out) {
 // Define a temperatura do instrumento
 void Medicao_Set_Temp_Instru(float temp_instru) {
     s_dados_medicao_atuais.Temp_Instru = temp_instru;
+    s_dados_medicao_atuais.Carimbo_Temp_ms = RTC_Driver_Get_Epoch_ms();
 }
 
 // Define a densidade
@@ -103,6 +109,7 @@ static void UpdateScaleData(void) {
     // Apenas atualiza a struct se a balana estiver ativa e tiver dado novo
     if (s_balanca_ativa && ADS1232_IsDataAvailable()) {
         s_dados_medicao_atuais.Peso = ADS1232_GetGrams();
+        s_dados_medicao_atuais.Carimbo_Peso_ms = RTC_Driver_Get_Epoch_ms();
     }
 }
 
@@ -116,6 +123,7 @@ static void UpdateFrequencyData(void) {
 
         s_dados_medicao_atuais.Frequencia = (float)pulsos;
         s_dados_medicao_atuais.Escala_A = CalculateEscalaA(pulsos);
+        s_dados_medicao_atuais.Carimbo_Frequencia_ms = RTC_Driver_Get_Epoch_ms();
     }
 }
 
@@ -6,57 +6,113 @@
 
 #include "pwm_servo_driver.h"
 
+// ============================================================
+// Defines e Constantes
+// ============================================================
+
+#define LUT_FRAC_BITS   (PWM_SERVO_FRAC_BITS + PWM_SERVO_LUT_SHIFT)
+#define LUT_FRAC_MASK   ((1UL << LUT_FRAC_BITS) - 1UL)
+
+// O tick precisa ser inteiro e de no mximo 1 us, e o quadro caber no contador de 16 bits
+typedef char Pwm_Servo_Base_Valida[((PWM_SERVO_TIMER_HZ % PWM_SERVO_TICK_HZ) == 0UL &&
+                                    PWM_SERVO_TICK_HZ >= 1000000UL &&
+                                    PWM_SERVO_ARR <= 0xFFFFUL) ? 1 : -1];
+
 // ============================================================
 // Prottipos de Funes Privadas
 // ============================================================
 
-static uint32_t map_angle_to_ccr(Servo_t *servo, float angle);
+static void build_ccr_lut(Servo_t *servo);
+static int32_t clamp_pulse_us(int32_t pulse_us);
 
 // ============================================================
 // Funes Privadas (Helpers)
 // ============================================================
 
-// Mapeia um ngulo para o valor do registrador de comparao (CCR)
-static uint32_t map_angle_to_ccr(Servo_t *servo, float angle) {
-    if (servo == NULL) {
-        return 0;
-    }
-
-    if (angle < 0.0f) {
-        angle = 0.0f;
+// Limita o pulso  faixa segura do servo
+static int32_t clamp_pulse_us(int32_t pulse_us) {
+    if (pulse_us < PWM_SERVO_PULSO_MIN_US) {
+        return PWM_SERVO_PULSO_MIN_US;
     }
-    if (angle > 180.0f) {
-        angle = 180.0f;
+    if (pulse_us > PWM_SERVO_PULSO_MAX_US) {
+        return PWM_SERVO_PULSO_MAX_US;
     }
+    return pulse_us;
+}
 
-    // Interpolao Linear: converte o ngulo na faixa [0, 180] para um pulso na faixa [min_pulse_us, max_pulse_us]
-    uint16_t pulse_range_us  = servo->max_pulse_us - servo->min_pulse_us;
-    uint16_t target_pulse_us = servo->min_pulse_us + (uint16_t)((angle / 180.0f) * pulse_range_us);
+// Pr-calcula o CCR de cada ponto da tabela (interpolao linear entre os pulsos j com trim)
+static void build_ccr_lut(Servo_t *servo) {
+    int32_t pulse_min_us   = clamp_pulse_us((int32_t)servo->min_pulse_us + servo->trim_min_us);
+    int32_t pulse_max_us   = clamp_pulse_us((int32_t)servo->max_pulse_us + servo->trim_max_us);
+    int32_t pulse_range_us = pulse_max_us - pulse_min_us;
 
-    return target_pulse_us;
+    for (uint32_t i = 0; i < PWM_SERVO_LUT_PONTOS; i++) {
+        int32_t graus    = (int32_t)(i << PWM_SERVO_LUT_SHIFT);
+        int32_t pulse_us = pulse_min_us + ((pulse_range_us * graus) + (int32_t)(PWM_SERVO_ANGULO_MAX / 2U)) / (int32_t)PWM_SERVO_ANGULO_MAX;
+        servo->lut_ccr[i] = (uint16_t)PWM_SERVO_US_PARA_CCR(pulse_us);
+    }
 }
 
 // ============================================================
 // Funes Pblicas (API do Driver)
 // ============================================================
 
-// Inicializa e inicia a gerao de PWM para um servo especfico
+// Monta a tabela de CCR e inicia a gerao de PWM para um servo especfico
 HAL_StatusTypeDef PWM_Servo_Init(Servo_t *servo) {
-    if (servo == NULL || servo->htim == NULL) {
+    if (servo == NULL || servo->htim == NULL || servo->max_pulse_us < servo->min_pulse_us) {
         return HAL_ERROR;
     }
 
+    // A tabela assume 1 tick = 1 us e quadro de 20 ms: impe a base se o timer veio diferente
+    if (servo->htim->Init.Prescaler != PWM_SERVO_PRESCALER || servo->htim->Init.Period != PWM_SERVO_ARR) {
+        servo->htim->Init.Prescaler = PWM_SERVO_PRESCALER;
+        servo->htim->Init.Period    = PWM_SERVO_ARR;
+        __HAL_TIM_SET_PRESCALER(servo->htim, PWM_SERVO_PRESCALER);
+        __HAL_TIM_SET_AUTORELOAD(servo->htim, PWM_SERVO_ARR);
+        HAL_TIM_GenerateEvent(servo->htim, TIM_EVENTSOURCE_UPDATE);
+    }
+
+    build_ccr_lut(servo);
+
     return HAL_TIM_PWM_Start(servo->htim, servo->channel);
 }
 
-// Define a posio do servo em um ngulo especfico
-void PWM_Servo_SetAngle(Servo_t *servo, float angle) {
+// Aplica os trims de calibrao e recalcula a tabela de CCR
+void PWM_Servo_Set_Trim(Servo_t *servo, int16_t trim_min_us, int16_t trim_max_us) {
+    if (servo == NULL) {
+        return;
+    }
+
+    // A tabela  lida pelo motor de movimento no ISR do TIM14
+    __disable_irq();
+    servo->trim_min_us = trim_min_us;
+    servo->trim_max_us = trim_max_us;
+    build_ccr_lut(servo);
+    __enable_irq();
+}
+
+// Define a posio do servo em um ngulo inteiro (graus)
+void PWM_Servo_SetAngle(Servo_t *servo, uint16_t angle) {
+    PWM_Servo_Set_Posicao(servo, PWM_SERVO_GRAUS_Q8(angle));
+}
+
+// Define a posio em graus Q8: dois pontos da tabela e uma interpolao por deslocamento
+void PWM_Servo_Set_Posicao(Servo_t *servo, uint32_t posicao_q8) {
     if (servo == NULL || servo->htim == NULL) {
         return;
     }
 
-    // Converte o ngulo desejado para o valor bruto do registrador CCR
-    uint32_t ccr_value = map_angle_to_ccr(servo, angle);
+    if (posicao_q8 > PWM_SERVO_GRAUS_Q8(PWM_SERVO_ANGULO_MAX)) {
+        posicao_q8 = PWM_SERVO_GRAUS_Q8(PWM_SERVO_ANGULO_MAX);
+    }
+
+    uint32_t indice    = posicao_q8 >> LUT_FRAC_BITS;
+    uint32_t ccr_value = servo->lut_ccr[indice];
+
+    if (indice < (PWM_SERVO_LUT_PONTOS - 1U)) {
+        uint32_t passo = (uint32_t)(servo->lut_ccr[indice + 1U] - servo->lut_ccr[indice]);
+        ccr_value += (passo * (posicao_q8 & LUT_FRAC_MASK)) >> LUT_FRAC_BITS;
+    }
 
     __HAL_TIM_SET_COMPARE(servo->htim, servo->channel, ccr_value);
 }
@@ -68,4 +124,4 @@ HAL_StatusTypeDef PWM_Servo_DeInit(Servo_t *servo) {
     }
 
     return HAL_TIM_PWM_Stop(servo->htim, servo->channel);
-}
\ No newline at end of file
+}
@@ -14,7 +14,66 @@
 #include "rtc_driver.h"
 #include "dwin_driver.h"
 #include "cli_driver.h"
-#include <stdio.h>
+
+// ============================================================
+// Defines e Constantes
+// ============================================================
+
+#define RELATO_BLOCO            64U     // Bytes acumulados antes de cada escrita na sada
+#define RELATO_CAMPO_MAX        24U     // Maior campo formatado (texto ou nmero)
+#define RELATO_FIXO_LIMITE      2000000000UL // Saturao dos valores em ponto fixo
+
+// Valores fixos do relatrio (ainda no vm da medio)
+#define RELATO_NUM_MEDIDAS      22
+#define RELATO_AMOSTRA_NUMERO   4
+#define RELATO_TEMP_AMOSTRA_X10 220     // 22.0 'C
+
+// Campos preenchidos pelos formatadores
+typedef enum {
+    CAMPO_NENHUM,
+    CAMPO_FIRMWARE,
+    CAMPO_HARDWARE,
+    CAMPO_SERIAL,
+    CAMPO_NUM_MEDIDAS,
+    CAMPO_PRODUTO,
+    CAMPO_CURVA,
+    CAMPO_VALIDADE,
+    CAMPO_AMOSTRA,
+    CAMPO_TEMP_AMOSTRA,
+    CAMPO_TEMP_INSTRU,
+    CAMPO_PESO,
+    CAMPO_DENSIDADE,
+    CAMPO_UMIDADE,
+    CAMPO_HORA,
+    CAMPO_DATA
+} Relato_Campo_t;
+
+// Linha do modelo: texto fixo, campo alinhado  direita em 'largura' colunas (0 = sem preenchimento) e sufixo
+typedef struct {
+    const char* prefixo;
+    uint8_t     campo;
+    uint8_t     largura;
+    const char* sufixo;
+} Relato_Linha_t;
+
+// Valores lidos uma nica vez por relatrio (nmeros j em ponto fixo)
+typedef struct {
+    char             serial[17];
+    Config_Grao_t    grao;
+    RTC_Calendario_t cal;
+    int32_t          temp_instru_x10;
+    int32_t          peso_x10;
+    int32_t          densidade_x10;
+    int32_t          umidade;           // Escala 10^casas_umidade
+    uint8_t          casas_umidade;
+} Relato_Valores_t;
+
+// Acumula os bytes e entrega blocos  sada
+typedef struct {
+    const Relato_Saida_t* saida;
+    size_t                tamanho;
+    char                  bloco[RELATO_BLOCO];
+} Relato_Escritor_t;
 
 // ============================================================
 // Variveis Privadas e Constantes de Formatao
@@ -27,110 +86,382 @@ const char Ejeta[] = "================================\n\r\n\r\n\r\n\r";
 const char Dupla[] = "\n\r================================\n\r";
 const char Linha[] = "--------------------------------\n\r";
 
+// Sada padro: FIFO do CLI (USB CDC), mesmo destino do antigo printf
+const Relato_Saida_t RELATO_SAIDA_CLI = { Relato_Saida_CLI, NULL };
+
 // ============================================================
-// Prottipos de Funes Pblicas (Para uso interno do mdulo)
+// Modelos de Relatrio
 // ============================================================
 
-void Cabecalho(void);
-void Assinatura(void);
+static const Relato_Linha_t s_modelo_who_am_i[] = {
+    { Dupla,                                        CAMPO_NENHUM,      0,  NULL    },
+    { "         G620_Teste_Gab\n\r",                CAMPO_NENHUM,      0,  NULL    },
+    { "     (c) GEHAKA, 2004-2025\n\r",             CAMPO_NENHUM,      0,  NULL    },
+    { Linha,                                        CAMPO_NENHUM,      0,  NULL    },
+    { "CPU      =           STM32C071RB\n\r",       CAMPO_NENHUM,      0,  NULL    },
+    { "Firmware = ",                                CAMPO_FIRMWARE,    21, "\r\n"  },
+    { "Hardware = ",                                CAMPO_HARDWARE,    21, "\r\n"  },
+    { "Serial   = ",                                CAMPO_SERIAL,      21, "\r\n"  },
+    { Linha,                                        CAMPO_NENHUM,      0,  NULL    },
+    { "Medidas  = ",                                CAMPO_NUM_MEDIDAS, 21, "\n\r"  },
+    { Ejeta,                                        CAMPO_NENHUM,      0,  NULL    },
+};
+
+static const Relato_Linha_t s_modelo_cabecalho[] = {
+    { Dupla,                                        CAMPO_NENHUM,      0,  NULL    },
+    { "GEHAKA            G620_Teste_Gab\n\r",       CAMPO_NENHUM,      0,  NULL    },
+    { Linha,                                        CAMPO_NENHUM,      0,  NULL    },
+    { "Versao Firmware= ",                          CAMPO_FIRMWARE,    15, "\n\r"  },
+    { "Numero de Serie= ",                          CAMPO_SERIAL,      15, "\n\r"  },
+    { Linha,                                        CAMPO_NENHUM,      0,  NULL    },
+};
+
+static const Relato_Linha_t s_modelo_medicao[] = {
+    { "Produto       = ",                           CAMPO_PRODUTO,     16, "\n\r"          },
+    { "Versao Equacao= ",                           CAMPO_CURVA,       10, "\n\r"          },
+    { "Validade Curva= ",                           CAMPO_VALIDADE,    13, "\n\r"          },
+    { "Amostra Numero= ",                           CAMPO_AMOSTRA,     8,  "\n\r"          },
+    { "Temp.Amostra .= ",                           CAMPO_TEMP_AMOSTRA, 8, " 'C\n\r"       },
+    { "Temp.Instru ..= ",                           CAMPO_TEMP_INSTRU, 8,  " 'C\n\r"       },
+    { "Peso Amostra .= ",                           CAMPO_PESO,        8,  " g\n\r"        },
+    { "Densidade ....= ",                           CAMPO_DENSIDADE,   8,  " Kg/hL\n\r"    },
+    { Linha,                                        CAMPO_NENHUM,      0,  NULL            },
+    { "Umidade ......= ",                           CAMPO_UMIDADE,     14, " %\n\r"        },
+    { Linha,                                        CAMPO_NENHUM,      0,  NULL            },
+};
+
+static const Relato_Linha_t s_modelo_assinatura[] = {
+    { "\n\r\n\r",                                   CAMPO_NENHUM,      0,  NULL    },
+    { Linha,                                        CAMPO_NENHUM,      0,  NULL    },
+    { "Assinatura              ",                   CAMPO_HORA,        0,  "\n\r"  },
+    { "Responsavel             ",                   CAMPO_DATA,        0,  "\n\r"  },
+    { "\n\r\n\r\n\r\n\r",                           CAMPO_NENHUM,      0,  NULL    },
+};
+
+static const Relato_Linha_t s_modelo_qrcode[] = {
+    { "G620_Teste_Gab\n===================\n\r",    CAMPO_NENHUM,      0,  NULL        },
+    { "Produto: ",                                  CAMPO_PRODUTO,     0,  "\n"        },
+    { "Umidade: ",                                  CAMPO_UMIDADE,     0,  " %\n"      },
+    { "Curva: ",                                    CAMPO_CURVA,       0,  "\n"        },
+    { "Amostra: ",                                  CAMPO_AMOSTRA,     0,  "\n"        },
+    { "Temp. instru: ",                             CAMPO_TEMP_INSTRU, 0,  " C\n"      },
+    { "Peso: ",                                     CAMPO_PESO,        0,  " g\n"      },
+    { "Densidade: ",                                CAMPO_DENSIDADE,   0,  " Kg/hL\n"  },
+    { "Validade: ",                                 CAMPO_VALIDADE,    0,  "\n"        },
+    { "===================\n\r",                    CAMPO_NENHUM,      0,  NULL        },
+    { "Data: ",                                     CAMPO_DATA,        0,  "\n"        },
+    { "Hora: ",                                     CAMPO_HORA,        0,  NULL        },
+};
+
+#define NUM_LINHAS(m)   ((uint8_t)(sizeof(m) / sizeof((m)[0])))
 
 // ============================================================
-// Funes Pblicas
+// Prottipos de Funes Privadas
 // ============================================================
 
-// Imprime informaes de identificao do dispositivo (CLI/Impressora)
-void Who_am_i(void) {
-    char serial[17];
-    Gerenciador_Config_Get_Serial(serial, sizeof(serial));
-
-    printf(Dupla);
-    printf("         G620_Teste_Gab\n\r");
-    printf("     (c) GEHAKA, 2004-2025\n\r");
-    printf(Linha);
-    printf("CPU      =           STM32C071RB\n\r");
-    printf("Firmware = %21s\r\n", FIRMWARE);
-    printf("Hardware = %21s\r\n", HARDWARE);
-    printf("Serial   = %21s\r\n", serial);
-    printf(Linha);
-    printf("Medidas  = %21d\n\r", 22);
-    printf(Ejeta);
+static void    Coletar_Valores(Relato_Valores_t* v);
+static int32_t Para_Fixo(float valor, uint8_t casas);
+static size_t  Formatar_Numero(char* dst, uint32_t magnitude, bool negativo, uint8_t casas);
+static size_t  Formatar_Fixo(char* dst, int32_t valor, uint8_t casas);
+static size_t  Formatar_Texto(char* dst, const char* texto, size_t max);
+static size_t  Formatar_Tres_Pares(char* dst, uint8_t a, uint8_t b, uint8_t c, char separador);
+static size_t  Formatar_Campo(char* dst, uint8_t campo, const Relato_Valores_t* v);
+static void    Emitir(Relato_Escritor_t* e, const char* dados, size_t len);
+static void    Emitir_Texto(Relato_Escritor_t* e, const char* texto);
+static void    Descarregar(Relato_Escritor_t* e);
+static void    Renderizar(Relato_Escritor_t* e, const Relato_Linha_t* linhas, uint8_t num_linhas,
+                          const Relato_Valores_t* v);
+
+// ============================================================
+// Funes Privadas (Formatadores)
+// ============================================================
+
+// L configurao, medio e relgio de uma vez e converte os nmeros para ponto fixo
+static void Coletar_Valores(Relato_Valores_t* v) {
+    memset(v, 0, sizeof(Relato_Valores_t));
+
+    Gerenciador_Config_Get_Serial(v->serial, sizeof(v->serial));
+
+    uint8_t indice_grao = 0;
+    Gerenciador_Config_Get_Grao_Ativo(&indice_grao);
+    Gerenciador_Config_Get_Dados_Grao(indice_grao, &v->grao);
+
+    RTC_Driver_Get_Calendario(&v->cal);
+
+    DadosMedicao_t dados;
+    Medicao_Get_UltimaMedicao(&dados);
+
+    // O gerenciador garante nr_decimals <= MAX_NR_DECIMALS (setter e carga da EEPROM)
+    v->casas_umidade   = (uint8_t)Gerenciador_Config_Get_NR_Decimals();
+    v->temp_instru_x10 = Para_Fixo(dados.Temp_Instru, 1);
+    v->peso_x10        = Para_Fixo(dados.Peso, 1);
+    v->densidade_x10   = Para_Fixo(dados.Densidade, 1);
+    v->umidade         = Para_Fixo(dados.Umidade, v->casas_umidade);
 }
 
-// Gera e envia o relatrio formatado para a impressora
-void Relatorio_Printer (void) {
-    uint16_t nr_decimals = Gerenciador_Config_Get_NR_Decimals();
+// Converte para inteiro escalado por 10^casas sem aritmtica de float: o valor binrio
+// (mantissa * 2^expoente)  escalado em 64 bits e arredondado como o printf (empate vai para o par)
+static int32_t Para_Fixo(float valor, uint8_t casas) {
+    static const uint32_t potencias[MAX_NR_DECIMALS + 1U] = { 1U, 10U, 100U, 1000U, 10000U };
+    const uint32_t limite = RELATO_FIXO_LIMITE;
 
-    uint8_t indice_grao_ativo = 0;
-    Gerenciador_Config_Get_Grao_Ativo(&indice_grao_ativo);
+    uint32_t bits;
+    memcpy(&bits, &valor, sizeof(bits));
 
-    Config_Grao_t dados_grao_ativo;
-    Gerenciador_Config_Get_Dados_Grao(indice_grao_ativo, &dados_grao_ativo);
+    const bool negativo = (bits >> 31) != 0U;
+    int32_t    expoente = (int32_t)((bits >> 23) & 0xFFU);
+    uint32_t   mantissa = bits & 0x7FFFFFU;
+
+    if (expoente == 0xFF) {             // Infinito satura, NaN vira zero
+        return (mantissa != 0U) ? 0 : (negativo ? -(int32_t)limite : (int32_t)limite);
+    }
+    if (expoente == 0) {
+        expoente = 1;                   // Subnormal
+    } else {
+        mantissa |= 0x800000U;
+    }
+    expoente -= 150;                    // valor = mantissa * 2^expoente
 
-    DadosMedicao_t medicao_snapshot;
-    Medicao_Get_UltimaMedicao(&medicao_snapshot);
+    const uint64_t escalado = (uint64_t)mantissa * potencias[casas];
+    uint32_t resultado;
 
-    Cabecalho();
+    if (expoente >= 0) {
+        resultado = (expoente >= 32 || escalado > ((uint64_t)limite >> expoente))
+                  ? limite : (uint32_t)(escalado << expoente);
+    } else if (expoente <= -40) {
+        resultado = 0U;                 // escalado < 2^38: abaixo de meia unidade
+    } else {
+        const uint32_t desloc = (uint32_t)(-expoente);
+        uint64_t       q      = escalado >> desloc;
+        const uint64_t resto  = escalado - (q << desloc);
+        const uint64_t meio   = 1ULL << (desloc - 1U);
 
-    printf("Produto       = %16s\n\r", dados_grao_ativo.nome);
-  	printf("Versao Equacao= %10lu\n\r", (unsigned long)dados_grao_ativo.id_curva);
-  	printf("Validade Curva= %13s\n\r", dados_grao_ativo.validade);
-  	printf("Amostra Numero= %8i\n\r", 4);
-  	printf("Temp.Amostra .= %8.1f 'C\n\r", 22.0);
-  	printf("Temp.Instru ..= %8.1f 'C\n\r", medicao_snapshot.Temp_Instru);
-  	printf("Peso Amostra .= %8.1f g\n\r", medicao_snapshot.Peso);
-  	printf("Densidade ....= %8.1f Kg/hL\n\r", medicao_snapshot.Densidade);
-    printf(Linha);
-  	printf("Umidade ......= %14.*f %%\n\r", (int)nr_decimals, medicao_snapshot.Umidade);
-  	printf(Linha);
+        if (resto > meio || (resto == meio && (q & 1U) != 0U)) {
+            q++;
+        }
+        resultado = (q > limite) ? limite : (uint32_t)q;
+    }
 
-  	Assinatura();
+    return negativo ? -(int32_t)resultado : (int32_t)resultado;
 }
 
-// Gera a string formatada para o QR Code e a envia ao display
-void Relatorio_QRCode_WhoAmI(void) {
-    char serial[17];
-    Gerenciador_Config_Get_Serial(serial, sizeof(serial));
+// Escreve um nmero com 'casas' decimais (sem preenchimento); retorna o tamanho
+static size_t Formatar_Numero(char* dst, uint32_t magnitude, bool negativo, uint8_t casas) {
+    char   invertido[16];
+    size_t n = 0;
 
-    uint16_t nr_decimals = Gerenciador_Config_Get_NR_Decimals();
+    for (uint8_t i = 0; i < casas; i++) {
+        invertido[n++] = (char)('0' + (magnitude % 10U));
+        magnitude /= 10U;
+    }
+    if (casas > 0U) {
+        invertido[n++] = '.';
+    }
+    do {
+        invertido[n++] = (char)('0' + (magnitude % 10U));
+        magnitude /= 10U;
+    } while (magnitude != 0U);
+    if (negativo) {
+        invertido[n++] = '-';
+    }
 
-    uint8_t indice_grao = 0;
-    Gerenciador_Config_Get_Grao_Ativo(&indice_grao);
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = invertido[n - 1U - i];
+    }
+    return n;
+}
 
-    Config_Grao_t grao;
-    Gerenciador_Config_Get_Dados_Grao(indice_grao, &grao);
+// Ponto fixo com sinal
+static size_t Formatar_Fixo(char* dst, int32_t valor, uint8_t casas) {
+    const bool negativo = valor < 0;
+    const uint32_t magnitude = negativo ? (0U - (uint32_t)valor) : (uint32_t)valor;
+    return Formatar_Numero(dst, magnitude, negativo, casas);
+}
 
-    DadosMedicao_t dados;
-    Medicao_Get_UltimaMedicao(&dados);
+// Copia at 'max' caracteres de uma string (que pode no ter terminador dentro do limite)
+static size_t Formatar_Texto(char* dst, const char* texto, size_t max) {
+    size_t n = 0;
+    while (n < max && texto[n] != '\0') {
+        dst[n] = texto[n];
+        n++;
+    }
+    return n;
+}
+
+// "aa?bb?cc" com dois dgitos cada (hora e data)
+static size_t Formatar_Tres_Pares(char* dst, uint8_t a, uint8_t b, uint8_t c, char separador) {
+    const uint8_t valores[3] = { a, b, c };
+    size_t n = 0;
+
+    for (uint8_t i = 0; i < 3U; i++) {
+        if (i > 0U) {
+            dst[n++] = separador;
+        }
+        dst[n++] = (char)('0' + ((valores[i] / 10U) % 10U));
+        dst[n++] = (char)('0' + (valores[i] % 10U));
+    }
+    return n;
+}
+
+// Formata um campo no tamanho natural (at RELATO_CAMPO_MAX); retorna o tamanho
+static size_t Formatar_Campo(char* dst, uint8_t campo, const Relato_Valores_t* v) {
+    switch (campo) {
+        case CAMPO_FIRMWARE:     return Formatar_Texto(dst, FIRMWARE, RELATO_CAMPO_MAX);
+        case CAMPO_HARDWARE:     return Formatar_Texto(dst, HARDWARE, RELATO_CAMPO_MAX);
+        case CAMPO_SERIAL:       return Formatar_Texto(dst, v->serial, sizeof(v->serial));
+        case CAMPO_NUM_MEDIDAS:  return Formatar_Fixo(dst, RELATO_NUM_MEDIDAS, 0);
+        case CAMPO_PRODUTO:      return Formatar_Texto(dst, v->grao.nome, MAX_NOME_GRAO_LEN);
+        case CAMPO_CURVA:        return Formatar_Numero(dst, v->grao.id_curva, false, 0);
+        case CAMPO_VALIDADE:     return Formatar_Texto(dst, v->grao.validade, sizeof(v->grao.validade));
+        case CAMPO_AMOSTRA:      return Formatar_Fixo(dst, RELATO_AMOSTRA_NUMERO, 0);
+        case CAMPO_TEMP_AMOSTRA: return Formatar_Fixo(dst, RELATO_TEMP_AMOSTRA_X10, 1);
+        case CAMPO_TEMP_INSTRU:  return Formatar_Fixo(dst, v->temp_instru_x10, 1);
+        case CAMPO_PESO:         return Formatar_Fixo(dst, v->peso_x10, 1);
+        case CAMPO_DENSIDADE:    return Formatar_Fixo(dst, v->densidade_x10, 1);
+        case CAMPO_UMIDADE:      return Formatar_Fixo(dst, v->umidade, v->casas_umidade);
+        case CAMPO_HORA:         return Formatar_Tres_Pares(dst, v->cal.hora, v->cal.minuto, v->cal.segundo, ':');
+        case CAMPO_DATA:         return Formatar_Tres_Pares(dst, v->cal.dia, v->cal.mes, v->cal.ano, '/');
+        default:                 return 0;
+    }
+}
+
+// ============================================================
+// Funes Privadas (Escritor)
+// ============================================================
+
+// Acumula no bloco e entrega  sada quando enche
+static void Emitir(Relato_Escritor_t* e, const char* dados, size_t len) {
+    while (len > 0U) {
+        size_t livre = RELATO_BLOCO - e->tamanho;
+        size_t n = (len < livre) ? len : livre;
+
+        memcpy(&e->bloco[e->tamanho], dados, n);
+        e->tamanho += n;
+        dados      += n;
+        len        -= n;
+
+        if (e->tamanho == RELATO_BLOCO) {
+            Descarregar(e);
+        }
+    }
+}
+
+static void Emitir_Texto(Relato_Escritor_t* e, const char* texto) {
+    if (texto != NULL) {
+        Emitir(e, texto, strlen(texto));
+    }
+}
+
+static void Descarregar(Relato_Escritor_t* e) {
+    if (e->tamanho > 0U && e->saida != NULL && e->saida->escrever != NULL) {
+        e->saida->escrever(e->saida->contexto, e->bloco, e->tamanho);
+    }
+    e->tamanho = 0;
+}
 
-    uint8_t hh=0, mm=0, ss=0, dd=0, mo=0, yy=0;
-    char weekday_dummy[4];
-    RTC_Driver_GetTime(&hh, &mm, &ss);
-    RTC_Driver_GetDate(&dd, &mo, &yy, weekday_dummy);
-
-    int n = snprintf(qr_buffer, sizeof(qr_buffer),
-                     "G620_Teste_Gab\n"
-                     "===================\n\r"
-                     "Produto: %.*s\n"
-										 "Umidade: %.*f %%\n"
-                     "Curva: %lu\n"
-                     "Amostra: %d\n"
-                     "Temp. instru: %.1f C\n"
-                     "Peso: %.1f g\n"
-                     "Densidade: %.1f Kg/hL\n"
-										 "Validade: %s\n"
-										 "===================\n\r"
-                     "Data: %02u/%02u/%02u\n"
-                     "Hora: %02u:%02u:%02u",
-                     MAX_NOME_GRAO_LEN, grao.nome, 
-										 (int)nr_decimals, dados.Umidade,
-                     (unsigned long)grao.id_curva,
-                     4,
-                     dados.Temp_Instru,
-                     dados.Peso,
-                     dados.Densidade,
-										 grao.validade,
-                     dd, mo, yy,
-                     hh, mm, ss);
+// Percorre o modelo: texto fixo, campo alinhado  direita e sufixo
+static void Renderizar(Relato_Escritor_t* e, const Relato_Linha_t* linhas, uint8_t num_linhas,
+                       const Relato_Valores_t* v) {
+    static const char espacos[RELATO_CAMPO_MAX] = "                        ";
+    char campo[RELATO_CAMPO_MAX];
+
+    for (uint8_t i = 0; i < num_linhas; i++) {
+        const Relato_Linha_t* l = &linhas[i];
+        Emitir_Texto(e, l->prefixo);
+
+        if (l->campo != CAMPO_NENHUM) {
+            size_t n = Formatar_Campo(campo, l->campo, v);
+            if (l->largura > n) {
+                Emitir(e, espacos, l->largura - n);
+            }
+            Emitir(e, campo, n);
+        }
+
+        Emitir_Texto(e, l->sufixo);
+    }
+}
+
+// ============================================================
+// Funes Pblicas (Sadas)
+// ============================================================
+
+// Sada para o FIFO do CLI (descarta se o USB CDC no estiver pronto)
+void Relato_Saida_CLI(void* contexto, const char* dados, size_t len) {
+    (void)contexto;
+    (void)CLI_Write(dados, len);
+}
+
+// Sada para memria: trunca no fim do buffer e mantm o terminador
+void Relato_Saida_Buffer(void* contexto, const char* dados, size_t len) {
+    Relato_Buffer_t* b = (Relato_Buffer_t*)contexto;
+    if (b == NULL || b->buf == NULL || b->capacidade == 0U) {
+        return;
+    }
+
+    size_t livre = (b->capacidade - 1U) - b->tamanho;
+    if (len > livre) {
+        len = livre;
+    }
+    memcpy(&b->buf[b->tamanho], dados, len);
+    b->tamanho += len;
+    b->buf[b->tamanho] = '\0';
+}
+
+// ============================================================
+// Funes Pblicas
+// ============================================================
+
+// Gera um relatrio inteiro em uma passada (valores lidos uma vez, sem stdio)
+void Relatorio_Gerar(Relato_Tipo_t tipo, const Relato_Saida_t* saida) {
+    Relato_Valores_t  valores;
+    Relato_Escritor_t escritor;
+
+    escritor.saida   = saida;
+    escritor.tamanho = 0;
+    Coletar_Valores(&valores);
+
+    switch (tipo) {
+        case RELATO_WHO_AM_I:
+            Renderizar(&escritor, s_modelo_who_am_i, NUM_LINHAS(s_modelo_who_am_i), &valores);
+            break;
+        case RELATO_MEDICAO:
+            Renderizar(&escritor, s_modelo_cabecalho, NUM_LINHAS(s_modelo_cabecalho), &valores);
+            Renderizar(&escritor, s_modelo_medicao, NUM_LINHAS(s_modelo_medicao), &valores);
+            Renderizar(&escritor, s_modelo_assinatura, NUM_LINHAS(s_modelo_assinatura), &valores);
+            break;
+        case RELATO_QRCODE:
+            Renderizar(&escritor, s_modelo_qrcode, NUM_LINHAS(s_modelo_qrcode), &valores);
+            break;
+        case RELATO_CABECALHO:
+            Renderizar(&escritor, s_modelo_cabecalho, NUM_LINHAS(s_modelo_cabecalho), &valores);
+            break;
+        case RELATO_ASSINATURA:
+            Renderizar(&escritor, s_modelo_assinatura, NUM_LINHAS(s_modelo_assinatura), &valores);
+            break;
+        default:
+            break;
+    }
+
+    Descarregar(&escritor);
+}
+
+// Imprime informaes de identificao do dispositivo (CLI/Impressora)
+void Who_am_i(void) {
+    Relatorio_Gerar(RELATO_WHO_AM_I, &RELATO_SAIDA_CLI);
+}
+
+// Gera e envia o relatrio formatado para a impressora
+void Relatorio_Printer (void) {
+    Relatorio_Gerar(RELATO_MEDICAO, &RELATO_SAIDA_CLI);
+}
+
+// Gera a string formatada para o QR Code e a envia ao display
+void Relatorio_QRCode_WhoAmI(void) {
+    Relato_Buffer_t buffer = { qr_buffer, sizeof(qr_buffer), 0 };
+    const Relato_Saida_t saida = { Relato_Saida_Buffer, &buffer };
+
+    qr_buffer[0] = '\0';
+    Relatorio_Gerar(RELATO_QRCODE, &saida);
 
     DWIN_Driver_WriteString(RESULTADO_MEDIDA, qr_buffer, sizeof(qr_buffer));
 }
@@ -141,30 +472,10 @@ void Relatorio_QRCode_WhoAmI(void) {
 
 // Imprime o cabealho do relatrio
 void Cabecalho(void) {
-    char serial[17] = {0};
-    Gerenciador_Config_Get_Serial(serial, sizeof(serial));
-
-    printf(Dupla);
-		printf("GEHAKA            G620_Teste_Gab\n\r");
-    printf(Linha);
-		printf("Versao Firmware= %15s\n\r", FIRMWARE);
-		printf("Numero de Serie= %15s\n\r", serial);
-    printf(Linha);
+    Relatorio_Gerar(RELATO_CABECALHO, &RELATO_SAIDA_CLI);
 }
 
 // Imprime o rodap com data e responsvel
 void Assinatura(void) {
-    uint8_t hours, minutes, seconds;
-    uint8_t day, month, year;
-    char weekday_dummy[4];
-
-    printf("\n\r\n\r");
-    printf(Linha);
-    if (RTC_Driver_GetTime(&hours, &minutes, &seconds)) {
-        printf("Assinatura              %02d:%02d:%02d\n\r", hours, minutes, seconds);
-    }
-    if (RTC_Driver_GetDate(&day, &month, &year, weekday_dummy)) {
-        printf("Responsavel             %02d/%02d/%02d\n\r", day, month, year);
-    }
-    printf ("\n\r\n\r\n\r\n\r");
-}
\ No newline at end of file
+    Relatorio_Gerar(RELATO_ASSINATURA, &RELATO_SAIDA_CLI);
+}
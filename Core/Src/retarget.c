@@ -10,7 +10,6 @@
 
 #include "retarget.h"
 #include "cli_driver.h"
-#include "ux_device_cdc_acm.h"
 #include <stdio.h>
 
 // ============================================================
@@ -19,9 +18,6 @@
 
 RetargetDestination_t g_retarget_dest = TARGET_DEBUG;
 
-// Instncia CDC-ACM fornecida pelo USBX
-extern UX_SLAVE_CLASS_CDC_ACM *cdc_acm;
-
 // ============================================================
 // Funes Pblicas
 // ============================================================
@@ -37,11 +33,6 @@ void Retarget_Init(UART_HandleTypeDef* debug_huart, UART_HandleTypeDef* dwin_hua
 // Funes Privadas (Helpers)
 // ============================================================
 
-// Verifica se a classe CDC-ACM (USB) est pronta
-static inline bool usb_cdc_ready(void) {
-    return (cdc_acm != NULL);
-}
-
 // Envia um bloco de dados para o destino selecionado (principalmente CLI/USB)
 static int retarget_write_block(const char *ptr, int len) {
     if (len <= 0 || ptr == NULL) {
@@ -51,16 +42,8 @@ static int retarget_write_block(const char *ptr, int len) {
     switch (g_retarget_dest) {
         case TARGET_DEBUG:
         default: {
-            // Se o USB CDC no est pronto, retorna imediatamente
-            if (!usb_cdc_ready()) {
-                return len;
-            }
-
-            // Enfileira byte a byte no FIFO do CLI
-            for (int i = 0; i < len; i++) {
-                char c[2] = { ptr[i], '\0' };
-                CLI_Puts(c);
-            }
+            // Cpia em bloco para o FIFO do CLI (descarta se o USB CDC no estiver pronto)
+            (void)CLI_Write(ptr, (size_t)len);
             return len;
         }
 
@@ -0,0 +1,160 @@
+/*
+ * Nome do Arquivo: ring_buffer.c
+ * Descricao: Buffer circular generico com reserva/confirmacao.
+ *            A reserva e feita numa secao critica curta (o Cortex-M0+ nao tem
+ *            LDREX/STREX); a copia dos dados acontece fora dela. O consumidor
+ *            so enxerga os dados quando todas as reservas abertas sao confirmadas.
+ * Autor: Gabriel Agune
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "ring_buffer.h"
+#include <string.h>
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Associa o buffer ao anel (tamanho deve ser potencia de 2)
+bool RingBuffer_Init(RingBuffer_t *rb, uint8_t *buf, uint32_t tamanho) {
+    if (rb == NULL || buf == NULL || tamanho == 0U || (tamanho & (tamanho - 1U)) != 0U) {
+        return false;
+    }
+    rb->buf = buf;
+    rb->mascara = tamanho - 1U;
+    RingBuffer_Limpar(rb);
+    return true;
+}
+
+// Esvazia o anel (somente sem produtores/consumidor ativos)
+void RingBuffer_Limpar(RingBuffer_t *rb) {
+    rb->head = 0;
+    rb->commit = 0;
+    rb->tail = 0;
+    rb->abertas = 0;
+}
+
+// Espaco livre para novas reservas
+uint32_t RingBuffer_Livre(const RingBuffer_t *rb) {
+    return (rb->mascara + 1U) - (rb->head - rb->tail);
+}
+
+// Bytes prontos para o consumidor
+uint32_t RingBuffer_Usado(const RingBuffer_t *rb) {
+    return rb->commit - rb->tail;
+}
+
+// Reserva ate 'tamanho' bytes; retorna quanto foi reservado
+uint32_t RingBuffer_Reservar(RingBuffer_t *rb, uint32_t tamanho, RingBuffer_Reserva_t *r) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t livre = RingBuffer_Livre(rb);
+    if (tamanho > livre) {
+        tamanho = livre;
+    }
+    r->inicio = rb->head;
+    r->tamanho = tamanho;
+    if (tamanho > 0U) {
+        rb->head += tamanho;
+        rb->abertas++;
+    }
+
+    __set_PRIMASK(primask);
+    return tamanho;
+}
+
+// Copia dados para dentro de uma reserva em ate dois trechos
+void RingBuffer_Copiar(RingBuffer_t *rb, const RingBuffer_Reserva_t *r, uint32_t offset, const void *dados, uint32_t tamanho) {
+    if (offset >= r->tamanho) {
+        return;
+    }
+    if (tamanho > r->tamanho - offset) {
+        tamanho = r->tamanho - offset;
+    }
+
+    uint32_t idx = (r->inicio + offset) & rb->mascara;
+    uint32_t ate_o_fim = (rb->mascara + 1U) - idx;
+    uint32_t trecho1 = (tamanho < ate_o_fim) ? tamanho : ate_o_fim;
+
+    memcpy(&rb->buf[idx], dados, trecho1);
+    memcpy(&rb->buf[0], (const uint8_t*)dados + trecho1, tamanho - trecho1);
+}
+
+// Confirma a reserva e publica os dados quando nao ha outras abertas
+void RingBuffer_Confirmar(RingBuffer_t *rb, const RingBuffer_Reserva_t *r, uint32_t usados) {
+    if (r->tamanho == 0U) {
+        return;
+    }
+    if (usados > r->tamanho) {
+        usados = r->tamanho;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint32_t sobra = r->tamanho - usados;
+    if (sobra > 0U) {
+        // Reservas feitas depois desta so podem ser de ISRs que a interromperam,
+        // portanto ja estao completas: desloca-as para fechar o buraco
+        for (uint32_t i = r->inicio + r->tamanho; i != rb->head; i++) {
+            rb->buf[(i - sobra) & rb->mascara] = rb->buf[i & rb->mascara];
+        }
+        rb->head -= sobra;
+    }
+
+    // Dados escritos antes de mover o commit
+    __DMB();
+    if (--rb->abertas == 0U) {
+        rb->commit = rb->head;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+// Escreve o que couber; retorna os bytes aceitos
+uint32_t RingBuffer_Escrever(RingBuffer_t *rb, const void *dados, uint32_t tamanho) {
+    RingBuffer_Reserva_t r;
+    uint32_t n = RingBuffer_Reservar(rb, tamanho, &r);
+    if (n > 0U) {
+        RingBuffer_Copiar(rb, &r, 0, dados, n);
+        RingBuffer_Confirmar(rb, &r, n);
+    }
+    return n;
+}
+
+// Escreve tudo ou nada
+bool RingBuffer_Escrever_Inteiro(RingBuffer_t *rb, const void *dados, uint32_t tamanho) {
+    RingBuffer_Reserva_t r;
+    if (RingBuffer_Reservar(rb, tamanho, &r) < tamanho) {
+        RingBuffer_Confirmar(rb, &r, 0);
+        return false;
+    }
+    RingBuffer_Copiar(rb, &r, 0, dados, tamanho);
+    RingBuffer_Confirmar(rb, &r, tamanho);
+    return true;
+}
+
+// Aponta para o maior trecho contiguo pronto a partir do tail
+uint32_t RingBuffer_Ler_Contiguo(const RingBuffer_t *rb, uint8_t **p) {
+    uint32_t idx = rb->tail & rb->mascara;
+    uint32_t disponivel = rb->commit - rb->tail;
+    uint32_t ate_o_fim = (rb->mascara + 1U) - idx;
+
+    *p = &rb->buf[idx];
+    return (disponivel < ate_o_fim) ? disponivel : ate_o_fim;
+}
+
+// Libera 'tamanho' bytes ja consumidos
+void RingBuffer_Descartar(RingBuffer_t *rb, uint32_t tamanho) {
+    uint32_t usado = RingBuffer_Usado(rb);
+    if (tamanho > usado) {
+        tamanho = usado;
+    }
+    // Leitura dos dados concluida antes de liberar o espaco
+    __DMB();
+    rb->tail += tamanho;
+}
@@ -11,13 +11,152 @@
 #include "rtc_driver.h"
 #include <string.h>
 
+// ============================================================
+// Defines e Constantes
+// ============================================================
+
+#define DIAS_1970_A_2000    10957UL     // 01/01/1970 -> 01/01/2000
+#define SEGUNDOS_POR_DIA    86400UL
+
+// Base de tempo em ms: ticks do HAL medidos a cada segundo do RTC
+#define TICKS_POR_S_NOMINAL     1000UL
+#define TICKS_POR_S_Q8_NOMINAL  (TICKS_POR_S_NOMINAL << 8)
+#define TICKS_POR_S_TOLERANCIA  50UL        // Intervalos fora de 1000 +/- 50 ticks so descartados
+#define TICKS_FILTRO_SHIFT      3U          // Mdia mvel exponencial de 1/8
+#define MS_MAX_NO_SEGUNDO       999UL       // A interpolao nunca passa do prximo segundo do RTC
+#define DELTA_TICKS_MAX         2000UL      // Limite antes da multiplicao (evita estouro)
+
+// Dias acumulados antes de cada ms (ano no bissexto)
+static const uint16_t s_dias_antes_do_mes[12] = {
+    0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334
+};
+
 // ============================================================
 // Variveis Estticas do Mdulo
 // ============================================================
 
 // Ponteiro esttico para o handle do HAL RTC
-static RTC_HandleTypeDef* s_hrtc             = NULL;
-static uint32_t           s_last_update_tick = 0;
+static RTC_HandleTypeDef* s_hrtc = NULL;
+
+// Calendrio atualizado uma vez por segundo pelo Alarme A.
+// Leitura sem trava: o contador de sequncia  mpar durante a escrita
+// e o leitor repete a cpia se ele mudou no meio.
+static RTC_Calendario_t  s_calendario;
+static volatile uint32_t s_sequencia     = 0;
+static volatile uint32_t s_segundos_boot = 0;
+
+// ncora da base de tempo em ms (protegida pelo mesmo contador de sequncia)
+static uint64_t s_epoch_ms_ancora = 0;     // Epoch do segundo corrente em ms
+static uint32_t s_tick_ancora     = 0;     // HAL_GetTick() estimado na virada desse segundo
+static uint32_t s_escala_ms_q16   = 1UL << 16; // ms por tick do HAL (Q16)
+
+// Disciplina do tick (s no ISR do Alarme A)
+static uint32_t s_ticks_por_s_q8      = TICKS_POR_S_Q8_NOMINAL;
+static uint32_t s_tick_ultimo_alarme  = 0;
+static uint32_t s_epoch_ultimo_alarme = 0;
+static bool     s_ultimo_alarme_valido = false;
+
+// ============================================================
+// Prottipos de Funes Privadas
+// ============================================================
+
+static uint32_t Dias_Desde_1970(uint8_t ano, uint8_t mes, uint8_t dia);
+static void     Atualizar_Calendario(bool no_alarme);
+static void     Disciplinar_Tick(uint32_t tick_ancora, uint32_t epoch_s);
+static void     Armar_Alarme_1Hz(void);
+
+// ============================================================
+// Funes Privadas
+// ============================================================
+
+// Dias corridos desde 01/01/1970 para uma data 20AA (vlida at 2099)
+static uint32_t Dias_Desde_1970(uint8_t ano, uint8_t mes, uint8_t dia) {
+    if (mes < 1 || mes > 12 || dia < 1) {
+        return DIAS_1970_A_2000;
+    }
+
+    uint32_t dias = (365UL * ano) + ((ano + 3UL) / 4UL); // 2000  bissexto
+    dias += s_dias_antes_do_mes[mes - 1];
+    if (mes > 2 && (ano % 4U) == 0U) {
+        dias++;
+    }
+    return DIAS_1970_A_2000 + dias + (dia - 1U);
+}
+
+// Mede os ticks do HAL entre dois alarmes consecutivos e recalcula a escala ms/tick
+static void Disciplinar_Tick(uint32_t tick_ancora, uint32_t epoch_s) {
+    if (s_ultimo_alarme_valido && epoch_s == s_epoch_ultimo_alarme + 1UL) {
+        const uint32_t delta = tick_ancora - s_tick_ultimo_alarme;
+
+        if (delta >= (TICKS_POR_S_NOMINAL - TICKS_POR_S_TOLERANCIA) &&
+            delta <= (TICKS_POR_S_NOMINAL + TICKS_POR_S_TOLERANCIA)) {
+            const int32_t erro = (int32_t)(delta << 8) - (int32_t)s_ticks_por_s_q8;
+            s_ticks_por_s_q8 = (uint32_t)((int32_t)s_ticks_por_s_q8 + (erro >> TICKS_FILTRO_SHIFT));
+            s_escala_ms_q16  = (uint32_t)(((uint64_t)TICKS_POR_S_NOMINAL << 24) / s_ticks_por_s_q8);
+        }
+    }
+
+    s_tick_ultimo_alarme   = tick_ancora;
+    s_epoch_ultimo_alarme  = epoch_s;
+    s_ultimo_alarme_valido = true;
+}
+
+// L o RTC uma nica vez e publica o calendrio e a ncora da base de tempo
+// (chamar no ISR do Alarme A ou com as interrupes desabilitadas)
+static void Atualizar_Calendario(bool no_alarme) {
+    RTC_TimeTypeDef sTime = {0};
+    RTC_DateTypeDef sDate = {0};
+
+    // GetTime trava os registradores de sombra at a leitura da data
+    if (HAL_RTC_GetTime(s_hrtc, &sTime, RTC_FORMAT_BIN) != HAL_OK ||
+        HAL_RTC_GetDate(s_hrtc, &sDate, RTC_FORMAT_BIN) != HAL_OK) {
+        return;
+    }
+    const uint32_t tick = HAL_GetTick();
+
+    const uint32_t dias    = Dias_Desde_1970(sDate.Year, sDate.Month, sDate.Date);
+    const uint32_t epoch_s = (dias * SEGUNDOS_POR_DIA) + (sTime.Hours * 3600UL) +
+                             (sTime.Minutes * 60UL) + sTime.Seconds;
+
+    // SSR desce de PREDIV_S a 0 dentro do segundo: recua o tick at a virada
+    const uint32_t frac_ms     = ((sTime.SecondFraction - sTime.SubSeconds) * 1000UL) / (sTime.SecondFraction + 1UL);
+    const uint32_t tick_ancora = tick - frac_ms;
+
+    s_sequencia++;
+    __DMB();
+    if (no_alarme) {
+        Disciplinar_Tick(tick_ancora, epoch_s);
+    } else {
+        s_ultimo_alarme_valido = false; // Ajuste de hora: o prximo intervalo no  de 1 s
+    }
+    s_calendario.hora       = sTime.Hours;
+    s_calendario.minuto     = sTime.Minutes;
+    s_calendario.segundo    = sTime.Seconds;
+    s_calendario.dia        = sDate.Date;
+    s_calendario.mes        = sDate.Month;
+    s_calendario.ano        = sDate.Year;
+    // 01/01/1970 foi quinta-feira; o dia da semana do RTC no  confivel (SETDATE no o informa)
+    s_calendario.dia_semana = (uint8_t)(((dias + 3UL) % 7UL) + RTC_WEEKDAY_MONDAY);
+    s_calendario.epoch_s    = epoch_s;
+    s_calendario.segundos_boot = s_segundos_boot;
+    s_epoch_ms_ancora = (uint64_t)epoch_s * 1000U;
+    s_tick_ancora     = tick_ancora;
+    __DMB();
+    s_sequencia++;
+}
+
+// Alarme A com todos os campos mascarados: dispara a cada virada de segundo
+// (o RTC do C0 no tem wake-up timer)
+static void Armar_Alarme_1Hz(void) {
+    RTC_AlarmTypeDef sAlarm = {0};
+    sAlarm.AlarmMask           = RTC_ALARMMASK_ALL;
+    sAlarm.AlarmSubSecondMask  = RTC_ALARMSUBSECONDMASK_ALL;
+    sAlarm.AlarmDateWeekDaySel = RTC_ALARMDATEWEEKDAYSEL_DATE;
+    sAlarm.AlarmDateWeekDay    = 1;
+    sAlarm.Alarm               = RTC_ALARM_A;
+
+    HAL_RTC_SetAlarm_IT(s_hrtc, &sAlarm, RTC_FORMAT_BIN);
+}
 
 // ============================================================
 // Funes Pblicas
@@ -33,11 +172,23 @@ void RTC_Driver_Init(RTC_HandleTypeDef* hrtc) {
 
     if (sDateCheck.Year < 24) {
         RTC_TimeTypeDef sTime = { .Hours = 0, .Minutes = 0, .Seconds = 0 };
-        RTC_DateTypeDef sDate = { .Date = 23, .Month = RTC_MONTH_OCTOBER, .Year = 25, .WeekDay = RTC_WEEKDAY_FRIDAY };
+        RTC_DateTypeDef sDate = { .Date = 23, .Month = RTC_MONTH_OCTOBER, .Year = 25, .WeekDay = RTC_WEEKDAY_THURSDAY };
 
         HAL_RTC_SetTime(s_hrtc, &sTime, RTC_FORMAT_BIN);
         HAL_RTC_SetDate(s_hrtc, &sDate, RTC_FORMAT_BIN);
     }
+
+    __disable_irq();
+    Atualizar_Calendario(false);
+    __enable_irq();
+
+    Armar_Alarme_1Hz();
+}
+
+// Chamado pelo callback do Alarme A (uma vez por segundo, contexto de interrupo)
+void RTC_Driver_Alarme_Callback(void) {
+    s_segundos_boot++;
+    Atualizar_Calendario(true);
 }
 
 // Define a data (dia, ms, ano) no RTC
@@ -46,12 +197,16 @@ bool RTC_Driver_SetDate(uint8_t day, uint8_t month, uint8_t year) {
     new_date.Date    = day;
     new_date.Month   = month;
     new_date.Year    = year;
+    new_date.WeekDay = (uint8_t)(((Dias_Desde_1970(year, month, day) + 3UL) % 7UL) + RTC_WEEKDAY_MONDAY);
 
-    if (HAL_RTC_SetDate(s_hrtc, &new_date, RTC_FORMAT_BIN) == HAL_OK) {
-        s_last_update_tick = 0;
-        return true;
+    if (HAL_RTC_SetDate(s_hrtc, &new_date, RTC_FORMAT_BIN) != HAL_OK) {
+        return false;
     }
-    return false;
+
+    __disable_irq();
+    Atualizar_Calendario(false);
+    __enable_irq();
+    return true;
 }
 
 // Define a hora (hora, minuto, segundo) no RTC
@@ -61,60 +216,173 @@ bool RTC_Driver_SetTime(uint8_t hours, uint8_t minutes, uint8_t seconds) {
     new_time.Minutes = minutes;
     new_time.Seconds = seconds;
 
-    if (HAL_RTC_SetTime(s_hrtc, &new_time, RTC_FORMAT_BIN) == HAL_OK) {
-        s_last_update_tick = 0;
-        return true;
+    if (HAL_RTC_SetTime(s_hrtc, &new_time, RTC_FORMAT_BIN) != HAL_OK) {
+        return false;
     }
-    return false;
+
+    __disable_irq();
+    Atualizar_Calendario(false);
+    __enable_irq();
+    return true;
 }
 
-// Obtm a data atual do RTC
-bool RTC_Driver_GetDate(uint8_t* day, uint8_t* month, uint8_t* year, char* weekday_str) {
-    if (s_hrtc == NULL || day == NULL || month == NULL || year == NULL || weekday_str == NULL) {
+// Copia o calendrio em cache (coerente entre data e hora, sem acesso ao RTC)
+bool RTC_Driver_Get_Calendario(RTC_Calendario_t* calendario) {
+    if (s_hrtc == NULL || calendario == NULL) {
         return false;
     }
 
-    RTC_DateTypeDef sDate = {0};
-    RTC_TimeTypeDef sTime = {0};
+    uint32_t seq;
+    do {
+        seq = s_sequencia;
+        __DMB();
+        *calendario = s_calendario;
+        __DMB();
+    } while ((seq & 1U) != 0U || seq != s_sequencia);
 
-    // Chamada necessria para destravar os registradores da data
-    HAL_RTC_GetTime(s_hrtc, &sTime, RTC_FORMAT_BIN);
+    return true;
+}
 
-    if (HAL_RTC_GetDate(s_hrtc, &sDate, RTC_FORMAT_BIN) != HAL_OK) {
-        return false;
+// Segundos desde 01/01/1970 (hora local do RTC) do ltimo segundo publicado
+uint32_t RTC_Driver_Get_Epoch(void) {
+    RTC_Calendario_t cal;
+    return RTC_Driver_Get_Calendario(&cal) ? cal.epoch_s : 0U;
+}
+
+// Epoch em ms: ncora do segundo corrente + ticks do HAL desde a virada, na escala medida
+uint64_t RTC_Driver_Get_Epoch_ms(void) {
+    uint32_t seq;
+    uint64_t epoch_ms;
+    uint32_t tick_ancora;
+    uint32_t escala_q16;
+
+    do {
+        seq = s_sequencia;
+        __DMB();
+        epoch_ms    = s_epoch_ms_ancora;
+        tick_ancora = s_tick_ancora;
+        escala_q16  = s_escala_ms_q16;
+        __DMB();
+    } while ((seq & 1U) != 0U || seq != s_sequencia);
+
+    // Sem o alarme (atrasado ou parado) o tempo para no fim do segundo: o RTC  a referncia
+    uint32_t delta = HAL_GetTick() - tick_ancora;
+    if (delta > DELTA_TICKS_MAX) {
+        delta = DELTA_TICKS_MAX;
+    }
+    uint32_t ms = (delta * escala_q16) >> 16;
+    if (ms > MS_MAX_NO_SEGUNDO) {
+        ms = MS_MAX_NO_SEGUNDO;
     }
 
-    *day = sDate.Date;
-    *month = sDate.Month;
-    *year = sDate.Year;
+    return epoch_ms + ms;
+}
+
+// Desvio do tick do HAL em relao ao RTC (ppm, positivo = tick adiantado)
+int32_t RTC_Driver_Get_Desvio_Tick_ppm(void) {
+    const int32_t erro_q8 = (int32_t)s_ticks_por_s_q8 - (int32_t)TICKS_POR_S_Q8_NOMINAL;
+    return (erro_q8 * 125) / 32; // erro_q8 * 1e6 / 256000
+}
 
-    switch (sDate.WeekDay) {
-        case RTC_WEEKDAY_MONDAY:    strcpy(weekday_str, "SEG"); break;
-        case RTC_WEEKDAY_TUESDAY:   strcpy(weekday_str, "TER"); break;
-        case RTC_WEEKDAY_WEDNESDAY: strcpy(weekday_str, "QUA"); break;
-        case RTC_WEEKDAY_THURSDAY:  strcpy(weekday_str, "QUI"); break;
-        case RTC_WEEKDAY_FRIDAY:    strcpy(weekday_str, "SEX"); break;
-        case RTC_WEEKDAY_SATURDAY:  strcpy(weekday_str, "SAB"); break;
-        case RTC_WEEKDAY_SUNDAY:    strcpy(weekday_str, "DOM"); break;
-        default:                    strcpy(weekday_str, "---"); break;
+// Converte segundos desde 01/01/1970 (2000..2099) para data e hora
+void RTC_Driver_Epoch_Para_Calendario(uint32_t epoch_s, RTC_Calendario_t* calendario) {
+    if (calendario == NULL) {
+        return;
     }
 
-    return true;
+    uint32_t dias     = epoch_s / SEGUNDOS_POR_DIA;
+    uint32_t segundos = epoch_s - (dias * SEGUNDOS_POR_DIA);
+
+    memset(calendario, 0, sizeof(RTC_Calendario_t));
+    calendario->epoch_s    = epoch_s;
+    calendario->dia_semana = (uint8_t)(((dias + 3UL) % 7UL) + RTC_WEEKDAY_MONDAY);
+    calendario->hora       = (uint8_t)(segundos / 3600UL);
+    segundos              -= calendario->hora * 3600UL;
+    calendario->minuto     = (uint8_t)(segundos / 60UL);
+    calendario->segundo    = (uint8_t)(segundos - (calendario->minuto * 60UL));
+
+    dias = (dias > DIAS_1970_A_2000) ? (dias - DIAS_1970_A_2000) : 0UL;
+
+    uint32_t ano = dias / 365UL;
+    while (ano > 0UL && ((365UL * ano) + ((ano + 3UL) / 4UL)) > dias) {
+        ano--;
+    }
+    dias -= (365UL * ano) + ((ano + 3UL) / 4UL);
+
+    const bool bissexto = (ano % 4UL) == 0UL;
+    uint32_t mes = 12UL;
+    while (mes > 1UL && (s_dias_antes_do_mes[mes - 1UL] + ((bissexto && mes > 2UL) ? 1UL : 0UL)) > dias) {
+        mes--;
+    }
+    dias -= s_dias_antes_do_mes[mes - 1UL] + ((bissexto && mes > 2UL) ? 1UL : 0UL);
+
+    calendario->ano = (uint8_t)ano;
+    calendario->mes = (uint8_t)mes;
+    calendario->dia = (uint8_t)(dias + 1UL);
 }
 
-// Obtm a hora atual do RTC
-bool RTC_Driver_GetTime(uint8_t* hours, uint8_t* minutes, uint8_t* seconds) {
-    if (!hours || !minutes || !seconds) {
+// Monta os bytes do VP_DATA_HORA do DWIN (AA MM DD sem HH MM SS 00)
+void RTC_Driver_Calendario_Para_DWIN(const RTC_Calendario_t* calendario, uint8_t* dwin) {
+    if (calendario == NULL || dwin == NULL) {
+        return;
+    }
+
+    dwin[0] = calendario->ano;
+    dwin[1] = calendario->mes;
+    dwin[2] = calendario->dia;
+    dwin[3] = RTC_DWIN_BYTE_SEMANA;
+    dwin[4] = calendario->hora;
+    dwin[5] = calendario->minuto;
+    dwin[6] = calendario->segundo;
+    dwin[7] = 0x00;
+}
+
+// Converte um carimbo em ms para o formato VP_DATA_HORA do DWIN
+void RTC_Driver_Epoch_ms_Para_DWIN(uint64_t epoch_ms, uint8_t* dwin) {
+    RTC_Calendario_t cal;
+    RTC_Driver_Epoch_Para_Calendario((uint32_t)(epoch_ms / 1000U), &cal);
+    RTC_Driver_Calendario_Para_DWIN(&cal, dwin);
+}
+
+// Nome abreviado do dia da semana (formato RTC_WEEKDAY_x)
+const char* RTC_Driver_Nome_Dia_Semana(uint8_t dia_semana) {
+    switch (dia_semana) {
+        case RTC_WEEKDAY_MONDAY:    return "SEG";
+        case RTC_WEEKDAY_TUESDAY:   return "TER";
+        case RTC_WEEKDAY_WEDNESDAY: return "QUA";
+        case RTC_WEEKDAY_THURSDAY:  return "QUI";
+        case RTC_WEEKDAY_FRIDAY:    return "SEX";
+        case RTC_WEEKDAY_SATURDAY:  return "SAB";
+        case RTC_WEEKDAY_SUNDAY:    return "DOM";
+        default:                    return "---";
+    }
+}
+
+// Obtm a data atual (do cache)
+bool RTC_Driver_GetDate(uint8_t* day, uint8_t* month, uint8_t* year, char* weekday_str) {
+    RTC_Calendario_t cal;
+    if (day == NULL || month == NULL || year == NULL || weekday_str == NULL ||
+        !RTC_Driver_Get_Calendario(&cal)) {
         return false;
     }
 
-    RTC_TimeTypeDef sTime = {0};
-    if (HAL_RTC_GetTime(s_hrtc, &sTime, RTC_FORMAT_BIN) == HAL_OK) {
-        *hours   = sTime.Hours;
-        *minutes = sTime.Minutes;
-        *seconds = sTime.Seconds;
-        return true;
+    *day   = cal.dia;
+    *month = cal.mes;
+    *year  = cal.ano;
+    strcpy(weekday_str, RTC_Driver_Nome_Dia_Semana(cal.dia_semana));
+
+    return true;
+}
+
+// Obtm a hora atual (do cache)
+bool RTC_Driver_GetTime(uint8_t* hours, uint8_t* minutes, uint8_t* seconds) {
+    RTC_Calendario_t cal;
+    if (!hours || !minutes || !seconds || !RTC_Driver_Get_Calendario(&cal)) {
+        return false;
     }
 
-    return false;
-}
\ No newline at end of file
+    *hours   = cal.hora;
+    *minutes = cal.minuto;
+    *seconds = cal.segundo;
+    return true;
+}
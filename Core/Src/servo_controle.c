@@ -1,40 +1,71 @@
 /*
  * Nome do Arquivo: servo_controle.c
- * Descrio: Implementao da FSM de alto nvel para sequncia de servos
+ * Descrio: Interpretador das receitas de sequncia dos servos e motor de
+ *            movimento (rampas de ngulo atualizadas a 1 kHz no TIM14)
  * Autor: Gabriel Agune
  */
 
 #include "servo_controle.h"
 #include "pwm_servo_driver.h"
+#include "ads1232_driver.h"
 #include <stdbool.h>
+#include <stdio.h>
 
 // ============================================================
 // Defines e Constantes
 // ============================================================
 
-#define ESTADO_OCIOSO       0xFF
+#define PASSO_OCIOSO        0xFF
+#define PASSO_FIM           0xFE    // ltimo passo liberado: aguarda as rampas terminarem
 
-#define ANGULO_FECHADO      0.0f
-#define ANGULO_FUNIL_ABRE   75.0f
-#define ANGULO_SCRAP_ABRE   90.0f
+#define TIMEOUT_CONDICAO_MS 3000U   // Condio no atendida: segue a sequncia mesmo assim
+
+#define ANGULO_FECHADO      0U
+#define ANGULO_FUNIL_ABRE   75U
+#define ANGULO_SCRAP_ABRE   90U
+
+// Velocidade mxima admitida em carga (graus/s)
+#define VELOCIDADE_FUNIL_GRAUS_S    250U
+#define VELOCIDADE_SCRAP_GRAUS_S    200U
+
+// Tabelas de perfil: posio normalizada em Q15 amostrada em 32 segmentos
+#define PERFIL_SEGMENTOS_BITS   5U
+#define PERFIL_SEGMENTOS        (1UL << PERFIL_SEGMENTOS_BITS)
+#define PERFIL_PONTOS           (PERFIL_SEGMENTOS + 1U)
+#define PERFIL_UM_Q15           32768UL
+#define PERFIL_ACEL_SEGMENTOS   8U      // Trapezoidal: 1/4 acelerando, 1/2 em cruzeiro, 1/4 freando
+
+// Fase da rampa em Q24 (1.0 = fim do movimento); o ISR s soma e desloca
+#define FASE_BITS           24U
+#define FASE_FIM            (1UL << FASE_BITS)
+#define FASE_SEG_SHIFT      (FASE_BITS - PERFIL_SEGMENTOS_BITS)
+#define FASE_INTERP_SHIFT   8U
+#define FASE_FRAC_BITS      (FASE_SEG_SHIFT - FASE_INTERP_SHIFT)
+#define FASE_FRAC_MASK      ((1UL << FASE_FRAC_BITS) - 1UL)
 
 // ============================================================
 // Typedefs e Estruturas
 // ============================================================
 
-typedef void (*Funcao_Acao_t)(void);
-
+// Estado da rampa de um servo (escrito pelo Servos_Mover, avanado pelo ISR)
 typedef struct {
-    ServoStep_t     id_passo;
-    Funcao_Acao_t   acao;
-    uint32_t        duracao_ms;
-    uint8_t         indice_proximo_estado;
-} Passo_Processo_t;
+    Servo_t        *servo;
+    uint16_t        velocidade_graus_s;
+    ServoPerfil_t   perfil;
+    bool            movendo;
+    uint32_t        inicio_q8;
+    uint32_t        alvo_q8;
+    int32_t         delta_q8;
+    uint32_t        pos_q8;
+    uint32_t        fase;
+    uint32_t        passo_fase;
+} Servo_Movimento_t;
 
 // ============================================================
 // Variveis Externas
 // ============================================================
 
+extern TIM_HandleTypeDef htim14;
 extern TIM_HandleTypeDef htim16;
 extern TIM_HandleTypeDef htim17;
 
@@ -42,10 +73,14 @@ extern TIM_HandleTypeDef htim17;
 // Variveis de Estado do Mdulo
 // ============================================================
 
-static volatile uint32_t s_timer_funil           = 0;
-static volatile uint32_t s_timer_scrap           = 0;
-static volatile uint8_t  s_indice_estado_atual   = ESTADO_OCIOSO;
 static volatile uint32_t s_timer_estado_ms       = 0;
+static volatile bool     s_sequencia_concluida   = false;
+
+// Receita em execuo (cpia: um Set durante a sequncia s vale na prxima)
+static Config_Receita_Servo_t s_receita;
+static uint8_t                s_passo_atual      = PASSO_OCIOSO;
+static uint32_t               s_tick_passo       = 0;
+static uint32_t               s_amostras_balanca = 0;
 
 // Configurao dos Servos
 static Servo_t s_servo_funil = {
@@ -62,109 +97,344 @@ static Servo_t s_servo_scrap = {
     .max_pulse_us = 2400
 };
 
+static Servo_Movimento_t s_movimento[NUM_SERVOS] = {
+    [SERVO_FUNIL] = { .servo = &s_servo_funil, .velocidade_graus_s = VELOCIDADE_FUNIL_GRAUS_S },
+    [SERVO_SCRAP] = { .servo = &s_servo_scrap, .velocidade_graus_s = VELOCIDADE_SCRAP_GRAUS_S },
+};
+
+// Um trim persistido por servo
+typedef char Servos_Trims_Na_Config[(NUM_SERVOS == CONFIG_NUM_SERVOS) ? 1 : -1];
+
+// Posio normalizada (Q15) de cada perfil, montada no Init
+static uint16_t s_perfis[NUM_SERVO_PERFIS][PERFIL_PONTOS];
+
+// Velocidade de pico / velocidade mdia de cada perfil (Q8): 4/3 e 15/8
+static const uint16_t s_pico_q8[NUM_SERVO_PERFIS] = { 342, 480 };
+
 // ============================================================
 // Prottipos de Funes Privadas
 // ============================================================
 
-static void Acao_Abrir_Funil(void);
-static void Acao_Varrer_Scrap(void);
-static void Acao_Finalizar(void);
-static void Entrar_No_Estado(uint8_t indice_estado);
+static void Entrar_No_Passo(uint8_t indice);
+static bool Condicao_Atendida(const Config_Passo_Servo_t* passo);
+static uint32_t Amostras_Balanca(void);
+static void Construir_Perfis(void);
+static void Atualizar_Rampa(Servo_Movimento_t *m);
 
 // ============================================================
-// Tabela FSM (Fluxo do Processo)
+// Receita Padro (usada quando o gro aponta para uma receita no gravada)
 // ============================================================
 
-static const Passo_Processo_t s_fluxo_processo[] = {
-    // ID Passo,           Ao,               Durao (ms), Prximo ndice
-    { SERVO_STEP_FUNNEL,   Acao_Abrir_Funil,  2000,         1 },
-    { SERVO_STEP_FUNNEL,   NULL,              500,          2 },
-    { SERVO_STEP_SCRAPER,  Acao_Varrer_Scrap, 2000,         3 },
-    { SERVO_STEP_SCRAPER,  NULL,              500,          4 },
-    { SERVO_STEP_FINISHED, Acao_Finalizar,    1,            ESTADO_OCIOSO },
+// Funil em S-curva (o gro escoa sem tranco na comporta); raspador em trapzio
+// (cruzeiro em velocidade constante na varredura)
+static const Config_Receita_Servo_t s_receita_padrao = {
+    .num_passos = 4,
+    .passos = {
+        // Servo,       ngulo,            Perfil,                   Condio,                Espera (ms)
+        { SERVO_FUNIL, ANGULO_FUNIL_ABRE, SERVO_PERFIL_S_CURVA,     SERVO_COND_TEMPO,        2000 },
+        { SERVO_FUNIL, ANGULO_FECHADO,    SERVO_PERFIL_S_CURVA,     SERVO_COND_SERVO_PARADO, 500  },
+        { SERVO_SCRAP, ANGULO_SCRAP_ABRE, SERVO_PERFIL_TRAPEZOIDAL, SERVO_COND_TEMPO,        2000 },
+        { SERVO_SCRAP, ANGULO_FECHADO,    SERVO_PERFIL_TRAPEZOIDAL, SERVO_COND_SERVO_PARADO, 500  },
+    }
 };
 
-#define NUM_PASSOS_PROCESSO (sizeof(s_fluxo_processo) / sizeof(s_fluxo_processo[0]))
-
 // ============================================================
 // Funes Pblicas
 // ============================================================
 
-// Decrementa os temporizadores internos de controle dos servos (Chamar a cada 1ms)
+// Motor de movimento: avana as rampas e o temporizador do passo (update do TIM14, 1 kHz)
 void Servos_Tick_ms(void) {
+    for (uint32_t i = 0; i < NUM_SERVOS; i++) {
+        Atualizar_Rampa(&s_movimento[i]);
+    }
     if (s_timer_estado_ms > 0) s_timer_estado_ms--;
-    if (s_timer_funil > 0)     s_timer_funil--;
-    if (s_timer_scrap > 0)     s_timer_scrap--;
 }
 
-// Inicializa o mdulo de controle dos servos
+// Inicializa o mdulo de controle dos servos (l os trims: chamar aps o CRC_Service_Init)
 void Servos_Init(void) {
     PWM_Servo_Init(&s_servo_scrap);
     PWM_Servo_Init(&s_servo_funil);
-    s_indice_estado_atual = ESTADO_OCIOSO;
+    Construir_Perfis();
+
+    for (uint32_t i = 0; i < NUM_SERVOS; i++) {
+        Config_Trim_Servo_t trim;
+        if (Gerenciador_Config_Get_Trim_Servo((uint8_t)i, &trim)) {
+            PWM_Servo_Set_Trim(s_movimento[i].servo, trim.trim_min_us, trim.trim_max_us);
+        }
+        s_movimento[i].movendo = false;
+        s_movimento[i].pos_q8  = PWM_SERVO_GRAUS_Q8(ANGULO_FECHADO);
+        PWM_Servo_Set_Posicao(s_movimento[i].servo, s_movimento[i].pos_q8);
+    }
+
+    s_passo_atual = PASSO_OCIOSO;
+    s_sequencia_concluida = false;
+
+    HAL_TIM_Base_Start_IT(&htim14);
 }
 
-// Processa a mquina de estados e atualiza a posio dos servos
+// Interpretador da receita: libera o prximo passo quando a espera e a condio do atual so atendidas
 void Servos_Process(void) {
     uint32_t timer_snapshot;
 
+    if (s_passo_atual == PASSO_OCIOSO) {
+        return;
+    }
+
+    // Fim da receita: o evento s sai com todas as rampas concludas
+    if (s_passo_atual == PASSO_FIM) {
+        if (!Servos_Em_Movimento()) {
+            s_passo_atual = PASSO_OCIOSO;
+            s_sequencia_concluida = true;
+        }
+        return;
+    }
+
     __disable_irq();
     timer_snapshot = s_timer_estado_ms;
     __enable_irq();
 
-    // Transio de Estado: Se no est ocioso e o timer zerou
-    if (s_indice_estado_atual != ESTADO_OCIOSO && timer_snapshot == 0) {
-        uint8_t proximo_indice = s_fluxo_processo[s_indice_estado_atual].indice_proximo_estado;
-        Entrar_No_Estado(proximo_indice);
+    if (timer_snapshot > 0) {
+        return;
+    }
+
+    const Config_Passo_Servo_t* passo = &s_receita.passos[s_passo_atual];
+    if (!Condicao_Atendida(passo)) {
+        if (HAL_GetTick() - s_tick_passo < (uint32_t)passo->espera_ms + TIMEOUT_CONDICAO_MS) {
+            return;
+        }
+        printf("SERVOS: Condicao %u do passo %u nao atendida, seguindo\r\n", passo->condicao, s_passo_atual);
     }
 
-    // Atualiza a posio dos servos (sempre no Process)
-    PWM_Servo_SetAngle(&s_servo_funil, (s_timer_funil > 0) ? ANGULO_FUNIL_ABRE : ANGULO_FECHADO);
-    PWM_Servo_SetAngle(&s_servo_scrap, (s_timer_scrap > 0) ? ANGULO_SCRAP_ABRE : ANGULO_FECHADO);
+    Entrar_No_Passo((uint8_t)(s_passo_atual + 1U));
 }
 
-// Inicia a sequncia de movimento dos servos
+// Inicia a sequncia do gro ativo (receita da EEPROM ou a padro do firmware)
 void Servos_Start_Sequence(void) {
-    if (s_indice_estado_atual == ESTADO_OCIOSO) {
-        Entrar_No_Estado(0);
+    if (s_passo_atual != PASSO_OCIOSO) {
+        return;
+    }
+
+    uint8_t indice_grao = 0;
+    Config_Grao_t grao;
+    uint8_t id_receita = 0;
+
+    Gerenciador_Config_Get_Grao_Ativo(&indice_grao);
+    if (Gerenciador_Config_Get_Dados_Grao(indice_grao, &grao) && grao.id_sequencia < SEQ_NUM_RECEITAS) {
+        id_receita = grao.id_sequencia;
+    }
+    Servos_Get_Receita(id_receita, &s_receita);
+
+    s_sequencia_concluida = false;
+    Entrar_No_Passo(0);
+}
+
+// Receita efetiva de um id: a gravada na EEPROM ou a padro do firmware
+void Servos_Get_Receita(uint8_t id, Config_Receita_Servo_t* receita) {
+    if (receita == NULL) {
+        return;
+    }
+    if (!Gerenciador_Config_Get_Receita_Servo(id, receita)) {
+        *receita = s_receita_padrao;
     }
 }
 
+// Inicia uma rampa do ngulo atual at o alvo (graus) com o perfil escolhido
+void Servos_Mover(ServoId_t id, uint8_t angulo, ServoPerfil_t perfil) {
+    if (id >= NUM_SERVOS || perfil >= NUM_SERVO_PERFIS) {
+        return;
+    }
+    if (angulo > PWM_SERVO_ANGULO_MAX) {
+        angulo = PWM_SERVO_ANGULO_MAX;
+    }
+
+    Servo_Movimento_t *m = &s_movimento[id];
+    uint32_t alvo_q8 = PWM_SERVO_GRAUS_Q8(angulo);
+    uint32_t inicio_q8;
+
+    // Congela a rampa atual: o novo movimento parte de onde o servo est
+    __disable_irq();
+    m->movendo = false;
+    inicio_q8  = m->pos_q8;
+    __enable_irq();
+
+    uint32_t distancia_q8 = (alvo_q8 > inicio_q8) ? (alvo_q8 - inicio_q8) : (inicio_q8 - alvo_q8);
+    if (distancia_q8 == 0U) {
+        return;
+    }
+
+    // Durao tal que a velocidade de pico do perfil no passe da velocidade do servo
+    uint64_t denominador = (uint64_t)m->velocidade_graus_s << (PWM_SERVO_FRAC_BITS + 8U);
+    uint32_t duracao_ms  = (uint32_t)(((uint64_t)distancia_q8 * s_pico_q8[perfil] * 1000U +
+                                       denominador - 1U) / denominador);
+    if (duracao_ms == 0U) {
+        duracao_ms = 1U;
+    }
+
+    __disable_irq();
+    m->perfil     = perfil;
+    m->inicio_q8  = inicio_q8;
+    m->alvo_q8    = alvo_q8;
+    m->delta_q8   = (int32_t)alvo_q8 - (int32_t)inicio_q8;
+    m->fase       = 0;
+    m->passo_fase = FASE_FIM / duracao_ms;
+    m->movendo    = true;
+    __enable_irq();
+}
+
+// Indica se algum servo ainda est em rampa
+bool Servos_Em_Movimento(void) {
+    bool movendo = false;
+
+    __disable_irq();
+    for (uint32_t i = 0; i < NUM_SERVOS; i++) {
+        movendo = movendo || s_movimento[i].movendo;
+    }
+    __enable_irq();
+
+    return movendo;
+}
+
+// Aplica e persiste o trim de calibrao de um servo (reposiciona no ngulo atual)
+bool Servos_Set_Trim(ServoId_t id, int16_t trim_min_us, int16_t trim_max_us) {
+    if (id >= NUM_SERVOS) {
+        return false;
+    }
+
+    Servo_Movimento_t *m = &s_movimento[id];
+    PWM_Servo_Set_Trim(m->servo, trim_min_us, trim_max_us);
+
+    __disable_irq();
+    if (!m->movendo) {
+        PWM_Servo_Set_Posicao(m->servo, m->pos_q8);
+    }
+    __enable_irq();
+
+    Config_Trim_Servo_t trim = { .trim_min_us = trim_min_us, .trim_max_us = trim_max_us };
+    return Gerenciador_Config_Set_Trim_Servo((uint8_t)id, &trim);
+}
+
+// Trim em uso de um servo
+bool Servos_Get_Trim(ServoId_t id, int16_t* trim_min_us, int16_t* trim_max_us) {
+    if (id >= NUM_SERVOS || trim_min_us == NULL || trim_max_us == NULL) {
+        return false;
+    }
+    *trim_min_us = s_movimento[id].servo->trim_min_us;
+    *trim_max_us = s_movimento[id].servo->trim_max_us;
+    return true;
+}
+
+// Evento de fim de sequncia para a FSM de medio (retorna true uma nica vez)
+bool Servos_Sequencia_Concluida(void) {
+    if (!s_sequencia_concluida) {
+        return false;
+    }
+    s_sequencia_concluida = false;
+    return true;
+}
+
 // ============================================================
 // Funes Privadas
 // ============================================================
 
-// Gerencia a transio para um novo estado da FSM
-static void Entrar_No_Estado(uint8_t indice_estado) {
-    if (indice_estado >= NUM_PASSOS_PROCESSO) {
-        s_indice_estado_atual = ESTADO_OCIOSO;
+// Inicia o passo: dispara a rampa (se houver servo) e arma a espera mnima
+static void Entrar_No_Passo(uint8_t indice) {
+    if (indice >= s_receita.num_passos || indice >= SEQ_MAX_PASSOS) {
+        s_passo_atual = PASSO_FIM;
         return;
     }
 
-    s_indice_estado_atual = indice_estado;
-    const Passo_Processo_t* passo = &s_fluxo_processo[indice_estado];
+    const Config_Passo_Servo_t* passo = &s_receita.passos[indice];
+    s_passo_atual      = indice;
+    s_tick_passo       = HAL_GetTick();
+    s_amostras_balanca = Amostras_Balanca();
 
-    if (passo->acao != NULL) {
-        passo->acao();
+    if (passo->servo < NUM_SERVOS) {
+        Servos_Mover((ServoId_t)passo->servo, passo->angulo,
+                     (passo->perfil < NUM_SERVO_PERFIS) ? (ServoPerfil_t)passo->perfil : SERVO_PERFIL_S_CURVA);
     }
 
-    s_timer_estado_ms = passo->duracao_ms;
+    __disable_irq();
+    s_timer_estado_ms = passo->espera_ms;
+    __enable_irq();
+}
 
-    if (passo->id_passo == SERVO_STEP_FINISHED) {
-        // Lgica de finalizao aqui
+// Avalia a condio do passo (condio desconhecida vale como s tempo)
+static bool Condicao_Atendida(const Config_Passo_Servo_t* passo) {
+    switch (passo->condicao) {
+        case SERVO_COND_SERVO_PARADO:
+            if (passo->servo < NUM_SERVOS) {
+                bool movendo;
+                __disable_irq();
+                movendo = s_movimento[passo->servo].movendo;
+                __enable_irq();
+                return !movendo;
+            }
+            return !Servos_Em_Movimento();
+        case SERVO_COND_TODOS_PARADOS:
+            return !Servos_Em_Movimento();
+        case SERVO_COND_BALANCA:
+            return Amostras_Balanca() != s_amostras_balanca;
+        default:
+            return true;
     }
 }
 
-// Ao: Inicia o timer para manter o funil aberto
-static void Acao_Abrir_Funil(void) {
-    s_timer_funil = 2000;
+// Contador de converses do ADS1232 (no consome o aviso de dado novo da medio)
+static uint32_t Amostras_Balanca(void) {
+    uint32_t contador = 0;
+    ADS1232_GetLastRaw(NULL, &contador);
+    return contador;
 }
 
-// Ao: Inicia o timer para manter o scrap (raspador) varrendo
-static void Acao_Varrer_Scrap(void) {
-    s_timer_scrap = 2000;
+// Monta as tabelas de posio normalizada (s inteiros; roda uma vez no Init)
+static void Construir_Perfis(void) {
+    const uint32_t n = PERFIL_SEGMENTOS;
+    const uint32_t a = PERFIL_ACEL_SEGMENTOS;
+
+    // Trapezoidal: parbola na acelerao, reta no cruzeiro, parbola espelhada na frenagem
+    const uint32_t den_trap = 2U * a * (n - a);
+    // S-curva: 10u^3 - 15u^4 + 6u^5 (velocidade e acelerao nulas nas pontas)
+    const uint64_t den_s = (uint64_t)n * n * n * n * n;
+
+    for (uint32_t i = 0; i < PERFIL_PONTOS; i++) {
+        uint32_t num_trap;
+        if (i <= a) {
+            num_trap = i * i;
+        } else if (i < (n - a)) {
+            num_trap = a * ((2U * i) - a);
+        } else {
+            num_trap = den_trap - ((n - i) * (n - i));
+        }
+        s_perfis[SERVO_PERFIL_TRAPEZOIDAL][i] =
+            (uint16_t)(((num_trap * PERFIL_UM_Q15) + (den_trap / 2U)) / den_trap);
+
+        uint64_t i3    = (uint64_t)i * i * i;
+        uint64_t num_s = (10U * i3 * n * n) - (15U * i3 * i * n) + (6U * i3 * i * i);
+        s_perfis[SERVO_PERFIL_S_CURVA][i] =
+            (uint16_t)(((num_s * PERFIL_UM_Q15) + (den_s / 2U)) / den_s);
+    }
 }
 
-// Ao: Nenhuma (Finalizao)
-static void Acao_Finalizar(void) {
-}
\ No newline at end of file
+// Avana uma rampa em 1 ms: consulta a tabela do perfil e escreve o CCR (contexto de ISR)
+static void Atualizar_Rampa(Servo_Movimento_t *m) {
+    if (!m->movendo) {
+        return;
+    }
+
+    m->fase += m->passo_fase;
+
+    if (m->fase >= FASE_FIM) {
+        m->pos_q8  = m->alvo_q8;
+        m->movendo = false;
+    } else {
+        const uint16_t *tabela = s_perfis[m->perfil];
+        uint32_t indice = m->fase >> FASE_SEG_SHIFT;
+        uint32_t frac   = (m->fase >> FASE_INTERP_SHIFT) & FASE_FRAC_MASK;
+        uint32_t q15    = tabela[indice] +
+                          (((uint32_t)(tabela[indice + 1U] - tabela[indice]) * frac) >> FASE_FRAC_BITS);
+
+        m->pos_q8 = (uint32_t)((int32_t)m->inicio_q8 + ((m->delta_q8 * (int32_t)q15) / (int32_t)PERFIL_UM_Q15));
+    }
+
+    PWM_Servo_Set_Posicao(m->servo, m->pos_q8);
+}
@@ -26,6 +26,8 @@
 #include "dwin_driver.h"
 #include "bq_soc.h"
 #include "ads1232_driver.h"
+#include "servo_controle.h"
+#include "rtc_driver.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -60,6 +62,7 @@
 
 /* External variables --------------------------------------------------------*/
 extern I2C_HandleTypeDef hi2c1;
+extern RTC_HandleTypeDef hrtc;
 extern TIM_HandleTypeDef htim14;
 extern UART_HandleTypeDef huart2;
 extern PCD_HandleTypeDef hpcd_USB_DRD_FS;
@@ -147,6 +150,20 @@ void SysTick_Handler(void)
 /* please refer to the startup file (startup_stm32c0xx.s).                    */
 /******************************************************************************/
 
+/**
+  * @brief This function handles RTC interrupt through EXTI lines 19 and 21.
+  */
+void RTC_IRQHandler(void)
+{
+  /* USER CODE BEGIN RTC_IRQn 0 */
+
+  /* USER CODE END RTC_IRQn 0 */
+  HAL_RTC_AlarmIRQHandler(&hrtc);
+  /* USER CODE BEGIN RTC_IRQn 1 */
+
+  /* USER CODE END RTC_IRQn 1 */
+}
+
 /**
   * @brief This function handles EXTI line 4 to 15 interrupts.
   */
@@ -155,6 +172,7 @@ void EXTI4_15_IRQHandler(void)
   /* USER CODE BEGIN EXTI4_15_IRQn 0 */
 
   /* USER CODE END EXTI4_15_IRQn 0 */
+  HAL_GPIO_EXTI_IRQHandler(FAIL_INT_Pin);
   HAL_GPIO_EXTI_IRQHandler(SINAL_DISPLAY_Pin);
   /* USER CODE BEGIN EXTI4_15_IRQn 1 */
   HAL_GPIO_EXTI_IRQHandler(AD_DOUT_BAL_Pin);
@@ -243,6 +261,28 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
     }
 }
 
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    if (huart->Instance == USART2) // transmissão do DWIN por interrupção
+    {
+        DWIN_Driver_HandleTxCplt(huart);
+    }
+}
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+    if (htim->Instance == TIM14) // Base de 1 ms do motor de movimento dos servos
+    {
+        Servos_Tick_ms();
+    }
+}
+
+void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef *hrtc)
+{
+    (void)hrtc;
+    RTC_Driver_Alarme_Callback(); // Alarme A a cada segundo: atualiza o calendário em cache
+}
+
 void HAL_GPIO_EXTI_Falling_Callback(uint16_t GPIO_Pin)
 {
     // Verifica se a interrupção veio do pino de dados prontos da balança
@@ -250,6 +290,10 @@ void HAL_GPIO_EXTI_Falling_Callback(uint16_t GPIO_Pin)
     {
         Drv_ADS1232_DRDY_Callback(); // Chame a sua função de tratamento
     }
+    else if (GPIO_Pin == FAIL_INT_Pin) // INT do BQ25622 (PB4): pulso ativo em nível baixo
+    {
+        bq_soc_int_callback();
+    }
 }
 
 // Callback genérico para outras interrupções (como a de Rising do toque)
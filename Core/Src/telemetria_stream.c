@@ -0,0 +1,173 @@
+/*
+ * Nome do Arquivo: telemetria_stream.c
+ * Descricao: Streaming binario de telemetria pela USB CDC. Cada registro e
+ *            montado direto em bytes, protegido por CRC-16/MODBUS (periferico
+ *            CRC) e enfileirado inteiro no FIFO do CLI; sem espaco, o registro
+ *            e descartado e contado (a sequencia permite detectar a lacuna).
+ * Autor: Gabriel Agune
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "telemetria_stream.h"
+#include "cli_driver.h"
+#include "crc_service.h"
+#include "ads1232_driver.h"
+#include "pcb_frequency.h"
+#include "medicao_handler.h"
+#include "main.h"
+
+// ============================================================
+// Variaveis Estaticas
+// ============================================================
+
+static struct {
+    bool     ativo;
+    uint16_t periodo_ms;
+    uint32_t ultimo_tick;
+    uint16_t sequencia;
+    uint32_t ultimo_ads_contador;
+    uint32_t descartados_total;
+    uint8_t  descartados_pendentes;  // Reportados no proximo registro enviado
+} s_stream;
+
+// ============================================================
+// Prototipos de Funcoes Privadas
+// ============================================================
+
+static uint8_t* Put_U16(uint8_t *p, uint16_t v);
+static uint8_t* Put_U32(uint8_t *p, uint32_t v);
+static void     Emitir_Registro(void);
+
+// ============================================================
+// Funcoes Privadas
+// ============================================================
+
+static uint8_t* Put_U16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)(v & 0xFFU);
+    p[1] = (uint8_t)(v >> 8);
+    return p + 2;
+}
+
+static uint8_t* Put_U32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v & 0xFFU);
+    p[1] = (uint8_t)((v >> 8) & 0xFFU);
+    p[2] = (uint8_t)((v >> 16) & 0xFFU);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+// Monta e enfileira um registro com os valores brutos mais recentes
+static void Emitir_Registro(void) {
+    uint8_t frame[TELEMETRIA_FRAME_SIZE];
+    uint8_t *p = frame;
+
+    int32_t  ads_raw = 0;
+    uint32_t ads_contador = 0;
+    ADS1232_GetLastRaw(&ads_raw, &ads_contador);
+
+    DadosMedicao_t dados;
+    Medicao_Get_UltimaMedicao(&dados);
+
+    uint8_t flags = 0;
+    if (ads_contador != s_stream.ultimo_ads_contador) {
+        flags |= TELEMETRIA_FLAG_NOVA_AMOSTRA;
+    }
+
+    *p++ = TELEMETRIA_SYNC1;
+    *p++ = TELEMETRIA_SYNC2;
+    *p++ = TELEMETRIA_TIPO_AMOSTRA;
+    *p++ = TELEMETRIA_PAYLOAD_SIZE;
+    p = Put_U16(p, s_stream.sequencia);
+    p = Put_U32(p, HAL_GetTick());
+    p = Put_U32(p, (uint32_t)ads_raw);
+    p = Put_U16(p, (uint16_t)ads_contador);
+    p = Put_U32(p, Frequency_Get_Pulse_Count());
+    p = Put_U16(p, (uint16_t)(int16_t)(dados.Temp_Instru * 100.0f));
+    *p++ = s_stream.descartados_pendentes;
+    *p++ = flags;
+
+    uint16_t crc = (uint16_t)CRC_Service_Calcular(CRC_SERVICE_CRC16_MODBUS, &frame[2], (uint32_t)(p - &frame[2]));
+    p = Put_U16(p, crc);
+
+    s_stream.sequencia++;
+
+    if (CLI_Write_Frame(frame, (size_t)(p - frame))) {
+        s_stream.ultimo_ads_contador = ads_contador;
+        s_stream.descartados_pendentes = 0;
+    } else {
+        s_stream.descartados_total++;
+        if (s_stream.descartados_pendentes < 0xFFU) {
+            s_stream.descartados_pendentes++;
+        }
+    }
+}
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Inicia o streaming na taxa pedida; retorna a taxa efetiva
+uint16_t Telemetria_Stream_Iniciar(uint16_t taxa_hz) {
+    if (taxa_hz == 0U) {
+        taxa_hz = TELEMETRIA_TAXA_PADRAO_HZ;
+    }
+    if (taxa_hz > TELEMETRIA_TAXA_MAX_HZ) {
+        taxa_hz = TELEMETRIA_TAXA_MAX_HZ;
+    }
+
+    // A balanca precisa estar ligada para gerar amostras brutas
+    Medicao_Start_Balanca();
+
+    s_stream.periodo_ms = (uint16_t)(1000U / taxa_hz);
+    s_stream.ultimo_tick = HAL_GetTick();
+    s_stream.sequencia = 0;
+    s_stream.descartados_total = 0;
+    s_stream.descartados_pendentes = 0;
+    s_stream.ativo = true;
+
+    return (uint16_t)(1000U / s_stream.periodo_ms);
+}
+
+// Encerra o streaming
+void Telemetria_Stream_Parar(void) {
+    s_stream.ativo = false;
+}
+
+// Indica se o streaming esta ativo
+bool Telemetria_Stream_Ativo(void) {
+    return s_stream.ativo;
+}
+
+// Total de registros descartados desde o ultimo inicio
+uint32_t Telemetria_Stream_Descartados(void) {
+    return s_stream.descartados_total;
+}
+
+// Emite registros no ritmo configurado (tarefa de 1 ms do scheduler)
+void Telemetria_Stream_Process(void) {
+    if (!s_stream.ativo) {
+        return;
+    }
+    if (!CLI_Is_USB_Connected()) {
+        s_stream.ativo = false;
+        return;
+    }
+
+    // Le o ADS1232 assim que o DRDY chegar, sem esperar a tarefa de medicao (50 ms)
+    ADS1232_Process();
+
+    uint32_t agora = HAL_GetTick();
+    if ((agora - s_stream.ultimo_tick) < s_stream.periodo_ms) {
+        return;
+    }
+    // Avanca pelo periodo (sem acumular atraso); atrasos longos nao geram rajadas
+    s_stream.ultimo_tick += s_stream.periodo_ms;
+    if ((agora - s_stream.ultimo_tick) >= s_stream.periodo_ms) {
+        s_stream.ultimo_tick = agora;
+    }
+
+    Emitir_Registro();
+}
@@ -57,8 +57,12 @@ void MX_USB_PCD_Init(void)
 	HAL_PCDEx_PMAConfig(&hpcd_USB_DRD_FS, 0x00, PCD_SNG_BUF, 0x20); //EP0 OUT
 	HAL_PCDEx_PMAConfig(&hpcd_USB_DRD_FS, 0x80, PCD_SNG_BUF, 0x60); //EP0 IN
 	HAL_PCDEx_PMAConfig(&hpcd_USB_DRD_FS, 0x81, PCD_SNG_BUF, 0xA0); //EP1 IN
-	HAL_PCDEx_PMAConfig(&hpcd_USB_DRD_FS, 0x82, PCD_SNG_BUF, 0xE0); //EP2 IN
-	HAL_PCDEx_PMAConfig(&hpcd_USB_DRD_FS, 0x03, PCD_SNG_BUF, 0xF0); //EP3 OUT
+	HAL_PCDEx_PMAConfig(&hpcd_USB_DRD_FS, 0x82, PCD_SNG_BUF, 0xB0); //EP2 IN  (CDC dados, 64 B)
+	HAL_PCDEx_PMAConfig(&hpcd_USB_DRD_FS, 0x03, PCD_SNG_BUF, 0xF0); //EP3 OUT (CDC dados, 64 B)
+	HAL_PCDEx_PMAConfig(&hpcd_USB_DRD_FS, 0x84, PCD_SNG_BUF, 0x130); //EP4 IN  (MSC, 64 B)
+	HAL_PCDEx_PMAConfig(&hpcd_USB_DRD_FS, 0x04, PCD_SNG_BUF, 0x170); //EP4 OUT (MSC, 64 B)
+	HAL_PCDEx_PMAConfig(&hpcd_USB_DRD_FS, 0x85, PCD_SNG_BUF, 0x1B0); //EP5 IN  (HID, 32 B)
+	HAL_PCDEx_PMAConfig(&hpcd_USB_DRD_FS, 0x05, PCD_SNG_BUF, 0x1D0); //EP5 OUT (HID, 8 B)
 	
 	_ux_dcd_stm32_initialize((ULONG)NULL, (ULONG)&hpcd_USB_DRD_FS);
 	HAL_PCD_Start(&hpcd_USB_DRD_FS);
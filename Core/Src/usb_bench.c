@@ -0,0 +1,192 @@
+/*
+ * Nome do Arquivo: usb_bench.c
+ * Descricao: Bancada de medicao do caminho USB no alvo. O M0+ nao tem DWT,
+ *            entao os ciclos vem do SysTick (tick de 1 ms + contagem regressiva
+ *            do VAL), com resolucao de 1 ciclo e volta a cada ~89 s a 48 MHz.
+ *            A carga de vazao passa pelo FIFO e pelo pump da CLI, o mesmo
+ *            caminho do texto e da telemetria. So entra no build com
+ *            USB_BENCH_ENABLE (ver usb_bench.h).
+ * Autor: Gabriel Agune
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "usb_bench.h"
+#include "cli_driver.h"
+#include "main.h"
+#include <stdio.h>
+
+#if USB_BENCH_ENABLE
+
+// ============================================================
+// Variaveis Estaticas
+// ============================================================
+
+static struct {
+    uint32_t tasks_chamadas;
+    uint64_t tasks_ciclos_total;
+    uint32_t tasks_ciclos_max;
+
+    bool     rx_marcado;
+    uint32_t rx_ciclos;
+    uint32_t lat_amostras;
+    uint64_t lat_ciclos_total;
+    uint32_t lat_ciclos_min;
+    uint32_t lat_ciclos_max;
+
+    bool     tx_ativo;
+    uint32_t tx_total;
+    uint32_t tx_enviados;
+    uint32_t tx_tick_inicio;
+    uint32_t tx_ms;             // Tempo ate o ultimo byte entrar no FIFO
+} s_bench;
+
+// ============================================================
+// Prototipos de Funcoes Privadas
+// ============================================================
+
+static bool Finalizar_TX(void);
+
+// ============================================================
+// Funcoes Privadas
+// ============================================================
+
+// O resumo sai pelo mesmo FIFO, inteiro, depois do ultimo byte do padrao
+static bool Finalizar_TX(void) {
+    char resumo[64];
+    int len = snprintf(resumo, sizeof(resumo), "\r\nUSBBENCH TX %lu bytes em %lu ms\r\n> ",
+                       (unsigned long)s_bench.tx_total, (unsigned long)s_bench.tx_ms);
+    if (len <= 0 || !CLI_Write_Frame(resumo, (size_t)len)) {
+        return false;
+    }
+    s_bench.tx_ativo = false;
+    return true;
+}
+
+// ============================================================
+// API Publica
+// ============================================================
+
+uint32_t USB_Bench_Ciclos(void) {
+    uint32_t tick;
+    uint32_t val;
+
+    // Repete se o SysTick virou entre as leituras
+    do {
+        tick = HAL_GetTick();
+        val  = SysTick->VAL;
+    } while (tick != HAL_GetTick());
+
+    const uint32_t periodo = SysTick->LOAD + 1U;
+    return (tick * periodo) + (periodo - 1U - val);
+}
+
+void USB_Bench_Registrar_Tasks(uint32_t ciclos_inicio) {
+    uint32_t ciclos = USB_Bench_Ciclos() - ciclos_inicio;
+
+    s_bench.tasks_chamadas++;
+    s_bench.tasks_ciclos_total += ciclos;
+    if (ciclos > s_bench.tasks_ciclos_max) {
+        s_bench.tasks_ciclos_max = ciclos;
+    }
+}
+
+void USB_Bench_Marcar_RX(void) {
+    if (!s_bench.rx_marcado) {
+        s_bench.rx_marcado = true;
+        s_bench.rx_ciclos = USB_Bench_Ciclos();
+    }
+}
+
+void USB_Bench_Marcar_TX(void) {
+    if (!s_bench.rx_marcado) {
+        return;
+    }
+    s_bench.rx_marcado = false;
+
+    uint32_t ciclos = USB_Bench_Ciclos() - s_bench.rx_ciclos;
+    if (s_bench.lat_amostras == 0U || ciclos < s_bench.lat_ciclos_min) {
+        s_bench.lat_ciclos_min = ciclos;
+    }
+    if (ciclos > s_bench.lat_ciclos_max) {
+        s_bench.lat_ciclos_max = ciclos;
+    }
+    s_bench.lat_ciclos_total += ciclos;
+    s_bench.lat_amostras++;
+}
+
+bool USB_Bench_Iniciar_TX(uint32_t bytes) {
+    if (s_bench.tx_ativo || bytes == 0U || bytes > USB_BENCH_TX_MAX_BYTES) {
+        return false;
+    }
+    s_bench.tx_total = bytes;
+    s_bench.tx_enviados = 0;
+    s_bench.tx_tick_inicio = HAL_GetTick();
+    s_bench.tx_ativo = true;
+    return true;
+}
+
+// Enche o FIFO com o padrao 0x00..0xFF continuo (o host confere a sequencia)
+void USB_Bench_Process(void) {
+    if (!s_bench.tx_ativo) {
+        return;
+    }
+    if (!CLI_Is_USB_Connected()) {
+        s_bench.tx_ativo = false;
+        return;
+    }
+
+    uint8_t bloco[USB_BENCH_TX_BLOCO];
+    while (s_bench.tx_enviados < s_bench.tx_total) {
+        uint32_t n = s_bench.tx_total - s_bench.tx_enviados;
+        if (n > sizeof(bloco)) {
+            n = sizeof(bloco);
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            bloco[i] = (uint8_t)(s_bench.tx_enviados + i);
+        }
+
+        size_t aceitos = CLI_Write(bloco, n);
+        s_bench.tx_enviados += (uint32_t)aceitos;
+        if (aceitos < n) {
+            return;     // FIFO cheio: continua quando o pump liberar espaco
+        }
+        if (s_bench.tx_enviados == s_bench.tx_total) {
+            s_bench.tx_ms = HAL_GetTick() - s_bench.tx_tick_inicio;
+        }
+    }
+    (void)Finalizar_TX();
+}
+
+// Zera as medicoes; um envio de vazao em andamento continua
+void USB_Bench_Reset(void) {
+    s_bench.tasks_chamadas     = 0;
+    s_bench.tasks_ciclos_total = 0;
+    s_bench.tasks_ciclos_max   = 0;
+    s_bench.rx_marcado         = false;
+    s_bench.lat_amostras       = 0;
+    s_bench.lat_ciclos_total   = 0;
+    s_bench.lat_ciclos_min     = 0;
+    s_bench.lat_ciclos_max     = 0;
+}
+
+void USB_Bench_Get_Stats(USB_Bench_Stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    stats->tasks_chamadas       = s_bench.tasks_chamadas;
+    stats->tasks_ciclos_medio   = (s_bench.tasks_chamadas > 0U) ?
+                                  (uint32_t)(s_bench.tasks_ciclos_total / s_bench.tasks_chamadas) : 0U;
+    stats->tasks_ciclos_max     = s_bench.tasks_ciclos_max;
+    stats->latencia_amostras    = s_bench.lat_amostras;
+    stats->latencia_ciclos_min  = s_bench.lat_ciclos_min;
+    stats->latencia_ciclos_medio = (s_bench.lat_amostras > 0U) ?
+                                  (uint32_t)(s_bench.lat_ciclos_total / s_bench.lat_amostras) : 0U;
+    stats->latencia_ciclos_max  = s_bench.lat_ciclos_max;
+    stats->tx_ativo             = s_bench.tx_ativo;
+    stats->tx_restante          = s_bench.tx_total - s_bench.tx_enviados;
+}
+
+#endif // USB_BENCH_ENABLE
@@ -0,0 +1,274 @@
+/*
+ * Nome do Arquivo: usbx_memoria.c
+ * Descricao: Substitui o _ux_utility_memory_allocate/_free do USBX pelo padrao
+ *            $Sub$$/$Super$$ do armlink (o middleware fica intocado). No USBX
+ *            standalone todas as alocacoes acontecem uma unica vez, no
+ *            ux_device_stack_initialize e no registro das classes, entao a
+ *            arena e um simples ponteiro de topo: sem busca first-fit, sem
+ *            cabecalho por bloco e com o tamanho exato somado dos sizeof().
+ *            As liberacoes so ocorrem em caminhos de erro/desregistro, na
+ *            ordem inversa das alocacoes, e devolvem o topo da arena.
+ * Autor: Gabriel Agune
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "usbx_memoria.h"
+#include "ux_api.h"
+#include "ux_device_descriptors.h"
+#include "ux_device_customhid.h"
+#include "ux_device_class_cdc_acm.h"
+#include "ux_device_class_storage.h"
+#include "ux_device_class_dfu.h"
+#include "ux_device_class_hid.h"
+#include <string.h>
+
+// ============================================================
+// Definicoes e Constantes Privadas
+// ============================================================
+
+// Interfaces e endpoints declarados no descritor de configuracao montado pelo
+// ux_device_descriptors.c (CDC: comunicacao + dados; HID com interrupt OUT)
+#define USBX_MEMORIA_NUM_INTERFACES ((2U * USBD_CDC_ACM_CLASS_ACTIVATED) + USBD_MSC_CLASS_ACTIVATED + \
+                                     USBD_DFU_CLASS_ACTIVATED + USBD_HID_CUSTOM_CLASS_ACTIVATED)
+
+#ifdef UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT
+#define USBX_MEMORIA_HID_ENDPOINTS  2U
+#else
+#define USBX_MEMORIA_HID_ENDPOINTS  1U
+#endif
+
+#define USBX_MEMORIA_NUM_ENDPOINTS  ((3U * USBD_CDC_ACM_CLASS_ACTIVATED) + (2U * USBD_MSC_CLASS_ACTIVATED) + \
+                                     (USBX_MEMORIA_HID_ENDPOINTS * USBD_HID_CUSTOM_CLASS_ACTIVATED))
+
+// Sem a varredura do framework o stack usa estes limites como contagem exata
+#if defined(UX_DEVICE_INITIALIZE_FRAMEWORK_SCAN_DISABLE)
+#if (UX_MAX_SLAVE_INTERFACES != USBX_MEMORIA_NUM_INTERFACES) || (UX_MAX_DEVICE_ENDPOINTS != USBX_MEMORIA_NUM_ENDPOINTS)
+#error "UX_MAX_SLAVE_INTERFACES/UX_MAX_DEVICE_ENDPOINTS (ux_user.h) nao conferem com os descritores"
+#endif
+#endif
+
+#if USBX_MEMORIA_ARENA
+
+#define USBX_MEMORIA_ALINHAR(n)     (((uint32_t)(n) + UX_ALIGN_MIN) & ~(uint32_t)UX_ALIGN_MIN)
+
+// ux_device_stack_initialize: classes, buffer de controle, interfaces e endpoints
+#if UX_DEVICE_ENDPOINT_BUFFER_OWNER == 0
+#define USBX_MEMORIA_BUFFERS_EP     (USBX_MEMORIA_NUM_ENDPOINTS * USBX_MEMORIA_ALINHAR(UX_SLAVE_REQUEST_DATA_MAX_LENGTH))
+#else
+#define USBX_MEMORIA_BUFFERS_EP     0U
+#endif
+
+#define USBX_MEMORIA_STACK          (USBX_MEMORIA_ALINHAR(sizeof(UX_SLAVE_CLASS) * UX_MAX_SLAVE_CLASS_DRIVER) + \
+                                     USBX_MEMORIA_ALINHAR(UX_SLAVE_REQUEST_CONTROL_MAX_LENGTH) +                \
+                                     USBX_MEMORIA_ALINHAR(sizeof(UX_SLAVE_INTERFACE) * USBX_MEMORIA_NUM_INTERFACES) + \
+                                     USBX_MEMORIA_ALINHAR(sizeof(UX_SLAVE_ENDPOINT) * USBX_MEMORIA_NUM_ENDPOINTS) + \
+                                     USBX_MEMORIA_BUFFERS_EP)
+
+// Instancias das classes (com buffers proprios quando a classe e dona deles; a CDC
+// em zero-copy usa os buffers da CLI e nao aloca nada)
+#if defined(UX_DEVICE_CLASS_CDC_ACM_OWN_ENDPOINT_BUFFER)
+#define USBX_MEMORIA_CDC            (USBX_MEMORIA_ALINHAR(sizeof(UX_SLAVE_CLASS_CDC_ACM)) + \
+                                     USBX_MEMORIA_ALINHAR(UX_DEVICE_CLASS_CDC_ACM_ENDPOINT_BUFFER_SIZE))
+#else
+#define USBX_MEMORIA_CDC            USBX_MEMORIA_ALINHAR(sizeof(UX_SLAVE_CLASS_CDC_ACM))
+#endif
+
+#if UX_DEVICE_ENDPOINT_BUFFER_OWNER == 1
+#define USBX_MEMORIA_MSC            (USBX_MEMORIA_ALINHAR(sizeof(UX_SLAVE_CLASS_STORAGE)) + \
+                                     USBX_MEMORIA_ALINHAR(UX_DEVICE_CLASS_STORAGE_ENDPOINT_BUFFER_SIZE))
+#else
+#define USBX_MEMORIA_MSC            USBX_MEMORIA_ALINHAR(sizeof(UX_SLAVE_CLASS_STORAGE))
+#endif
+
+#if defined(UX_DEVICE_CLASS_HID_OWN_ENDPOINT_BUFFER)
+#define USBX_MEMORIA_HID_EP         USBX_MEMORIA_ALINHAR(UX_DEVICE_CLASS_HID_ENDPOINT_BUFFER_SIZE)
+#else
+#define USBX_MEMORIA_HID_EP         0U
+#endif
+
+#define USBX_MEMORIA_DFU            USBX_MEMORIA_ALINHAR(sizeof(UX_SLAVE_CLASS_DFU))
+
+#ifdef UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT
+#define USBX_MEMORIA_HID_RECEPTOR   USBX_MEMORIA_ALINHAR(sizeof(UX_DEVICE_CLASS_HID_RECEIVER) +               \
+                                        USBD_CUSTOM_HID_RECEIVER_EVENTS *                                  \
+                                        (USBD_HID_CUSTOM_EPOUT_FS_MPS + sizeof(ULONG)))
+#else
+#define USBX_MEMORIA_HID_RECEPTOR   0U
+#endif
+
+#define USBX_MEMORIA_HID            (USBX_MEMORIA_ALINHAR(sizeof(UX_SLAVE_CLASS_HID)) + USBX_MEMORIA_HID_EP + \
+                                     USBX_MEMORIA_ALINHAR(UX_DEVICE_CLASS_HID_MAX_EVENTS_QUEUE *           \
+                                                          sizeof(UX_SLAVE_CLASS_HID_EVENT)) +             \
+                                     USBX_MEMORIA_HID_RECEPTOR)
+
+#define USBX_MEMORIA_ARENA_BYTES    (USBX_MEMORIA_STACK +                                   \
+                                     (USBD_CDC_ACM_CLASS_ACTIVATED * USBX_MEMORIA_CDC) +     \
+                                     (USBD_MSC_CLASS_ACTIVATED * USBX_MEMORIA_MSC) +         \
+                                     (USBD_DFU_CLASS_ACTIVATED * USBX_MEMORIA_DFU) +         \
+                                     (USBD_HID_CUSTOM_CLASS_ACTIVATED * USBX_MEMORIA_HID) +  \
+                                     USBX_MEMORIA_FOLGA)
+
+#endif // USBX_MEMORIA_ARENA
+
+// Implementacoes originais do USBX (armlink)
+extern VOID* $Super$$_ux_utility_memory_allocate(ULONG memory_alignment, ULONG memory_cache_flag,
+                                                 ULONG memory_size_requested);
+extern VOID  $Super$$_ux_utility_memory_free(VOID *memory);
+
+VOID* $Sub$$_ux_utility_memory_allocate(ULONG memory_alignment, ULONG memory_cache_flag,
+                                        ULONG memory_size_requested);
+VOID  $Sub$$_ux_utility_memory_free(VOID *memory);
+
+// ============================================================
+// Variaveis Estaticas
+// ============================================================
+
+#if USBX_MEMORIA_ARENA
+static uint64_t s_arena[(USBX_MEMORIA_ARENA_BYTES + 7U) / 8U];
+#endif
+
+static struct {
+#if USBX_MEMORIA_ARENA
+    uint32_t topo;
+    uint16_t blocos[USBX_MEMORIA_MAX_BLOCOS];   // Offset de inicio de cada bloco, em ordem
+    uint8_t  num_blocos;
+#endif
+    USBX_Memoria_Stats_t stats;
+} s_mem;
+
+// ============================================================
+// Prototipos de Funcoes Privadas
+// ============================================================
+
+#if USBX_MEMORIA_ARENA
+static void* Arena_Alocar(ULONG alinhamento, ULONG tamanho);
+static void  Arena_Liberar(void *bloco);
+#endif
+static uint32_t Em_Uso(void);
+
+// ============================================================
+// Funcoes Privadas
+// ============================================================
+
+#if USBX_MEMORIA_ARENA
+static void* Arena_Alocar(ULONG alinhamento, ULONG tamanho) {
+    // A arena nao tem regiao separada para cache (o M0+ nao tem cache)
+    if (alinhamento == UX_SAFE_ALIGN || alinhamento < UX_ALIGN_MIN) {
+        alinhamento = UX_ALIGN_MIN;
+    }
+    if (s_mem.num_blocos >= USBX_MEMORIA_MAX_BLOCOS) {
+        return NULL;
+    }
+
+    uint8_t *base = (uint8_t*)s_arena;
+    uint32_t inicio = (uint32_t)((((uintptr_t)&base[s_mem.topo] + alinhamento) & ~(uintptr_t)alinhamento) -
+                                 (uintptr_t)base);
+    uint32_t fim = inicio + USBX_MEMORIA_ALINHAR(tamanho);
+    if (fim > sizeof(s_arena) || fim < inicio) {
+        return NULL;
+    }
+
+    s_mem.blocos[s_mem.num_blocos++] = (uint16_t)s_mem.topo;
+    s_mem.topo = fim;
+
+    // O alocador original entrega o bloco zerado e as classes contam com isso
+    memset(&base[inicio], 0, fim - inicio);
+    return &base[inicio];
+}
+
+// Devolve o topo quando o bloco e o ultimo alocado; fora de ordem fica retido
+static void Arena_Liberar(void *bloco) {
+    uint8_t *base = (uint8_t*)s_arena;
+
+    if (s_mem.num_blocos > 0U) {
+        uint32_t inicio_reservado = s_mem.blocos[s_mem.num_blocos - 1U];
+        uint8_t *bloco_topo = &base[inicio_reservado];
+        if ((uint8_t*)bloco >= bloco_topo && (uint8_t*)bloco < &base[s_mem.topo]) {
+            s_mem.num_blocos--;
+            s_mem.topo = inicio_reservado;
+            return;
+        }
+    }
+    s_mem.stats.retidos++;
+}
+#endif
+
+static uint32_t Em_Uso(void) {
+#if USBX_MEMORIA_ARENA
+    return s_mem.topo;
+#else
+    if (_ux_system == UX_NULL) {
+        return 0;
+    }
+    const UX_MEMORY_BYTE_POOL *pool = _ux_system->ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR];
+    return (uint32_t)(pool->ux_byte_pool_size - pool->ux_byte_pool_available);
+#endif
+}
+
+// ============================================================
+// Substitutos do USBX ($Sub$$)
+// ============================================================
+
+VOID* $Sub$$_ux_utility_memory_allocate(ULONG memory_alignment, ULONG memory_cache_flag,
+                                        ULONG memory_size_requested) {
+    VOID *bloco;
+
+#if USBX_MEMORIA_ARENA
+    // Como no original em standalone, sem exclusao: so o laco principal aloca
+    bloco = Arena_Alocar(memory_alignment, memory_size_requested);
+    (void)memory_cache_flag;
+#else
+    bloco = $Super$$_ux_utility_memory_allocate(memory_alignment, memory_cache_flag, memory_size_requested);
+#endif
+
+    if (memory_size_requested > s_mem.stats.maior_pedido) {
+        s_mem.stats.maior_pedido = memory_size_requested;
+    }
+    if (bloco == UX_NULL) {
+        s_mem.stats.falhas++;
+        return UX_NULL;
+    }
+
+    s_mem.stats.alocacoes++;
+    uint32_t em_uso = Em_Uso();
+    if (em_uso > s_mem.stats.pico) {
+        s_mem.stats.pico = em_uso;
+    }
+    return bloco;
+}
+
+VOID $Sub$$_ux_utility_memory_free(VOID *memory) {
+    if (memory == UX_NULL) {
+        return;
+    }
+    s_mem.stats.liberacoes++;
+
+#if USBX_MEMORIA_ARENA
+    Arena_Liberar(memory);
+#else
+    $Super$$_ux_utility_memory_free(memory);
+#endif
+}
+
+// ============================================================
+// API Publica
+// ============================================================
+
+void USBX_Memoria_Get_Stats(USBX_Memoria_Stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    *stats = s_mem.stats;
+    stats->em_uso = Em_Uso();
+#if USBX_MEMORIA_ARENA
+    stats->arena = true;
+    stats->capacidade = sizeof(s_arena);
+#else
+    stats->arena = false;
+    stats->capacidade = (_ux_system != UX_NULL) ?
+        (uint32_t)_ux_system->ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR]->ux_byte_pool_size : 0U;
+#endif
+}
@@ -0,0 +1,47 @@
+#!/usr/bin/env python3
+"""
+Nome do Arquivo: dfu_preparar.py
+Descricao: Prepara o .bin para atualizacao por USB DFU: anexa o trailer
+           {magico, tamanho, CRC-32} conferido no boot (dfu_runtime.c).
+Autor: Gabriel Agune
+
+Uso:
+    fromelf --bin --output STM32C071RB_FINAL.bin STM32C071RB_FINAL.axf
+    python dfu_preparar.py STM32C071RB_FINAL.bin firmware_dfu.bin
+    dfu-util -e                                    # DFU_DETACH (ou "DFU BOOT" na CLI)
+    dfu-util -a 0 -s 0x08000000:leave -D firmware_dfu.bin
+"""
+
+import struct
+import sys
+
+MAGICO = 0x43524346  # DFU_RUNTIME_MAGICO
+
+
+def crc32_periferico(dados):
+    """CRC-32 do periferico STM32 (poly 0x04C11DB7, init 0xFFFFFFFF, sem reflexao/xor)."""
+    crc = 0xFFFFFFFF
+    for b in dados:
+        crc ^= b << 24
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x04C11DB7) & 0xFFFFFFFF if crc & 0x80000000 else (crc << 1) & 0xFFFFFFFF
+    return crc
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        return 1
+
+    imagem = open(sys.argv[1], "rb").read()
+    crc = crc32_periferico(imagem)
+    with open(sys.argv[2], "wb") as f:
+        f.write(imagem)
+        f.write(struct.pack("<III", MAGICO, len(imagem), crc))
+
+    print("%s: %d bytes, CRC-32 0x%08X" % (sys.argv[2], len(imagem), crc))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
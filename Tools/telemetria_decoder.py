@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""
+Nome do Arquivo: telemetria_decoder.py
+Descricao: Decodificador (lado PC) dos registros binarios do comando STREAM.
+           Le da porta CDC (pyserial) ou de um arquivo capturado e gera CSV.
+Autor: Gabriel Agune
+
+Uso:
+    python telemetria_decoder.py COM5 [--taxa 1000] > saida.csv
+    python telemetria_decoder.py captura.bin > saida.csv
+"""
+
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"
+TIPO_AMOSTRA = 0x01
+PAYLOAD_FMT = "<HIiHIhBB"   # Ver telemetria_stream.h
+PAYLOAD_SIZE = struct.calcsize(PAYLOAD_FMT)
+
+
+def crc16_modbus(dados):
+    crc = 0xFFFF
+    for b in dados:
+        crc ^= b
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0xA001 if crc & 1 else crc >> 1
+    return crc
+
+
+def decodificar(fluxo):
+    """Extrai registros validos de um fluxo de bytes; texto do CLI e lixo sao ignorados."""
+    buf = bytearray()
+    for bloco in fluxo:
+        buf.extend(bloco)
+        while True:
+            i = buf.find(SYNC)
+            if i < 0:
+                del buf[:-1]
+                break
+            del buf[:i]
+            if len(buf) < 4:
+                break
+            tamanho = buf[3]
+            total = 4 + tamanho + 2
+            if buf[2] != TIPO_AMOSTRA or tamanho != PAYLOAD_SIZE:
+                del buf[:1]
+                continue
+            if len(buf) < total:
+                break
+            quadro = bytes(buf[:total])
+            crc = struct.unpack_from("<H", quadro, total - 2)[0]
+            if crc16_modbus(quadro[2:total - 2]) != crc:
+                del buf[:1]
+                continue
+            del buf[:total]
+            yield struct.unpack_from(PAYLOAD_FMT, quadro, 4)
+
+
+def fluxo_serial(porta, taxa):
+    import serial  # pyserial
+    with serial.Serial(porta, 115200, timeout=0.1) as s:
+        s.write(("STREAM ON %d\r" % taxa).encode())
+        try:
+            while True:
+                yield s.read(4096)
+        finally:
+            s.write(b"STREAM OFF\r")
+
+
+def fluxo_arquivo(caminho):
+    with open(caminho, "rb") as f:
+        while True:
+            bloco = f.read(4096)
+            if not bloco:
+                return
+            yield bloco
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__, file=sys.stderr)
+        return 1
+
+    origem = sys.argv[1]
+    taxa = 1000
+    if "--taxa" in sys.argv:
+        taxa = int(sys.argv[sys.argv.index("--taxa") + 1])
+
+    fluxo = fluxo_arquivo(origem) if origem.endswith(".bin") else fluxo_serial(origem, taxa)
+
+    print("seq,tick_ms,ads_raw,ads_contador,tim2_contagem,temp_c,descartados,nova_amostra")
+    seq_anterior = None
+    perdidos = 0
+    try:
+        for seq, tick, raw, ads_n, tim2, temp, desc, flags in decodificar(fluxo):
+            if seq_anterior is not None:
+                perdidos += (seq - seq_anterior - 1) & 0xFFFF
+            seq_anterior = seq
+            print("%u,%u,%d,%u,%u,%.2f,%u,%u" % (seq, tick, raw, ads_n, tim2, temp / 100.0, desc, flags & 1))
+    except KeyboardInterrupt:
+        pass
+    print("registros perdidos (lacunas de sequencia): %d" % perdidos, file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""
+Nome do Arquivo: usb_bench.py
+Descricao: Bancada de medicao da USB CDC (lado PC) usando o comando USBBENCH.
+           Mede a latencia de ida e volta pelo eco da CLI, a vazao do caminho
+           FIFO -> pump -> endpoint (com conferencia do padrao) e le do alvo o
+           custo do ux_device_stack_tasks_run. A ultima linha (chave=valor) e
+           estavel para comparar execucoes antes/depois de uma mudanca.
+           O comando so existe em firmware compilado com USB_BENCH_ENABLE=1
+           (define do projeto Keil); para medir sem placa, ver Tools/usb_sim.
+Autor: Gabriel Agune
+
+Uso:
+    python usb_bench.py COM5 [--bytes 1048576] [--amostras 200]
+"""
+
+import statistics
+import sys
+import time
+
+PROMPT = b"\r\n> "
+
+
+def ler_ate(s, marcador, timeout=2.0):
+    buf = bytearray()
+    limite = time.monotonic() + timeout
+    while not buf.endswith(marcador):
+        if time.monotonic() > limite:
+            raise TimeoutError("sem resposta (recebido: %r)" % bytes(buf[-64:]))
+        buf.extend(s.read(1))
+    return bytes(buf)
+
+
+def comando(s, texto, timeout=2.0):
+    s.write(texto.encode() + b"\r")
+    return ler_ate(s, PROMPT, timeout).decode(errors="replace")
+
+
+def medir_latencia(s, amostras):
+    """Ida e volta de um byte: o alvo ecoa o caractere e o backspace apaga a linha."""
+    tempos = []
+    for _ in range(amostras):
+        t0 = time.perf_counter()
+        s.write(b"x")
+        if s.read(1) != b"x":
+            raise RuntimeError("eco inesperado")
+        tempos.append((time.perf_counter() - t0) * 1e6)
+        s.write(b"\b")
+        ler_ate(s, b"\b \b")
+    tempos.sort()
+    return tempos
+
+
+def medir_vazao(s, total):
+    s.write(b"USBBENCH TX %d\r" % total)
+    ler_ate(s, PROMPT)
+
+    t0 = time.perf_counter()
+    recebidos = bytearray()
+    while len(recebidos) < total:
+        bloco = s.read(min(65536, total - len(recebidos)))
+        if not bloco:
+            raise TimeoutError("vazao interrompida em %d de %d bytes" % (len(recebidos), total))
+        recebidos.extend(bloco)
+    segundos = time.perf_counter() - t0
+
+    erros = sum(1 for i, b in enumerate(recebidos) if b != (i & 0xFF))
+    resumo = ler_ate(s, PROMPT).decode(errors="replace").strip()
+    return segundos, erros, resumo
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__, file=sys.stderr)
+        return 1
+
+    import serial  # pyserial
+
+    total = 1048576
+    amostras = 200
+    if "--bytes" in sys.argv:
+        total = int(sys.argv[sys.argv.index("--bytes") + 1])
+    if "--amostras" in sys.argv:
+        amostras = int(sys.argv[sys.argv.index("--amostras") + 1])
+
+    with serial.Serial(sys.argv[1], 115200, timeout=1.0) as s:
+        s.write(b"STREAM OFF\r")
+        time.sleep(0.2)
+        s.reset_input_buffer()
+        comando(s, "USBBENCH RESET")
+
+        lat = medir_latencia(s, amostras)
+        segundos, erros, resumo = medir_vazao(s, total)
+        alvo = comando(s, "USBBENCH")
+
+    kib_s = total / segundos / 1024.0
+    p99 = lat[min(len(lat) - 1, int(len(lat) * 0.99))]
+    print("Latencia eco (us): min %.0f  mediana %.0f  p99 %.0f  max %.0f" %
+          (lat[0], statistics.median(lat), p99, lat[-1]))
+    print("Vazao: %d bytes em %.3f s = %.1f KiB/s, %d bytes errados (%s)" %
+          (total, segundos, kib_s, erros, resumo))
+    print("Alvo:" + alvo.rsplit("\r\n> ", 1)[0].split("USBBENCH", 1)[-1])
+    print("lat_mediana_us=%.0f lat_p99_us=%.0f vazao_kib_s=%.1f erros=%d" %
+          (statistics.median(lat), p99, kib_s, erros))
+    return 0 if erros == 0 else 2
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,55 @@
+/*
+ * Nome do Arquivo: stm32c0xx_hal.h (usb_sim)
+ * Descricao: Substituto minimo do HAL para compilar o codigo USBX da
+ *            aplicacao no host: base de tempo em ms e as intrinsecas de
+ *            PRIMASK usadas por _ux_utility_interrupt_disable/_restore.
+ *            O simulador roda em uma unica thread, entao a mascara de
+ *            interrupcao e apenas um estado guardado
+ * Autor: Gabriel Agune
+ */
+
+#ifndef USB_SIM_STM32C0XX_HAL_H
+#define USB_SIM_STM32C0XX_HAL_H
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ============================================================
+// Definicoes
+// ============================================================
+
+#define __ALIGN_BEGIN
+#define __ALIGN_END     __attribute__((aligned(4)))
+#define __PACKED        __attribute__((packed))
+#define UNUSED(X)       (void)(X)
+
+// ============================================================
+// API Publica
+// ============================================================
+
+// Milissegundos desde o inicio do processo (CLOCK_MONOTONIC)
+uint32_t HAL_GetTick(void);
+
+extern uint32_t g_usb_sim_primask;
+
+static inline uint32_t __get_PRIMASK(void) {
+    return g_usb_sim_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t primask) {
+    g_usb_sim_primask = primask;
+}
+
+static inline void __disable_irq(void) {
+    g_usb_sim_primask = 1U;
+}
+
+static inline void __enable_irq(void) {
+    g_usb_sim_primask = 0U;
+}
+
+#endif // USB_SIM_STM32C0XX_HAL_H
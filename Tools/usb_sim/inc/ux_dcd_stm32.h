@@ -0,0 +1,18 @@
+/*
+ * Nome do Arquivo: ux_dcd_stm32.h (usb_sim)
+ * Descricao: No host o DCD e o ux_dcd_sim_slave; deste cabecalho o
+ *            app_usbx_device.c so usa os codigos de evento repassados ao
+ *            USBD_ChangeFunction (mesmos valores do DCD STM32)
+ * Autor: Gabriel Agune
+ */
+
+#ifndef USB_SIM_UX_DCD_STM32_H
+#define USB_SIM_UX_DCD_STM32_H
+
+#define UX_DCD_STM32_SOF_RECEIVED           0xF0U
+#define UX_DCD_STM32_DEVICE_CONNECTED       0xF1U
+#define UX_DCD_STM32_DEVICE_DISCONNECTED    0xF2U
+#define UX_DCD_STM32_DEVICE_RESUMED         0xF3U
+#define UX_DCD_STM32_DEVICE_SUSPENDED       0xF4U
+
+#endif // USB_SIM_UX_DCD_STM32_H
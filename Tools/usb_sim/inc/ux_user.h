@@ -0,0 +1,22 @@
+/*
+ * Nome do Arquivo: ux_user.h (usb_sim)
+ * Descricao: Configuracao do USBX para o build de host. Reaproveita a
+ *            configuracao do firmware (USBX/App/ux_user.h) sem alterar nada
+ *            do lado device e so libera o lado host, que o firmware desliga
+ *            com UX_DEVICE_SIDE_ONLY, para ligar o ux_hcd_sim_host ao
+ *            ux_dcd_sim_slave no mesmo processo
+ * Autor: Gabriel Agune
+ */
+
+#ifndef USB_SIM_UX_USER_H
+#define USB_SIM_UX_USER_H
+
+#include "../../../USBX/App/ux_user.h"
+
+#undef UX_DEVICE_SIDE_ONLY
+
+// Um unico dispositivo na raiz do host simulado
+#define UX_MAX_HCD                  1
+#define UX_MAX_DEVICES              1
+
+#endif // USB_SIM_UX_USER_H
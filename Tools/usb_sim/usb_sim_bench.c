@@ -0,0 +1,552 @@
+/*
+ * Nome do Arquivo: usb_sim_bench.c
+ * Descricao: Bancada de host da USB CDC. A configuracao device do firmware
+ *            (MX_USBX_Device_Init, descritores, callbacks da CDC) roda sobre
+ *            o ux_dcd_sim_slave e e enumerada pelo ux_hcd_sim_host no mesmo
+ *            processo. O lado device imita os pumps da CLI (read_run/write_run
+ *            em zero-copy) e o lado host dirige os endpoints bulk da interface
+ *            de dados com ux_host_stack_transfer_request. Mede a latencia de
+ *            eco por pacote, a vazao nos dois sentidos (com conferencia do
+ *            padrao) e o custo por chamada do ux_device_stack_tasks_run. A
+ *            ultima linha (chave=valor) e estavel para comparar execucoes.
+ *            Os tempos sao de CPU do host: comparam mudancas no codigo, nao
+ *            substituem a medicao no alvo
+ * Autor: Gabriel Agune
+ *
+ * Uso:
+ *     usb_sim_bench [--bytes 1048576] [--amostras 1000]
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "app_usbx_device.h"
+#include "ux_dcd_sim_slave.h"
+#include "ux_hcd_sim_host.h"
+#include "ux_host_stack.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================
+// Definicoes e Constantes Privadas
+// ============================================================
+
+#define SIM_PACOTE              64U         // MPS dos endpoints bulk em FS (CLI_USB_MAX_PKT)
+#define SIM_BLOCO               512U        // Transferencia dos testes de vazao
+#define SIM_HOST_POOL_BYTES     (64UL * 1024UL)
+#define SIM_PASSOS_MAX          5000000UL   // Sem progresso nesse numero de passos: falha
+
+#define SIM_BYTES_PADRAO        (1024UL * 1024UL)
+#define SIM_AMOSTRAS_PADRAO     1000UL
+
+#define SIM_CLASSE_CDC_DADOS    0x0AU
+
+// ============================================================
+// Tipos de Dados Privados
+// ============================================================
+
+typedef enum {
+    DEV_OCIOSO = 0,
+    DEV_ECO,            // Devolve cada pacote recebido (caminho RX -> TX da CLI)
+    DEV_SUMIDOURO,      // Consome e confere o padrao enviado pelo host
+    DEV_FONTE           // Gera o padrao para o host
+} Dev_Modo_t;
+
+typedef struct {
+    uint64_t chamadas;
+    uint64_t ns_total;
+    uint64_t ns_max;
+} Tasks_Stats_t;
+
+// ============================================================
+// Variaveis Estaticas
+// ============================================================
+
+extern UX_SLAVE_CLASS_CDC_ACM *cdc_acm;
+
+static struct {
+    Dev_Modo_t modo;
+    uint8_t    rx[SIM_BLOCO];
+    uint8_t    tx[SIM_BLOCO];
+    ULONG      tx_len;
+    bool       tx_pendente;
+    uint32_t   restante;        // Fonte: bytes ainda a gerar
+    uint32_t   rx_concluidos;   // read_run que ja devolveram UX_STATE_NEXT
+    uint32_t   tx_concluidos;   // write_run que ja devolveram UX_STATE_NEXT
+    uint64_t   recebidos;       // Sumidouro: bytes conferidos
+    uint8_t    seq;
+    bool       erro_padrao;
+} s_dev;
+
+static Tasks_Stats_t s_tasks;
+
+static struct {
+    UX_HCD      *hcd;
+    UX_DEVICE   *device;
+    UX_ENDPOINT *ep_out;
+    UX_ENDPOINT *ep_in;
+    uint8_t      tx[SIM_BLOCO];
+    uint8_t      rx[SIM_BLOCO];
+} s_host;
+
+static UX_MEMORY_BYTE_POOL s_host_pool;
+static uint64_t            s_host_memoria[SIM_HOST_POOL_BYTES / sizeof(uint64_t)];
+
+static uint64_t s_passos;
+
+// ============================================================
+// Funcoes Privadas
+// ============================================================
+
+static uint64_t Agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void Falhar(const char *motivo) {
+    fprintf(stderr, "usb_sim: %s (passo %llu)\n", motivo, (unsigned long long)s_passos);
+    exit(1);
+}
+
+// ------------------------------------------------------------
+// Lado device (equivalente ao USB_Process + pumps da CLI)
+// ------------------------------------------------------------
+
+static void Dev_Eco(void) {
+    ULONG n = 0;
+
+    if (s_dev.tx_pendente) {
+        UINT status = ux_device_class_cdc_acm_write_run(cdc_acm, s_dev.tx, s_dev.tx_len, &n);
+        if (status == UX_STATE_NEXT) {
+            s_dev.tx_pendente = false;
+            s_dev.tx_concluidos++;
+        } else if (status < UX_STATE_NEXT) {
+            Falhar("write_run falhou no eco");
+        }
+        return;
+    }
+
+    if (ux_device_class_cdc_acm_read_run(cdc_acm, s_dev.rx, SIM_PACOTE, &n) == UX_STATE_NEXT && n > 0U) {
+        memcpy(s_dev.tx, s_dev.rx, n);
+        s_dev.tx_len = n;
+        s_dev.tx_pendente = true;
+    }
+}
+
+static void Dev_Sumidouro(void) {
+    ULONG n = 0;
+
+    if (ux_device_class_cdc_acm_read_run(cdc_acm, s_dev.rx, SIM_BLOCO, &n) != UX_STATE_NEXT) {
+        return;
+    }
+    for (ULONG i = 0; i < n; i++) {
+        if (s_dev.rx[i] != s_dev.seq++) {
+            s_dev.erro_padrao = true;
+        }
+    }
+    s_dev.recebidos += n;
+    s_dev.rx_concluidos++;
+}
+
+static void Dev_Fonte(void) {
+    ULONG n = 0;
+
+    if (!s_dev.tx_pendente) {
+        if (s_dev.restante == 0U) {
+            return;
+        }
+        s_dev.tx_len = (s_dev.restante < SIM_BLOCO) ? s_dev.restante : SIM_BLOCO;
+        for (ULONG i = 0; i < s_dev.tx_len; i++) {
+            s_dev.tx[i] = s_dev.seq++;
+        }
+        s_dev.tx_pendente = true;
+    }
+
+    UINT status = ux_device_class_cdc_acm_write_run(cdc_acm, s_dev.tx, s_dev.tx_len, &n);
+    if (status == UX_STATE_NEXT) {
+        s_dev.restante -= s_dev.tx_len;
+        s_dev.tx_pendente = false;
+        s_dev.tx_concluidos++;
+    } else if (status < UX_STATE_NEXT) {
+        Falhar("write_run falhou na fonte");
+    }
+}
+
+static void Dev_Passo(void) {
+    uint64_t t0 = Agora_ns();
+    ux_device_stack_tasks_run();
+    uint64_t dt = Agora_ns() - t0;
+
+    s_tasks.chamadas++;
+    s_tasks.ns_total += dt;
+    if (dt > s_tasks.ns_max) {
+        s_tasks.ns_max = dt;
+    }
+
+    if (cdc_acm == UX_NULL) {
+        return;
+    }
+    switch (s_dev.modo) {
+        case DEV_ECO:       Dev_Eco();       break;
+        case DEV_SUMIDOURO: Dev_Sumidouro(); break;
+        case DEV_FONTE:     Dev_Fonte();     break;
+        default:                             break;
+    }
+}
+
+// ------------------------------------------------------------
+// Lado host
+// ------------------------------------------------------------
+
+// Em standalone o timer do ux_hcd_sim_host nao existe: o escalonador do
+// controlador roda a cada ux_host_stack_tasks_run, inclusive nas esperas
+// bloqueantes da enumeracao
+static UINT Host_Evento(ULONG evento, UX_HOST_CLASS *classe, VOID *instancia) {
+    UX_PARAMETER_NOT_USED(classe);
+    UX_PARAMETER_NOT_USED(instancia);
+
+    if (evento == UX_STANDALONE_WAIT_BACKGROUND_TASK && s_host.hcd != UX_NULL) {
+        s_host.hcd->ux_hcd_entry_function(s_host.hcd, UX_HCD_PROCESS_DONE_QUEUE, UX_NULL);
+    }
+    return UX_SUCCESS;
+}
+
+// Classe host minima: assume a interface de dados da CDC para que a pilha
+// host selecione a configuracao (sem dono de interface a enumeracao falha) e
+// deixa os endpoints bulk livres para ux_host_stack_transfer_request
+static UINT Host_Classe_Entrada(UX_HOST_CLASS_COMMAND *comando) {
+    switch (comando->ux_host_class_command_request) {
+        case UX_HOST_CLASS_COMMAND_QUERY:
+            if (comando->ux_host_class_command_usage == UX_HOST_CLASS_COMMAND_USAGE_CSP &&
+                comando->ux_host_class_command_class == SIM_CLASSE_CDC_DADOS) {
+                return UX_SUCCESS;
+            }
+            return UX_NO_CLASS_MATCH;
+
+        case UX_HOST_CLASS_COMMAND_ACTIVATE_START:
+        case UX_HOST_CLASS_COMMAND_DEACTIVATE:
+            return UX_SUCCESS;
+
+        case UX_HOST_CLASS_COMMAND_ACTIVATE_WAIT:
+            return UX_STATE_NEXT;
+
+        default:
+            return UX_FUNCTION_NOT_SUPPORTED;
+    }
+}
+
+// Um passo da simulacao: o device (medido) e depois o host com o controlador
+static void Sim_Passo(void) {
+    Dev_Passo();
+    ux_host_stack_tasks_run();
+    s_passos++;
+}
+
+static void Host_Iniciar(UX_ENDPOINT *ep, uint8_t *buffer, ULONG tamanho) {
+    UX_TRANSFER *tr = &ep->ux_endpoint_transfer_request;
+
+    tr->ux_transfer_request_data_pointer = buffer;
+    tr->ux_transfer_request_requested_length = tamanho;
+    tr->ux_transfer_request_timeout_value = UX_WAIT_FOREVER;
+    tr->ux_transfer_request_flags &= ~(ULONG)UX_TRANSFER_FLAG_AUTO_WAIT;
+    if (ux_host_stack_transfer_request(tr) != UX_SUCCESS) {
+        Falhar("transfer_request recusado");
+    }
+}
+
+// Roda a simulacao ate a transferencia terminar; devolve os bytes transferidos
+static ULONG Host_Aguardar(UX_ENDPOINT *ep) {
+    UX_TRANSFER *tr = &ep->ux_endpoint_transfer_request;
+    uint64_t limite = s_passos + SIM_PASSOS_MAX;
+
+    while (UX_TRANSFER_STATE_IS_BUSY(tr)) {
+        if (s_passos >= limite) {
+            Falhar("transferencia bulk sem resposta");
+        }
+        Sim_Passo();
+    }
+    if (tr->ux_transfer_request_completion_code != UX_SUCCESS) {
+        Falhar("transferencia bulk com erro");
+    }
+    return tr->ux_transfer_request_actual_length;
+}
+
+// O host ve a transferencia concluida alguns passos antes de o read_run/
+// write_run do device devolver UX_STATE_NEXT. No silicio um token nesse
+// intervalo leva NAK; no simulador o ED do slave ainda marcado como concluido
+// responde com pacote vazio. Antes do proximo token no mesmo endpoint o device
+// precisa fechar a transferencia anterior
+static void Dev_Aguardar(const uint32_t *concluidos, uint32_t alvo) {
+    uint64_t limite = s_passos + SIM_PASSOS_MAX;
+
+    while (*concluidos < alvo) {
+        if (s_passos >= limite) {
+            Falhar("device nao fechou a transferencia");
+        }
+        Sim_Passo();
+    }
+}
+
+// Sobe o host e o controlador simulado com memoria propria: o pool do device
+// fica com o tamanho definido pelo firmware. Como no alvo, o device so aloca
+// na inicializacao (ver usbx_memoria.c), entao a troca do pool do sistema
+// depois do MX_USBX_Device_Init nao o afeta
+static void Host_Inicializar(void) {
+    _ux_utility_memory_byte_pool_create(&s_host_pool, s_host_memoria, sizeof(s_host_memoria));
+    _ux_system->ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_REGULAR] = &s_host_pool;
+    _ux_system->ux_system_memory_byte_pool[UX_MEMORY_BYTE_POOL_CACHE_SAFE] = &s_host_pool;
+
+    if (ux_host_stack_initialize(Host_Evento) != UX_SUCCESS) {
+        Falhar("ux_host_stack_initialize");
+    }
+    if (ux_host_stack_class_register((UCHAR*)"usb_sim_cdc_dados", Host_Classe_Entrada) != UX_SUCCESS) {
+        Falhar("ux_host_stack_class_register");
+    }
+    if (ux_dcd_sim_slave_initialize() != UX_SUCCESS) {
+        Falhar("ux_dcd_sim_slave_initialize");
+    }
+    if (ux_host_stack_hcd_register((UCHAR*)"ux_hcd_sim_host", ux_hcd_sim_host_initialize, 0, 0) != UX_SUCCESS) {
+        Falhar("ux_host_stack_hcd_register");
+    }
+    s_host.hcd = &_ux_system_host->ux_system_host_hcd_array[0];
+}
+
+static void Host_Localizar_Endpoints(void) {
+    UX_CONFIGURATION *config = UX_NULL;
+
+    if (ux_host_stack_device_configuration_get(s_host.device, 0, &config) != UX_SUCCESS) {
+        Falhar("configuracao nao encontrada");
+    }
+    for (UX_INTERFACE *itf = config->ux_configuration_first_interface; itf != UX_NULL;
+         itf = itf->ux_interface_next_interface) {
+        if (itf->ux_interface_descriptor.bInterfaceClass != SIM_CLASSE_CDC_DADOS) {
+            continue;
+        }
+        for (UX_ENDPOINT *ep = itf->ux_interface_first_endpoint; ep != UX_NULL;
+             ep = ep->ux_endpoint_next_endpoint) {
+            if ((ep->ux_endpoint_descriptor.bmAttributes & UX_MASK_ENDPOINT_TYPE) != UX_BULK_ENDPOINT) {
+                continue;
+            }
+            // O sentido da transferencia fica a cargo da classe host (o HCD
+            // simulado o le do tipo do pedido, nao do endereco do endpoint)
+            if (ep->ux_endpoint_descriptor.bEndpointAddress & UX_ENDPOINT_DIRECTION) {
+                ep->ux_endpoint_transfer_request.ux_transfer_request_type = UX_REQUEST_IN;
+                s_host.ep_in = ep;
+            } else {
+                ep->ux_endpoint_transfer_request.ux_transfer_request_type = UX_REQUEST_OUT;
+                s_host.ep_out = ep;
+            }
+        }
+    }
+    if (s_host.ep_in == UX_NULL || s_host.ep_out == UX_NULL) {
+        Falhar("endpoints bulk da CDC nao encontrados");
+    }
+}
+
+// ------------------------------------------------------------
+// Medicoes
+// ------------------------------------------------------------
+
+static void Tasks_Reset(void) {
+    memset(&s_tasks, 0, sizeof(s_tasks));
+}
+
+static uint64_t Tasks_Medio_ns(void) {
+    return (s_tasks.chamadas > 0U) ? (s_tasks.ns_total / s_tasks.chamadas) : 0U;
+}
+
+static void Tasks_Imprimir(const char *fase) {
+    printf("  tasks_run (%s): %llu chamadas, medio %llu ns, max %llu ns\n", fase,
+           (unsigned long long)s_tasks.chamadas, (unsigned long long)Tasks_Medio_ns(),
+           (unsigned long long)s_tasks.ns_max);
+}
+
+static int Comparar_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static uint64_t Enumerar(void) {
+    uint64_t t0 = Agora_ns();
+    uint64_t limite = s_passos + SIM_PASSOS_MAX;
+
+    while (cdc_acm == UX_NULL || ux_host_stack_device_get(0, &s_host.device) != UX_SUCCESS ||
+           s_host.device->ux_device_state != UX_DEVICE_CONFIGURED) {
+        if (s_passos >= limite) {
+            Falhar("enumeracao nao concluiu");
+        }
+        Sim_Passo();
+    }
+    return Agora_ns() - t0;
+}
+
+// Pacote de 64 bytes: OUT no host -> eco no device -> IN no host
+static void Medir_Latencia(uint32_t amostras, uint64_t *mediana_ns) {
+    uint64_t *ns = malloc(amostras * sizeof(uint64_t));
+    uint64_t *passos = malloc(amostras * sizeof(uint64_t));
+    if (ns == NULL || passos == NULL) {
+        Falhar("sem memoria para as amostras");
+    }
+
+    s_dev.modo = DEV_ECO;
+    s_dev.tx_concluidos = 0;
+    Tasks_Reset();
+    for (uint32_t a = 0; a < amostras; a++) {
+        for (uint32_t i = 0; i < SIM_PACOTE; i++) {
+            s_host.tx[i] = (uint8_t)(a + i);
+        }
+
+        uint64_t p0 = s_passos;
+        uint64_t t0 = Agora_ns();
+        Host_Iniciar(s_host.ep_out, s_host.tx, SIM_PACOTE);
+        Host_Iniciar(s_host.ep_in, s_host.rx, SIM_PACOTE);
+        Host_Aguardar(s_host.ep_out);
+        ULONG n = Host_Aguardar(s_host.ep_in);
+        ns[a] = Agora_ns() - t0;
+        passos[a] = s_passos - p0;
+        Dev_Aguardar(&s_dev.tx_concluidos, a + 1U);
+
+        if (n != SIM_PACOTE || memcmp(s_host.tx, s_host.rx, SIM_PACOTE) != 0) {
+            Falhar("eco diferente do enviado");
+        }
+    }
+
+    qsort(ns, amostras, sizeof(uint64_t), Comparar_u64);
+    qsort(passos, amostras, sizeof(uint64_t), Comparar_u64);
+    *mediana_ns = ns[amostras / 2U];
+
+    printf("Latencia de eco (%u pacotes de %u bytes):\n", (unsigned)amostras, (unsigned)SIM_PACOTE);
+    printf("  min/mediana/p99/max: %.1f/%.1f/%.1f/%.1f us, mediana de %llu passos\n",
+           ns[0] / 1000.0, ns[amostras / 2U] / 1000.0, ns[(amostras * 99U) / 100U] / 1000.0,
+           ns[amostras - 1U] / 1000.0, (unsigned long long)passos[amostras / 2U]);
+    Tasks_Imprimir("eco");
+
+    free(ns);
+    free(passos);
+}
+
+// Host -> device: o host envia o padrao em blocos, o device confere
+static double Medir_Vazao_Out(uint32_t bytes) {
+    s_dev.modo = DEV_SUMIDOURO;
+    s_dev.recebidos = 0;
+    s_dev.seq = 0;
+    s_dev.erro_padrao = false;
+    s_dev.rx_concluidos = 0;
+    Tasks_Reset();
+
+    uint8_t seq = 0;
+    uint32_t blocos = 0;
+    uint64_t t0 = Agora_ns();
+    for (uint32_t enviados = 0; enviados < bytes; ) {
+        ULONG n = ((bytes - enviados) < SIM_BLOCO) ? (bytes - enviados) : SIM_BLOCO;
+        for (ULONG i = 0; i < n; i++) {
+            s_host.tx[i] = seq++;
+        }
+        Host_Iniciar(s_host.ep_out, s_host.tx, n);
+        enviados += Host_Aguardar(s_host.ep_out);
+        Dev_Aguardar(&s_dev.rx_concluidos, ++blocos);
+    }
+    uint64_t dt = Agora_ns() - t0;
+
+    if (s_dev.erro_padrao || s_dev.recebidos != bytes) {
+        Falhar("padrao corrompido no sentido OUT");
+    }
+
+    double kBps = (bytes / 1024.0) / (dt / 1e9);
+    printf("Vazao OUT (host -> device, %lu bytes em blocos de %u): %.0f kB/s\n",
+           (unsigned long)bytes, (unsigned)SIM_BLOCO, kBps);
+    Tasks_Imprimir("OUT");
+    return kBps;
+}
+
+// Device -> host: o device gera o padrao, o host confere
+static double Medir_Vazao_In(uint32_t bytes) {
+    s_dev.modo = DEV_FONTE;
+    s_dev.restante = bytes;
+    s_dev.seq = 0;
+    s_dev.tx_pendente = false;
+    s_dev.tx_concluidos = 0;
+    Tasks_Reset();
+
+    uint8_t seq = 0;
+    uint32_t blocos = 0;
+    uint64_t t0 = Agora_ns();
+    for (uint32_t recebidos = 0; recebidos < bytes; ) {
+        ULONG pedido = ((bytes - recebidos) < SIM_BLOCO) ? (bytes - recebidos) : SIM_BLOCO;
+        Host_Iniciar(s_host.ep_in, s_host.rx, pedido);
+        ULONG n = Host_Aguardar(s_host.ep_in);
+        for (ULONG i = 0; i < n; i++) {
+            if (s_host.rx[i] != seq++) {
+                Falhar("padrao corrompido no sentido IN");
+            }
+        }
+        recebidos += n;
+        Dev_Aguardar(&s_dev.tx_concluidos, ++blocos);
+    }
+    uint64_t dt = Agora_ns() - t0;
+
+    double kBps = (bytes / 1024.0) / (dt / 1e9);
+    printf("Vazao IN (device -> host, %lu bytes em blocos de %u): %.0f kB/s\n",
+           (unsigned long)bytes, (unsigned)SIM_BLOCO, kBps);
+    Tasks_Imprimir("IN");
+    return kBps;
+}
+
+static uint32_t Ler_Argumento(int argc, char **argv, const char *nome, uint32_t padrao) {
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], nome) == 0) {
+            return (uint32_t)strtoul(argv[i + 1], NULL, 0);
+        }
+    }
+    return padrao;
+}
+
+// ============================================================
+// Programa
+// ============================================================
+
+int main(int argc, char **argv) {
+    uint32_t bytes = Ler_Argumento(argc, argv, "--bytes", SIM_BYTES_PADRAO);
+    uint32_t amostras = Ler_Argumento(argc, argv, "--amostras", SIM_AMOSTRAS_PADRAO);
+    if (bytes == 0U || amostras == 0U) {
+        fprintf(stderr, "uso: %s [--bytes N] [--amostras N]\n", argv[0]);
+        return 2;
+    }
+
+    if (MX_USBX_Device_Init() != UX_SUCCESS) {
+        Falhar("MX_USBX_Device_Init");
+    }
+    Host_Inicializar();
+
+    uint64_t enum_ns = Enumerar();
+    Host_Localizar_Endpoints();
+    printf("Enumeracao: %.1f ms, %llu passos\n", enum_ns / 1e6, (unsigned long long)s_passos);
+
+    // Custo do tasks_run sem trafego (laco principal ocioso com a CDC configurada)
+    s_dev.modo = DEV_OCIOSO;
+    Tasks_Reset();
+    for (uint32_t i = 0; i < 10000U; i++) {
+        Sim_Passo();
+    }
+    uint64_t ocioso_ns = Tasks_Medio_ns();
+    Tasks_Imprimir("ocioso");
+
+    uint64_t latencia_ns;
+    Medir_Latencia(amostras, &latencia_ns);
+    uint64_t eco_ns = Tasks_Medio_ns();
+
+    double out_kBps = Medir_Vazao_Out(bytes);
+    double in_kBps = Medir_Vazao_In(bytes);
+
+    printf("usb_sim tasks_ocioso_ns=%llu tasks_eco_ns=%llu latencia_us=%.1f out_kBps=%.0f in_kBps=%.0f\n",
+           (unsigned long long)ocioso_ns, (unsigned long long)eco_ns, latencia_ns / 1000.0,
+           out_kBps, in_kBps);
+    return 0;
+}
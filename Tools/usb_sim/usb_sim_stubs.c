@@ -0,0 +1,199 @@
+/*
+ * Nome do Arquivo: usb_sim_stubs.c
+ * Descricao: Dependencias do app_usbx_device.c fora do escopo da bancada:
+ *            base de tempo do HAL e os callbacks de midia das classes MSC,
+ *            DFU e HID. As classes sao registradas como no firmware (mesmos
+ *            descritores e interfaces), mas so a CDC e exercitada
+ * Autor: Gabriel Agune
+ */
+
+// ============================================================
+// Includes
+// ============================================================
+
+#include "app_usbx_device.h"
+#include <time.h>
+
+// ============================================================
+// Definicoes e Constantes Privadas
+// ============================================================
+
+#define STUB_MSC_BLOCOS         64U
+#define STUB_MSC_BLOCO_BYTES    512U
+
+// ============================================================
+// Variaveis Globais
+// ============================================================
+
+uint32_t g_usb_sim_primask;
+
+// ============================================================
+// HAL
+// ============================================================
+
+uint32_t HAL_GetTick(void) {
+    static struct timespec inicio;
+    struct timespec agora;
+
+    clock_gettime(CLOCK_MONOTONIC, &agora);
+    if (inicio.tv_sec == 0 && inicio.tv_nsec == 0) {
+        inicio = agora;
+    }
+    return (uint32_t)((agora.tv_sec - inicio.tv_sec) * 1000L + (agora.tv_nsec - inicio.tv_nsec) / 1000000L);
+}
+
+// ============================================================
+// MSC
+// ============================================================
+
+VOID USBD_STORAGE_Activate(VOID *storage_instance) {
+    UX_PARAMETER_NOT_USED(storage_instance);
+}
+
+VOID USBD_STORAGE_Deactivate(VOID *storage_instance) {
+    UX_PARAMETER_NOT_USED(storage_instance);
+}
+
+UINT USBD_STORAGE_Read(VOID *storage_instance, ULONG lun, UCHAR *data_pointer,
+                       ULONG number_blocks, ULONG lba, ULONG *media_status) {
+    UX_PARAMETER_NOT_USED(storage_instance);
+    UX_PARAMETER_NOT_USED(lun);
+    UX_PARAMETER_NOT_USED(lba);
+    _ux_utility_memory_set(data_pointer, 0, number_blocks * STUB_MSC_BLOCO_BYTES);
+    *media_status = 0;
+    return UX_SUCCESS;
+}
+
+UINT USBD_STORAGE_Write(VOID *storage_instance, ULONG lun, UCHAR *data_pointer,
+                        ULONG number_blocks, ULONG lba, ULONG *media_status) {
+    UX_PARAMETER_NOT_USED(storage_instance);
+    UX_PARAMETER_NOT_USED(lun);
+    UX_PARAMETER_NOT_USED(data_pointer);
+    UX_PARAMETER_NOT_USED(number_blocks);
+    UX_PARAMETER_NOT_USED(lba);
+    *media_status = 0;
+    return UX_SUCCESS;
+}
+
+UINT USBD_STORAGE_Flush(VOID *storage_instance, ULONG lun, ULONG number_blocks,
+                        ULONG lba, ULONG *media_status) {
+    UX_PARAMETER_NOT_USED(storage_instance);
+    UX_PARAMETER_NOT_USED(lun);
+    UX_PARAMETER_NOT_USED(number_blocks);
+    UX_PARAMETER_NOT_USED(lba);
+    *media_status = 0;
+    return UX_SUCCESS;
+}
+
+UINT USBD_STORAGE_Status(VOID *storage_instance, ULONG lun, ULONG media_id,
+                         ULONG *media_status) {
+    UX_PARAMETER_NOT_USED(storage_instance);
+    UX_PARAMETER_NOT_USED(lun);
+    UX_PARAMETER_NOT_USED(media_id);
+    *media_status = 0;
+    return UX_SUCCESS;
+}
+
+UINT USBD_STORAGE_Notification(VOID *storage_instance, ULONG lun, ULONG media_id,
+                               ULONG notification_class, UCHAR **media_notification,
+                               ULONG *media_notification_length) {
+    UX_PARAMETER_NOT_USED(storage_instance);
+    UX_PARAMETER_NOT_USED(lun);
+    UX_PARAMETER_NOT_USED(media_id);
+    UX_PARAMETER_NOT_USED(notification_class);
+    UX_PARAMETER_NOT_USED(media_notification);
+    UX_PARAMETER_NOT_USED(media_notification_length);
+    return UX_SUCCESS;
+}
+
+ULONG USBD_STORAGE_GetMediaLastLba(VOID) {
+    return STUB_MSC_BLOCOS - 1U;
+}
+
+ULONG USBD_STORAGE_GetMediaBlocklength(VOID) {
+    return STUB_MSC_BLOCO_BYTES;
+}
+
+// ============================================================
+// DFU
+// ============================================================
+
+VOID DFU_Init(VOID *dfu_instance) {
+    UX_PARAMETER_NOT_USED(dfu_instance);
+}
+
+VOID DFU_DeInit(VOID *dfu_instance) {
+    UX_PARAMETER_NOT_USED(dfu_instance);
+}
+
+UINT DFU_GetStatus(VOID *dfu_instance, ULONG *media_status) {
+    UX_PARAMETER_NOT_USED(dfu_instance);
+    *media_status = UX_SLAVE_CLASS_DFU_MEDIA_STATUS_OK;
+    return UX_SUCCESS;
+}
+
+UINT DFU_Notify(VOID *dfu_instance, ULONG notification) {
+    UX_PARAMETER_NOT_USED(dfu_instance);
+    UX_PARAMETER_NOT_USED(notification);
+    return UX_SUCCESS;
+}
+
+UINT DFU_Read(VOID *dfu_instance, ULONG block_number, UCHAR *data_pointer,
+              ULONG length, ULONG *actual_length) {
+    UX_PARAMETER_NOT_USED(dfu_instance);
+    UX_PARAMETER_NOT_USED(block_number);
+    UX_PARAMETER_NOT_USED(data_pointer);
+    UX_PARAMETER_NOT_USED(length);
+    *actual_length = 0;
+    return UX_SUCCESS;
+}
+
+UINT DFU_Write(VOID *dfu_instance, ULONG block_number, UCHAR *data_pointer,
+               ULONG length, ULONG *media_status) {
+    UX_PARAMETER_NOT_USED(dfu_instance);
+    UX_PARAMETER_NOT_USED(block_number);
+    UX_PARAMETER_NOT_USED(data_pointer);
+    UX_PARAMETER_NOT_USED(length);
+    *media_status = UX_SLAVE_CLASS_DFU_MEDIA_STATUS_OK;
+    return UX_SUCCESS;
+}
+
+// ============================================================
+// HID
+// ============================================================
+
+VOID USBD_Custom_HID_Activate(VOID *hid_instance) {
+    UX_PARAMETER_NOT_USED(hid_instance);
+}
+
+VOID USBD_Custom_HID_Deactivate(VOID *hid_instance) {
+    UX_PARAMETER_NOT_USED(hid_instance);
+}
+
+UINT USBD_Custom_HID_SetFeature(UX_SLAVE_CLASS_HID *hid_instance,
+                                UX_SLAVE_CLASS_HID_EVENT *hid_event) {
+    UX_PARAMETER_NOT_USED(hid_instance);
+    UX_PARAMETER_NOT_USED(hid_event);
+    return UX_SUCCESS;
+}
+
+UINT USBD_Custom_HID_GetReport(UX_SLAVE_CLASS_HID *hid_instance,
+                               UX_SLAVE_CLASS_HID_EVENT *hid_event) {
+    UX_PARAMETER_NOT_USED(hid_instance);
+    UX_PARAMETER_NOT_USED(hid_event);
+    return UX_SUCCESS;
+}
+
+#ifdef UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT
+VOID USBD_Custom_HID_SetReport(struct UX_SLAVE_CLASS_HID_STRUCT *hid_instance) {
+    UX_PARAMETER_NOT_USED(hid_instance);
+}
+
+ULONG USBD_Custom_HID_EventMaxNumber(VOID) {
+    return USBD_CUSTOM_HID_RECEIVER_EVENTS;
+}
+
+ULONG USBD_Custom_HID_EventMaxLength(VOID) {
+    return USBD_HID_CUSTOM_EPOUT_FS_MPS;
+}
+#endif /* UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT */
@@ -54,6 +54,15 @@ __ALIGN_BEGIN static UCHAR ux_device_byte_pool_buffer[UX_DEVICE_APP_MEM_POOL_SIZ
 static ULONG cdc_acm_interface_number;
 static ULONG cdc_acm_configuration_number;
 static UX_SLAVE_CLASS_CDC_ACM_PARAMETER cdc_acm_parameter;
+static ULONG storage_interface_number;
+static ULONG storage_configuration_number;
+static UX_SLAVE_CLASS_STORAGE_PARAMETER storage_parameter;
+static ULONG dfu_interface_number;
+static ULONG dfu_configuration_number;
+static UX_SLAVE_CLASS_DFU_PARAMETER dfu_parameter;
+static ULONG hid_custom_interface_number;
+static ULONG hid_custom_configuration_number;
+static UX_SLAVE_CLASS_HID_PARAMETER custom_hid_parameter;
 
 /* USER CODE BEGIN PV */
 
@@ -155,6 +164,135 @@ UINT MX_USBX_Device_Init(VOID)
     /* USER CODE END USBX_DEVICE_CDC_ACM_REGISTER_ERROR */
   }
 
+  /* Initialize the storage class parameters for the device */
+  storage_parameter.ux_slave_class_storage_instance_activate   = USBD_STORAGE_Activate;
+  storage_parameter.ux_slave_class_storage_instance_deactivate = USBD_STORAGE_Deactivate;
+
+  /* Store the number of LUN in this device storage instance */
+  storage_parameter.ux_slave_class_storage_parameter_number_lun = STORAGE_NUMBER_LUN;
+
+  /* Initialize the storage class parameters for reading/writing to the Flash Disk */
+  storage_parameter.ux_slave_class_storage_parameter_lun[0].
+    ux_slave_class_storage_media_last_lba = USBD_STORAGE_GetMediaLastLba();
+
+  storage_parameter.ux_slave_class_storage_parameter_lun[0].
+    ux_slave_class_storage_media_block_length = USBD_STORAGE_GetMediaBlocklength();
+
+  storage_parameter.ux_slave_class_storage_parameter_lun[0].
+    ux_slave_class_storage_media_type = 0;
+
+  storage_parameter.ux_slave_class_storage_parameter_lun[0].
+    ux_slave_class_storage_media_removable_flag = STORAGE_REMOVABLE_FLAG;
+
+  storage_parameter.ux_slave_class_storage_parameter_lun[0].
+    ux_slave_class_storage_media_read_only_flag = STORAGE_READ_ONLY;
+
+  storage_parameter.ux_slave_class_storage_parameter_lun[0].
+    ux_slave_class_storage_media_read = USBD_STORAGE_Read;
+
+  storage_parameter.ux_slave_class_storage_parameter_lun[0].
+    ux_slave_class_storage_media_write = USBD_STORAGE_Write;
+
+  storage_parameter.ux_slave_class_storage_parameter_lun[0].
+    ux_slave_class_storage_media_flush = USBD_STORAGE_Flush;
+
+  storage_parameter.ux_slave_class_storage_parameter_lun[0].
+    ux_slave_class_storage_media_status = USBD_STORAGE_Status;
+
+  storage_parameter.ux_slave_class_storage_parameter_lun[0].
+    ux_slave_class_storage_media_notification = USBD_STORAGE_Notification;
+
+  /* USER CODE BEGIN STORAGE_PARAMETER */
+
+  /* USER CODE END STORAGE_PARAMETER */
+
+  /* Get storage configuration number */
+  storage_configuration_number = USBD_Get_Configuration_Number(CLASS_TYPE_MSC, 0);
+
+  /* Find storage interface number */
+  storage_interface_number = USBD_Get_Interface_Number(CLASS_TYPE_MSC, 0);
+
+  /* Initialize the device storage class */
+  if (ux_device_stack_class_register(_ux_system_slave_class_storage_name,
+                                     ux_device_class_storage_entry,
+                                     storage_configuration_number,
+                                     storage_interface_number,
+                                     &storage_parameter) != UX_SUCCESS)
+  {
+    /* USER CODE BEGIN USBX_DEVICE_STORAGE_REGISTER_ERROR */
+    return UX_ERROR;
+    /* USER CODE END USBX_DEVICE_STORAGE_REGISTER_ERROR */
+  }
+
+  /* Initialize the dfu class parameters for the device */
+  dfu_parameter.ux_slave_class_dfu_parameter_instance_activate   = DFU_Init;
+  dfu_parameter.ux_slave_class_dfu_parameter_instance_deactivate = DFU_DeInit;
+  dfu_parameter.ux_slave_class_dfu_parameter_get_status          = DFU_GetStatus;
+  dfu_parameter.ux_slave_class_dfu_parameter_read                = DFU_Read;
+  dfu_parameter.ux_slave_class_dfu_parameter_write               = DFU_Write;
+  dfu_parameter.ux_slave_class_dfu_parameter_notify              = DFU_Notify;
+  dfu_parameter.ux_slave_class_dfu_parameter_framework           = device_framework_full_speed;
+  dfu_parameter.ux_slave_class_dfu_parameter_framework_length    = device_framework_fs_length;
+
+  /* USER CODE BEGIN DFU_PARAMETER */
+
+  /* USER CODE END DFU_PARAMETER */
+
+  /* Get dfu configuration number */
+  dfu_configuration_number = USBD_Get_Configuration_Number(CLASS_TYPE_DFU, 0);
+
+  /* Find dfu interface number */
+  dfu_interface_number = USBD_Get_Interface_Number(CLASS_TYPE_DFU, 0);
+
+  /* Initialize the device dfu class */
+  if (ux_device_stack_class_register(_ux_system_slave_class_dfu_name,
+                                     ux_device_class_dfu_entry,
+                                     dfu_configuration_number,
+                                     dfu_interface_number,
+                                     &dfu_parameter) != UX_SUCCESS)
+  {
+    /* USER CODE BEGIN USBX_DEVICE_DFU_REGISTER_ERROR */
+    return UX_ERROR;
+    /* USER CODE END USBX_DEVICE_DFU_REGISTER_ERROR */
+  }
+
+  /* Initialize the hid custom class parameters for the device */
+  custom_hid_parameter.ux_slave_class_hid_instance_activate         = USBD_Custom_HID_Activate;
+  custom_hid_parameter.ux_slave_class_hid_instance_deactivate       = USBD_Custom_HID_Deactivate;
+  custom_hid_parameter.ux_device_class_hid_parameter_report_address = USBD_HID_ReportDesc(0U);
+  custom_hid_parameter.ux_device_class_hid_parameter_report_length  = USBD_HID_ReportDesc_length(0U);
+  custom_hid_parameter.ux_device_class_hid_parameter_report_id      = UX_FALSE;
+  custom_hid_parameter.ux_device_class_hid_parameter_callback       = USBD_Custom_HID_SetFeature;
+  custom_hid_parameter.ux_device_class_hid_parameter_get_callback   = USBD_Custom_HID_GetReport;
+#ifdef UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT
+  custom_hid_parameter.ux_device_class_hid_parameter_receiver_initialize       = ux_device_class_hid_receiver_initialize;
+  custom_hid_parameter.ux_device_class_hid_parameter_receiver_event_max_number = USBD_Custom_HID_EventMaxNumber();
+  custom_hid_parameter.ux_device_class_hid_parameter_receiver_event_max_length = USBD_Custom_HID_EventMaxLength();
+  custom_hid_parameter.ux_device_class_hid_parameter_receiver_event_callback   = USBD_Custom_HID_SetReport;
+#endif /* UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT */
+
+  /* USER CODE BEGIN CUSTOM_HID_PARAMETER */
+
+  /* USER CODE END CUSTOM_HID_PARAMETER */
+
+  /* Get Custom hid configuration number */
+  hid_custom_configuration_number = USBD_Get_Configuration_Number(CLASS_TYPE_HID, 0);
+
+  /* Find Custom hid interface number */
+  hid_custom_interface_number = USBD_Get_Interface_Number(CLASS_TYPE_HID, 0);
+
+  /* Initialize the device hid custom class */
+  if (ux_device_stack_class_register(_ux_system_slave_class_hid_name,
+                                     ux_device_class_hid_entry,
+                                     hid_custom_configuration_number,
+                                     hid_custom_interface_number,
+                                     &custom_hid_parameter) != UX_SUCCESS)
+  {
+    /* USER CODE BEGIN USBX_DEVICE_HID_CUSTOM_REGISTER_ERROR */
+    return UX_ERROR;
+    /* USER CODE END USBX_DEVICE_HID_CUSTOM_REGISTER_ERROR */
+  }
+
   /* USER CODE BEGIN MX_USBX_Device_Init1 */
 
   /* USER CODE END MX_USBX_Device_Init1 */
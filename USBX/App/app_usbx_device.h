@@ -28,11 +28,14 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include "ux_api.h"
 #include "ux_device_cdc_acm.h"
+#include "ux_device_msc.h"
+#include "ux_device_dfu_media.h"
+#include "ux_device_customhid.h"
 #include "ux_device_descriptors.h"
 #include "ux_dcd_stm32.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-
+#include "usbx_memoria.h"
 /* USER CODE END Includes */
 
 /* Exported types ------------------------------------------------------------*/
@@ -45,7 +48,16 @@ extern "C" {
 #define USBX_DEVICE_MEMORY_STACK_SIZE       8192
 
 /* USER CODE BEGIN EC */
-
+#if USBX_MEMORIA_ARENA
+/* Stack e classes alocam na arena do usbx_memoria.c: o pool do
+   ux_system_initialize so guarda UX_SYSTEM, UX_SYSTEM_SLAVE e o byte pool
+   (vazio) que ele cria no restante */
+#undef  UX_DEVICE_APP_MEM_POOL_SIZE
+#undef  USBX_DEVICE_MEMORY_STACK_SIZE
+#define UX_DEVICE_APP_MEM_POOL_SIZE         (sizeof(UX_SYSTEM) + sizeof(UX_SYSTEM_SLAVE) + \
+                                             sizeof(UX_MEMORY_BYTE_POOL) + UX_ALIGN_MIN + 64U)
+#define USBX_DEVICE_MEMORY_STACK_SIZE       UX_DEVICE_APP_MEM_POOL_SIZE
+#endif /* USBX_MEMORIA_ARENA */
 /* USER CODE END EC */
 
 /* Exported macro ------------------------------------------------------------*/
@@ -104,6 +104,9 @@ VOID USBD_CDC_ACM_ParameterChange(VOID *cdc_acm_instance)
 }
 
 /* USER CODE BEGIN 1 */
+// Com UX_DEVICE_CLASS_CDC_ACM_ZERO_COPY o DCD usa o buffer do chamador ate o
+// UX_STATE_NEXT: ele precisa continuar valido enquanto a transferencia estiver armada
+// (a CLI usa CLI_TX_Pump/CLI_RX_Pump, que respeitam isso)
 uint32_t USBD_CDC_ACM_Transmit(uint8_t* buffer, uint32_t size, uint32_t* sent)
 {
     UINT retVal;
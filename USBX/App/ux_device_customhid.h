@@ -0,0 +1,81 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    ux_device_customhid.h
+  * @author  MCD Application Team
+  * @brief   USBX Device Custom HID interface header file
+  ******************************************************************************
+    * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __UX_DEVICE_CUSTOMHID_H__
+#define __UX_DEVICE_CUSTOMHID_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "ux_api.h"
+#include "ux_device_class_hid.h"
+
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+
+/* USER CODE END Includes */
+
+/* Exported types ------------------------------------------------------------*/
+/* USER CODE BEGIN ET */
+
+/* USER CODE END ET */
+
+/* Exported constants --------------------------------------------------------*/
+/* USER CODE BEGIN EC */
+
+/* USER CODE END EC */
+
+/* Exported macro ------------------------------------------------------------*/
+/* USER CODE BEGIN EM */
+
+/* USER CODE END EM */
+
+/* Exported functions prototypes ---------------------------------------------*/
+VOID USBD_Custom_HID_Activate(VOID *hid_instance);
+VOID USBD_Custom_HID_Deactivate(VOID *hid_instance);
+UINT USBD_Custom_HID_SetFeature(UX_SLAVE_CLASS_HID *hid_instance,
+                                UX_SLAVE_CLASS_HID_EVENT *hid_event);
+UINT USBD_Custom_HID_GetReport(UX_SLAVE_CLASS_HID *hid_instance,
+                               UX_SLAVE_CLASS_HID_EVENT *hid_event);
+#ifdef UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT
+VOID USBD_Custom_HID_SetReport(struct UX_SLAVE_CLASS_HID_STRUCT *hid_instance);
+ULONG USBD_Custom_HID_EventMaxNumber(VOID);
+ULONG USBD_Custom_HID_EventMaxLength(VOID);
+#endif /* UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT */
+
+/* USER CODE BEGIN EFP */
+
+/* USER CODE END EFP */
+
+/* Private defines -----------------------------------------------------------*/
+/* USER CODE BEGIN PD */
+#define USBD_CUSTOM_HID_RECEIVER_EVENTS       4U
+/* USER CODE END PD */
+
+/* USER CODE BEGIN 1 */
+
+/* USER CODE END 1 */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* __UX_DEVICE_CUSTOMHID_H__ */
@@ -46,8 +46,37 @@ USBD_DevClassHandleTypeDef  USBD_Device_FS, USBD_Device_HS;
 
 uint8_t UserClassInstance[USBD_MAX_CLASS_INTERFACES] = {
   CLASS_TYPE_CDC_ACM,
+  CLASS_TYPE_MSC,
+  CLASS_TYPE_DFU,
+#if USBD_HID_CUSTOM_CLASS_ACTIVATED == 1U
+  CLASS_TYPE_HID,
+#endif /* USBD_HID_CUSTOM_CLASS_ACTIVATED == 1U */
 };
 
+#if USBD_HID_CUSTOM_CLASS_ACTIVATED == 1U
+/* Custom HID report descriptor (vendor page 0xFF00):
+   input report of 32 bytes, output report of 8 bytes, no report ID */
+#if defined ( __ICCARM__ ) /* IAR Compiler */
+#pragma data_alignment=4
+#endif /* defined ( __ICCARM__ ) */
+__ALIGN_BEGIN static uint8_t USBD_HID_CUSTOM_ReportDesc[USBD_HID_CUSTOM_REPORT_DESC_SIZE] __ALIGN_END =
+{
+  0x06, 0x00, 0xFF,  /* Usage Page (Vendor Defined 0xFF00) */
+  0x09, 0x01,        /* Usage (0x01) */
+  0xA1, 0x01,        /* Collection (Application) */
+  0x09, 0x02,        /*   Usage (0x02) */
+  0x15, 0x00,        /*   Logical Minimum (0) */
+  0x26, 0xFF, 0x00,  /*   Logical Maximum (255) */
+  0x75, 0x08,        /*   Report Size (8) */
+  0x95, 0x20,        /*   Report Count (32) */
+  0x81, 0x02,        /*   Input (Data, Var, Abs) */
+  0x09, 0x03,        /*   Usage (0x03) */
+  0x95, 0x08,        /*   Report Count (8) */
+  0x91, 0x02,        /*   Output (Data, Var, Abs) */
+  0xC0               /* End Collection */
+};
+#endif /* USBD_HID_CUSTOM_CLASS_ACTIVATED == 1U */
+
 /* The generic device descriptor buffer that will be filled by builder
    Size of the buffer is the maximum possible device FS descriptor size. */
 #if defined ( __ICCARM__ ) /* IAR Compiler */
@@ -125,6 +154,21 @@ static void USBD_FrameWork_CDCDesc(USBD_DevClassHandleTypeDef *pdev,
                                    uint32_t pConf, uint32_t *Sze);
 #endif /* USBD_CDC_ACM_CLASS_ACTIVATED == 1U */
 
+#if USBD_MSC_CLASS_ACTIVATED == 1U
+static void USBD_FrameWork_MSCDesc(USBD_DevClassHandleTypeDef *pdev,
+                                   uint32_t pConf, uint32_t *Sze);
+#endif /* USBD_MSC_CLASS_ACTIVATED == 1U */
+
+#if USBD_DFU_CLASS_ACTIVATED == 1U
+static void USBD_FrameWork_DFUDesc(USBD_DevClassHandleTypeDef *pdev,
+                                   uint32_t pConf, uint32_t *Sze);
+#endif /* USBD_DFU_CLASS_ACTIVATED == 1U */
+
+#if USBD_HID_CUSTOM_CLASS_ACTIVATED == 1U
+static void USBD_FrameWork_HIDDesc(USBD_DevClassHandleTypeDef *pdev,
+                                   uint32_t pConf, uint32_t *Sze);
+#endif /* USBD_HID_CUSTOM_CLASS_ACTIVATED == 1U */
+
 /* USER CODE BEGIN PFP */
 
 /* USER CODE END PFP */
@@ -289,6 +333,8 @@ uint16_t USBD_Get_Configuration_Number(uint8_t class_type, uint8_t interface_typ
   uint8_t cfg_num = 1U;
 
   /* USER CODE BEGIN USBD_Get_CONFIGURATION_Number0 */
+  UNUSED(class_type);
+  UNUSED(interface_type);
 
   /* USER CODE END USBD_Get_CONFIGURATION_Number0 */
 
@@ -299,6 +345,34 @@ uint16_t USBD_Get_Configuration_Number(uint8_t class_type, uint8_t interface_typ
   return cfg_num;
 }
 
+#if USBD_HID_CUSTOM_CLASS_ACTIVATED == 1U
+/**
+  * @brief  USBD_HID_ReportDesc
+  *         Return the HID report descriptor
+  * @param  hid_type : HID interface type (only the custom interface is used)
+  * @retval pointer to the report descriptor
+  */
+uint8_t *USBD_HID_ReportDesc(uint8_t hid_type)
+{
+  UX_PARAMETER_NOT_USED(hid_type);
+
+  return USBD_HID_CUSTOM_ReportDesc;
+}
+
+/**
+  * @brief  USBD_HID_ReportDesc_length
+  *         Return the HID report descriptor length
+  * @param  hid_type : HID interface type (only the custom interface is used)
+  * @retval report descriptor length
+  */
+uint16_t USBD_HID_ReportDesc_length(uint8_t hid_type)
+{
+  UX_PARAMETER_NOT_USED(hid_type);
+
+  return (uint16_t)sizeof(USBD_HID_CUSTOM_ReportDesc);
+}
+#endif /* USBD_HID_CUSTOM_CLASS_ACTIVATED == 1U */
+
 /**
   * @brief  USBD_Desc_GetString
   *         Convert ASCII string into Unicode one
@@ -564,6 +638,107 @@ uint8_t  USBD_FrameWork_AddToConfDesc(USBD_DevClassHandleTypeDef *pdev, uint8_t
       break;
 
 #endif /* USBD_CDC_ACM_CLASS_ACTIVATED */
+
+#if USBD_MSC_CLASS_ACTIVATED == 1
+
+    case CLASS_TYPE_MSC:
+
+      /* Find the first available interface slot and Assign number of interfaces */
+      interface = USBD_FrameWork_FindFreeIFNbr(pdev);
+      pdev->tclasslist[pdev->classId].NumIf = 1U;
+      pdev->tclasslist[pdev->classId].Ifs[0] = interface;
+
+      /* Assign endpoint numbers */
+      pdev->tclasslist[pdev->classId].NumEps = 2U;  /* EP_IN, EP_OUT */
+
+      /* Check the current speed to assign endpoints */
+      if (Speed == USBD_HIGH_SPEED)
+      {
+        /* Assign OUT Endpoint */
+        USBD_FrameWork_AssignEp(pdev, USBD_MSC_EPOUT_ADDR,
+                                USBD_EP_TYPE_BULK, USBD_MSC_EPOUT_HS_MPS);
+
+        /* Assign IN Endpoint */
+        USBD_FrameWork_AssignEp(pdev, USBD_MSC_EPIN_ADDR,
+                                USBD_EP_TYPE_BULK, USBD_MSC_EPIN_HS_MPS);
+      }
+      else
+      {
+        /* Assign OUT Endpoint */
+        USBD_FrameWork_AssignEp(pdev, USBD_MSC_EPOUT_ADDR,
+                                USBD_EP_TYPE_BULK, USBD_MSC_EPOUT_FS_MPS);
+
+        /* Assign IN Endpoint */
+        USBD_FrameWork_AssignEp(pdev, USBD_MSC_EPIN_ADDR,
+                                USBD_EP_TYPE_BULK, USBD_MSC_EPIN_FS_MPS);
+      }
+
+      /* Configure and Append the Descriptor */
+      USBD_FrameWork_MSCDesc(pdev, (uint32_t)pCmpstConfDesc, &pdev->CurrConfDescSz);
+
+      break;
+
+#endif /* USBD_MSC_CLASS_ACTIVATED */
+
+#if USBD_DFU_CLASS_ACTIVATED == 1
+
+    case CLASS_TYPE_DFU:
+
+      /* Find the first available interface slot and Assign number of interfaces */
+      interface = USBD_FrameWork_FindFreeIFNbr(pdev);
+      pdev->tclasslist[pdev->classId].NumIf = 1U;
+      pdev->tclasslist[pdev->classId].Ifs[0] = interface;
+
+      /* Assign endpoint numbers */
+      pdev->tclasslist[pdev->classId].NumEps = 0U; /* only EP0 is used */
+
+      /* Configure and Append the Descriptor */
+      USBD_FrameWork_DFUDesc(pdev, (uint32_t)pCmpstConfDesc, &pdev->CurrConfDescSz);
+
+      break;
+
+#endif /* USBD_DFU_CLASS_ACTIVATED */
+
+#if USBD_HID_CUSTOM_CLASS_ACTIVATED == 1
+
+    case CLASS_TYPE_HID:
+
+      /* Find the first available interface slot and Assign number of interfaces */
+      interface = USBD_FrameWork_FindFreeIFNbr(pdev);
+      pdev->tclasslist[pdev->classId].NumIf = 1U;
+      pdev->tclasslist[pdev->classId].Ifs[0] = interface;
+
+      /* Assign endpoint numbers */
+      pdev->tclasslist[pdev->classId].NumEps = 2U;  /* EP_IN, EP_OUT */
+
+      /* Check the current speed to assign endpoints */
+      if (Speed == USBD_HIGH_SPEED)
+      {
+        /* Assign IN Endpoint */
+        USBD_FrameWork_AssignEp(pdev, USBD_HID_CUSTOM_EPIN_ADDR,
+                                USBD_EP_TYPE_INTR, USBD_HID_CUSTOM_EPIN_HS_MPS);
+
+        /* Assign OUT Endpoint */
+        USBD_FrameWork_AssignEp(pdev, USBD_HID_CUSTOM_EPOUT_ADDR,
+                                USBD_EP_TYPE_INTR, USBD_HID_CUSTOM_EPOUT_HS_MPS);
+      }
+      else
+      {
+        /* Assign IN Endpoint */
+        USBD_FrameWork_AssignEp(pdev, USBD_HID_CUSTOM_EPIN_ADDR,
+                                USBD_EP_TYPE_INTR, USBD_HID_CUSTOM_EPIN_FS_MPS);
+
+        /* Assign OUT Endpoint */
+        USBD_FrameWork_AssignEp(pdev, USBD_HID_CUSTOM_EPOUT_ADDR,
+                                USBD_EP_TYPE_INTR, USBD_HID_CUSTOM_EPOUT_FS_MPS);
+      }
+
+      /* Configure and Append the Descriptor */
+      USBD_FrameWork_HIDDesc(pdev, (uint32_t)pCmpstConfDesc, &pdev->CurrConfDescSz);
+
+      break;
+
+#endif /* USBD_HID_CUSTOM_CLASS_ACTIVATED */
     /* USER CODE BEGIN FrameWork_AddToConfDesc_1 */
 
     /* USER CODE END FrameWork_AddToConfDesc_1 */
@@ -758,6 +933,132 @@ static void USBD_FrameWork_CDCDesc(USBD_DevClassHandleTypeDef *pdev,
 }
 #endif /* USBD_CDC_ACM_CLASS_ACTIVATED == 1 */
 
+#if USBD_MSC_CLASS_ACTIVATED == 1
+/**
+  * @brief  USBD_FrameWork_MSCDesc
+  *         Configure and Append the MSC Descriptor
+  * @param  pdev: device instance
+  * @param  pConf: Configuration descriptor pointer
+  * @param  Sze: pointer to the current configuration descriptor size
+  * @retval None
+  */
+static void USBD_FrameWork_MSCDesc(USBD_DevClassHandleTypeDef *pdev,
+                                   uint32_t pConf, uint32_t *Sze)
+{
+  static USBD_IfDescTypedef       *pIfDesc;
+  static USBD_EpDescTypedef       *pEpDesc;
+
+  /* Append MSC Interface descriptor to Configuration descriptor */
+  __USBD_FRAMEWORK_SET_IF((pdev->tclasslist[pdev->classId].Ifs[0]), (0U), \
+                          (uint8_t)(pdev->tclasslist[pdev->classId].NumEps), \
+                          (0x08U), (0x06U), (0x50U), (0U));
+
+  /* Append Endpoint descriptor to Configuration descriptor */
+  __USBD_FRAMEWORK_SET_EP((pdev->tclasslist[pdev->classId].Eps[0].add), \
+                          (USBD_EP_TYPE_BULK), \
+                          (uint16_t)(pdev->tclasslist[pdev->classId].Eps[0].size), \
+                          (0U), (0U));
+
+  /* Append Endpoint descriptor to Configuration descriptor */
+  __USBD_FRAMEWORK_SET_EP((pdev->tclasslist[pdev->classId].Eps[1].add), \
+                          (USBD_EP_TYPE_BULK), \
+                          (uint16_t)(pdev->tclasslist[pdev->classId].Eps[1].size), \
+                          (0U), (0U));
+
+  /* Update Config Descriptor and IAD descriptor */
+  ((USBD_ConfigDescTypedef *)pConf)->bNumInterfaces += 1U;
+  ((USBD_ConfigDescTypedef *)pConf)->wDescriptorLength = *Sze;
+}
+#endif /* USBD_MSC_CLASS_ACTIVATED == 1 */
+
+#if USBD_DFU_CLASS_ACTIVATED == 1
+/**
+  * @brief  USBD_FrameWork_DFUDesc
+  *         Configure and Append the DFU Descriptor (runtime interface)
+  * @param  pdev: device instance
+  * @param  pConf: Configuration descriptor pointer
+  * @param  Sze: pointer to the current configuration descriptor size
+  * @retval None
+  */
+static void USBD_FrameWork_DFUDesc(USBD_DevClassHandleTypeDef *pdev,
+                                   uint32_t pConf, uint32_t *Sze)
+{
+  static USBD_IfDescTypedef       *pIfDesc;
+  static USBD_DFUFuncDescTypedef  *pDFUFuncDesc;
+
+  /* Append DFU Interface descriptor to Configuration descriptor */
+  __USBD_FRAMEWORK_SET_IF((pdev->tclasslist[pdev->classId].Ifs[0]), (0U), (0U), \
+                          (UX_SLAVE_CLASS_DFU_CLASS), (UX_SLAVE_CLASS_DFU_SUBCLASS), \
+                          (UX_SLAVE_CLASS_DFU_PROTOCOL_RUNTIME), (0U));
+
+  /* Append DFU Functional descriptor to Configuration descriptor */
+  pDFUFuncDesc = ((USBD_DFUFuncDescTypedef *)(pConf + *Sze));
+  pDFUFuncDesc->bLength = (uint8_t)sizeof(USBD_DFUFuncDescTypedef);
+  pDFUFuncDesc->bDescriptorType = USBD_DFU_FUNC_DESC_TYPE;
+  pDFUFuncDesc->bmAttributes = USBD_DFU_BM_ATTRIBUTES;
+  pDFUFuncDesc->wDetachTimeout = USBD_DFU_DETACH_TIMEOUT;
+  pDFUFuncDesc->wTransferSize = USBD_DFU_XFER_SIZE;
+  pDFUFuncDesc->bcdDFUVersion = USBD_DFU_VERSION;
+  *Sze += (uint32_t)sizeof(USBD_DFUFuncDescTypedef);
+
+  /* Update Config Descriptor */
+  ((USBD_ConfigDescTypedef *)pConf)->bNumInterfaces += 1U;
+  ((USBD_ConfigDescTypedef *)pConf)->wDescriptorLength = *Sze;
+}
+#endif /* USBD_DFU_CLASS_ACTIVATED == 1 */
+
+#if USBD_HID_CUSTOM_CLASS_ACTIVATED == 1
+/**
+  * @brief  USBD_FrameWork_HIDDesc
+  *         Configure and Append the HID Descriptor (custom interface)
+  * @param  pdev: device instance
+  * @param  pConf: Configuration descriptor pointer
+  * @param  Sze: pointer to the current configuration descriptor size
+  * @retval None
+  */
+static void USBD_FrameWork_HIDDesc(USBD_DevClassHandleTypeDef *pdev,
+                                   uint32_t pConf, uint32_t *Sze)
+{
+  static USBD_IfDescTypedef       *pIfDesc;
+  static USBD_EpDescTypedef       *pEpDesc;
+  static USBD_HIDDescTypedef      *pHidDesc;
+
+  /* Append HID Interface descriptor to Configuration descriptor */
+  __USBD_FRAMEWORK_SET_IF((pdev->tclasslist[pdev->classId].Ifs[0]), (0U), \
+                          (uint8_t)(pdev->tclasslist[pdev->classId].NumEps), \
+                          (0x03U), (0x00U), (0x00U), (0U));
+
+  /* Append HID Class descriptor to Configuration descriptor */
+  pHidDesc = ((USBD_HIDDescTypedef *)(pConf + *Sze));
+  pHidDesc->bLength = (uint8_t)sizeof(USBD_HIDDescTypedef);
+  pHidDesc->bDescriptorType = USBD_HID_DESC_TYPE;
+  pHidDesc->bcdHID = USBD_HID_VERSION;
+  pHidDesc->bCountryCode = 0x00U;
+  pHidDesc->bNumDescriptors = 0x01U;
+  pHidDesc->bHIDDescriptorType = USBD_HID_REPORT_DESC_TYPE;
+  pHidDesc->wItemLength = USBD_HID_ReportDesc_length(0U);
+  *Sze += (uint32_t)sizeof(USBD_HIDDescTypedef);
+
+  /* Append Endpoint descriptor to Configuration descriptor */
+  __USBD_FRAMEWORK_SET_EP((pdev->tclasslist[pdev->classId].Eps[0].add), \
+                          (USBD_EP_TYPE_INTR), \
+                          (uint16_t)(pdev->tclasslist[pdev->classId].Eps[0].size), \
+                          (USBD_HID_CUSTOM_EPIN_HS_BINTERVAL), \
+                          (USBD_HID_CUSTOM_EPIN_FS_BINTERVAL));
+
+  /* Append Endpoint descriptor to Configuration descriptor */
+  __USBD_FRAMEWORK_SET_EP((pdev->tclasslist[pdev->classId].Eps[1].add), \
+                          (USBD_EP_TYPE_INTR), \
+                          (uint16_t)(pdev->tclasslist[pdev->classId].Eps[1].size), \
+                          (USBD_HID_CUSTOM_EPOUT_HS_BINTERVAL), \
+                          (USBD_HID_CUSTOM_EPOUT_FS_BINTERVAL));
+
+  /* Update Config Descriptor */
+  ((USBD_ConfigDescTypedef *)pConf)->bNumInterfaces += 1U;
+  ((USBD_ConfigDescTypedef *)pConf)->wDescriptorLength = *Sze;
+}
+#endif /* USBD_HID_CUSTOM_CLASS_ACTIVATED == 1 */
+
 /* USER CODE BEGIN 1 */
 
 /* USER CODE END 1 */
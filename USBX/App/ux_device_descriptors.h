@@ -29,6 +29,9 @@ extern "C" {
 #include "ux_api.h"
 #include "ux_stm32_config.h"
 #include "ux_device_class_cdc_acm.h"
+#include "ux_device_class_storage.h"
+#include "ux_device_class_dfu.h"
+#include "ux_device_class_hid.h"
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
@@ -37,11 +40,14 @@ extern "C" {
 
 /* Private defines -----------------------------------------------------------*/
 #define USBD_MAX_NUM_CONFIGURATION                     1U
-#define USBD_MAX_SUPPORTED_CLASS                       3U
+#define USBD_MAX_SUPPORTED_CLASS                       4U
 #define USBD_MAX_CLASS_ENDPOINTS                       9U
 #define USBD_MAX_CLASS_INTERFACES                      12U
 
 #define USBD_CDC_ACM_CLASS_ACTIVATED                   1U
+#define USBD_MSC_CLASS_ACTIVATED                       1U
+#define USBD_DFU_CLASS_ACTIVATED                       1U
+#define USBD_HID_CUSTOM_CLASS_ACTIVATED                1U
 
 #define USBD_CONFIG_MAXPOWER                           25U
 #define USBD_COMPOSITE_USE_IAD                         1U
@@ -242,8 +248,33 @@ typedef struct
   uint8_t bSlaveInterface;
 } __PACKED USBD_CDCUnionFuncDescTypedef;
 
+typedef struct
+{
+  /* DFU Functional Descriptor */
+  uint8_t bLength;
+  uint8_t bDescriptorType;
+  uint8_t bmAttributes;
+  uint16_t wDetachTimeout;
+  uint16_t wTransferSize;
+  uint16_t bcdDFUVersion;
+} __PACKED USBD_DFUFuncDescTypedef;
+
 #endif /* (USBD_CDC_ACM_CLASS_ACTIVATED == 1) || (USBD_RNDIS_CLASS_ACTIVATED == 1)  || (USBD_CDC_ECM_CLASS_ACTIVATED == 1)*/
 
+#if USBD_HID_CUSTOM_CLASS_ACTIVATED == 1
+typedef struct
+{
+  /* HID Class Descriptor */
+  uint8_t bLength;
+  uint8_t bDescriptorType;
+  uint16_t bcdHID;
+  uint8_t bCountryCode;
+  uint8_t bNumDescriptors;
+  uint8_t bHIDDescriptorType;
+  uint16_t wItemLength;
+} __PACKED USBD_HIDDescTypedef;
+#endif /* USBD_HID_CUSTOM_CLASS_ACTIVATED == 1 */
+
 /* Exported functions prototypes ---------------------------------------------*/
 /* USER CODE BEGIN EFP */
 
@@ -254,6 +285,10 @@ uint8_t *USBD_Get_String_Framework(ULONG *Length);
 uint8_t *USBD_Get_Language_Id_Framework(ULONG *Length);
 uint16_t USBD_Get_Interface_Number(uint8_t class_type, uint8_t interface_type);
 uint16_t USBD_Get_Configuration_Number(uint8_t class_type, uint8_t interface_type);
+#if USBD_HID_CUSTOM_CLASS_ACTIVATED == 1
+uint8_t *USBD_HID_ReportDesc(uint8_t hid_type);
+uint16_t USBD_HID_ReportDesc_length(uint8_t hid_type);
+#endif /* USBD_HID_CUSTOM_CLASS_ACTIVATED == 1 */
 
 /* Private defines -----------------------------------------------------------*/
 /* USER CODE BEGIN Private_defines */
@@ -305,6 +340,37 @@ uint16_t USBD_Get_Configuration_Number(uint8_t class_type, uint8_t interface_typ
 #define USBD_CDCACM_EPINCMD_FS_BINTERVAL              5U
 #define USBD_CDCACM_EPINCMD_HS_BINTERVAL              5U
 
+/* Device Storage Class */
+#define USBD_MSC_EPOUT_ADDR                           0x04U
+#define USBD_MSC_EPIN_ADDR                            0x84U
+#define USBD_MSC_EPOUT_FS_MPS                         64U
+#define USBD_MSC_EPOUT_HS_MPS                         512U
+#define USBD_MSC_EPIN_FS_MPS                          64U
+#define USBD_MSC_EPIN_HS_MPS                          512U
+
+/* Device DFU Class (runtime) */
+#define USBD_DFU_FUNC_DESC_TYPE                       0x21U
+#define USBD_DFU_BM_ATTRIBUTES                        0x09U  /* Will detach + can download */
+#define USBD_DFU_DETACH_TIMEOUT                       1000U
+#define USBD_DFU_XFER_SIZE                            256U   /* <= UX_SLAVE_REQUEST_CONTROL_MAX_LENGTH */
+#define USBD_DFU_VERSION                              0x011AU
+
+/* Device HID Class (custom, vendor page) */
+#define USBD_HID_CUSTOM_EPIN_ADDR                     0x85U
+#define USBD_HID_CUSTOM_EPIN_FS_MPS                   32U
+#define USBD_HID_CUSTOM_EPIN_HS_MPS                   32U
+#define USBD_HID_CUSTOM_EPIN_FS_BINTERVAL             1U
+#define USBD_HID_CUSTOM_EPIN_HS_BINTERVAL             4U   /* 2^(4-1) microframes = 1 ms */
+#define USBD_HID_CUSTOM_EPOUT_ADDR                    0x05U
+#define USBD_HID_CUSTOM_EPOUT_FS_MPS                  8U
+#define USBD_HID_CUSTOM_EPOUT_HS_MPS                  8U
+#define USBD_HID_CUSTOM_EPOUT_FS_BINTERVAL            1U
+#define USBD_HID_CUSTOM_EPOUT_HS_BINTERVAL            4U
+#define USBD_HID_CUSTOM_REPORT_DESC_SIZE              27U
+#define USBD_HID_DESC_TYPE                            0x21U
+#define USBD_HID_REPORT_DESC_TYPE                     0x22U
+#define USBD_HID_VERSION                              0x0111U
+
 #ifndef USBD_CONFIG_STR_DESC_IDX
 #define USBD_CONFIG_STR_DESC_IDX                      0U
 #endif /* USBD_CONFIG_STR_DESC_IDX */
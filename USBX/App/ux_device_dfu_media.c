@@ -0,0 +1,175 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    ux_device_dfu_media.c
+  * @author  MCD Application Team
+  * @brief   USBX Device applicative file
+  ******************************************************************************
+    * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ux_device_dfu_media.h"
+
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+#include "dfu_runtime.h"
+/* USER CODE END Includes */
+
+/* Private typedef -----------------------------------------------------------*/
+/* USER CODE BEGIN PTD */
+
+/* USER CODE END PTD */
+
+/* Private define ------------------------------------------------------------*/
+/* USER CODE BEGIN PD */
+
+/* USER CODE END PD */
+
+/* Private macro -------------------------------------------------------------*/
+/* USER CODE BEGIN PM */
+
+/* USER CODE END PM */
+
+/* Private variables ---------------------------------------------------------*/
+/* USER CODE BEGIN PV */
+
+/* USER CODE END PV */
+
+/* Private function prototypes -----------------------------------------------*/
+/* USER CODE BEGIN PFP */
+
+/* USER CODE END PFP */
+
+/* Private user code ---------------------------------------------------------*/
+/* USER CODE BEGIN 0 */
+
+/* USER CODE END 0 */
+
+/**
+  * @brief  Initializes Memory routine.
+  * @param  dfu_instance: Pointer to the dfu class instance.
+  * @retval none
+  */
+VOID DFU_Init(VOID *dfu_instance)
+{
+  /* USER CODE BEGIN DFU_Init */
+  DFU_Runtime_Set_Instancia(dfu_instance);
+  /* USER CODE END DFU_Init */
+
+  return;
+}
+
+/**
+  * @brief  DeInitializes Memory routine.
+  * @param  dfu_instance: Pointer to the dfu class instance.
+  * @retval none
+  */
+VOID DFU_DeInit(VOID *dfu_instance)
+{
+  /* USER CODE BEGIN DFU_DeInit */
+  /* A instancia continua alocada (criada no registro da classe): o estado
+     APP_DETACH ainda precisa ser lido apos o soft-disconnect */
+  UX_PARAMETER_NOT_USED(dfu_instance);
+  /* USER CODE END DFU_DeInit */
+
+  return;
+}
+
+/**
+  * @brief  Get status routine.
+  * @param  dfu_instance: Pointer to the dfu class instance.
+  * @param  media_status: dfu media status.
+  * @retval UX_SUCCESS.
+  */
+UINT DFU_GetStatus(VOID *dfu_instance, ULONG *media_status)
+{
+  /* USER CODE BEGIN DFU_GetStatus */
+  UX_PARAMETER_NOT_USED(dfu_instance);
+  *media_status = UX_SLAVE_CLASS_DFU_MEDIA_STATUS_OK;
+  /* USER CODE END DFU_GetStatus */
+
+  return (UX_SUCCESS);
+}
+
+/**
+  * @brief  Inform application when a begin and end of download or upload.
+  * @param  dfu_instance: Pointer to the dfu class instance.
+  * @param  notification: unused.
+  * @retval status.
+  */
+UINT DFU_Notify(VOID *dfu_instance, ULONG notification)
+{
+  UINT status = UX_SUCCESS;
+
+  /* USER CODE BEGIN DFU_Notify */
+  UX_PARAMETER_NOT_USED(dfu_instance);
+  UX_PARAMETER_NOT_USED(notification);
+  /* USER CODE END DFU_Notify */
+
+  return status;
+}
+
+/**
+  * @brief  Memory read routine (runtime interface: download/upload handled by ROM).
+  * @param  dfu_instance: Pointer to the dfu class instance.
+  * @param  block_number: block number.
+  * @param  data_pointer: Pointer to the Source buffer.
+  * @param  length: Number of data to be read (in bytes).
+  * @param  actual_length: length of data read.
+  * @retval status.
+  */
+UINT DFU_Read(VOID *dfu_instance, ULONG block_number, UCHAR *data_pointer,
+              ULONG length, ULONG *actual_length)
+{
+  UINT status = UX_ERROR;
+
+  /* USER CODE BEGIN DFU_Read */
+  UX_PARAMETER_NOT_USED(dfu_instance);
+  UX_PARAMETER_NOT_USED(block_number);
+  UX_PARAMETER_NOT_USED(data_pointer);
+  UX_PARAMETER_NOT_USED(length);
+  *actual_length = 0;
+  /* USER CODE END DFU_Read */
+
+  return status;
+}
+
+/**
+  * @brief  Memory write routine (runtime interface: download/upload handled by ROM).
+  * @param  dfu_instance: Pointer to the dfu class instance.
+  * @param  block_number: block number.
+  * @param  data_pointer: Pointer to the Source buffer.
+  * @param  length: Number of data to be written (in bytes).
+  * @param  media_status: dfu media status.
+  * @retval status.
+  */
+UINT DFU_Write(VOID *dfu_instance, ULONG block_number, UCHAR *data_pointer,
+               ULONG length, ULONG *media_status)
+{
+  UINT status = UX_ERROR;
+
+  /* USER CODE BEGIN DFU_Write */
+  UX_PARAMETER_NOT_USED(dfu_instance);
+  UX_PARAMETER_NOT_USED(block_number);
+  UX_PARAMETER_NOT_USED(data_pointer);
+  UX_PARAMETER_NOT_USED(length);
+  *media_status = UX_SLAVE_CLASS_DFU_MEDIA_STATUS_ERROR;
+  /* USER CODE END DFU_Write */
+
+  return status;
+}
+
+/* USER CODE BEGIN 1 */
+
+/* USER CODE END 1 */
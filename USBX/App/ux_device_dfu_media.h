@@ -0,0 +1,78 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    ux_device_dfu_media.h
+  * @author  MCD Application Team
+  * @brief   USBX Device DFU interface header file
+  ******************************************************************************
+    * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __UX_DEVICE_DFU_MEDIA_H__
+#define __UX_DEVICE_DFU_MEDIA_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "ux_api.h"
+#include "ux_device_class_dfu.h"
+
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+
+/* USER CODE END Includes */
+
+/* Exported types ------------------------------------------------------------*/
+/* USER CODE BEGIN ET */
+
+/* USER CODE END ET */
+
+/* Exported constants --------------------------------------------------------*/
+/* USER CODE BEGIN EC */
+
+/* USER CODE END EC */
+
+/* Exported macro ------------------------------------------------------------*/
+/* USER CODE BEGIN EM */
+
+/* USER CODE END EM */
+
+/* Exported functions prototypes ---------------------------------------------*/
+VOID DFU_Init(VOID *dfu_instance);
+VOID DFU_DeInit(VOID *dfu_instance);
+UINT DFU_GetStatus(VOID *dfu_instance, ULONG *media_status);
+UINT DFU_Notify(VOID *dfu_instance, ULONG notification);
+UINT DFU_Read(VOID *dfu_instance, ULONG block_number, UCHAR *data_pointer,
+              ULONG length, ULONG *actual_length);
+UINT DFU_Write(VOID *dfu_instance, ULONG block_number, UCHAR *data_pointer,
+               ULONG length, ULONG *media_status);
+
+/* USER CODE BEGIN EFP */
+
+/* USER CODE END EFP */
+
+/* Private defines -----------------------------------------------------------*/
+/* USER CODE BEGIN PD */
+
+/* USER CODE END PD */
+
+/* USER CODE BEGIN 1 */
+
+/* USER CODE END 1 */
+
+#ifdef __cplusplus
+}
+#endif
+#endif  /* __UX_DEVICE_DFU_MEDIA_H__ */
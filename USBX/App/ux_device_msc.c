@@ -0,0 +1,287 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    ux_device_msc.c
+  * @author  MCD Application Team
+  * @brief   USBX Device applicative file
+  ******************************************************************************
+    * @attention
+  *
+  * Copyright (c) 2025 STMicroelectronics.
+  * All rights reserved.
+  *
+  * This software is licensed under terms that can be found in the LICENSE file
+  * in the root directory of this software component.
+  * If no LICENSE file comes with this software, it is provided AS-IS.
+  *
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "ux_device_msc.h"
+
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+#include "disco_virtual.h"
+/* USER CODE END Includes */
+
+/* Private typedef -----------------------------------------------------------*/
+/* USER CODE BEGIN PTD */
+
+/* USER CODE END PTD */
+
+/* Private define ------------------------------------------------------------*/
+/* USER CODE BEGIN PD */
+// Sense data (key, ASC, ASCQ) devolvidos ao host
+#define STORAGE_SENSE_PROTEGIDO   UX_DEVICE_CLASS_STORAGE_SENSE_STATUS(0x07, 0x27, 0x00)  // Data protect / write protected
+#define STORAGE_SENSE_LEITURA     UX_DEVICE_CLASS_STORAGE_SENSE_STATUS(0x03, 0x11, 0x00)  // Medium error / unrecovered read
+/* USER CODE END PD */
+
+/* Private macro -------------------------------------------------------------*/
+/* USER CODE BEGIN PM */
+
+/* USER CODE END PM */
+
+/* Private variables ---------------------------------------------------------*/
+/* USER CODE BEGIN PV */
+// Bloco corrente de um comando de leitura com varios setores (retomado apos UX_STATE_WAIT)
+static ULONG storage_bloco_atual = 0;
+/* USER CODE END PV */
+
+/* Private function prototypes -----------------------------------------------*/
+/* USER CODE BEGIN PFP */
+
+/* USER CODE END PFP */
+
+/* Private user code ---------------------------------------------------------*/
+/* USER CODE BEGIN 0 */
+
+/* USER CODE END 0 */
+
+/**
+  * @brief  USBD_STORAGE_Activate
+  *         This function is called when insertion of a storage device.
+  * @param  storage_instance: Pointer to the storage class instance.
+  * @retval none
+  */
+VOID USBD_STORAGE_Activate(VOID *storage_instance)
+{
+  /* USER CODE BEGIN USBD_STORAGE_Activate */
+  UX_PARAMETER_NOT_USED(storage_instance);
+  storage_bloco_atual = 0;
+  Disco_Virtual_Montar();
+  /* USER CODE END USBD_STORAGE_Activate */
+
+  return;
+}
+
+/**
+  * @brief  USBD_STORAGE_Deactivate
+  *         This function is called when extraction of a storage device.
+  * @param  storage_instance: Pointer to the storage class instance.
+  * @retval none
+  */
+VOID USBD_STORAGE_Deactivate(VOID *storage_instance)
+{
+  /* USER CODE BEGIN USBD_STORAGE_Deactivate */
+  UX_PARAMETER_NOT_USED(storage_instance);
+  storage_bloco_atual = 0;
+  /* USER CODE END USBD_STORAGE_Deactivate */
+
+  return;
+}
+
+/**
+  * @brief  USBD_STORAGE_Read
+  *         This function is invoked to read from media.
+  * @param  storage_instance : Pointer to the storage class instance.
+  * @param  lun: Logical unit number is the command is directed to.
+  * @param  data_pointer: Address of the buffer to be used for reading or writing.
+  * @param  number_blocks: number of sectors to read/write.
+  * @param  lba: Logical block address is the sector address to read.
+  * @param  media_status: should be filled out exactly like the media status
+  *                       callback return value.
+  * @retval UX_STATE_NEXT when done, UX_STATE_WAIT while pending, UX_STATE_ERROR on failure
+  */
+UINT USBD_STORAGE_Read(VOID *storage_instance, ULONG lun, UCHAR *data_pointer,
+                       ULONG number_blocks, ULONG lba, ULONG *media_status)
+{
+  UINT status = UX_STATE_NEXT;
+
+  /* USER CODE BEGIN USBD_STORAGE_Read */
+  UX_PARAMETER_NOT_USED(storage_instance);
+  UX_PARAMETER_NOT_USED(lun);
+
+  while (storage_bloco_atual < number_blocks)
+  {
+    Disco_Virtual_Status_t st = Disco_Virtual_Ler_Setor(lba + storage_bloco_atual,
+                                  data_pointer + (storage_bloco_atual * DISCO_VIRTUAL_SETOR));
+    if (st == DISCO_VIRTUAL_PENDENTE)
+    {
+      return UX_STATE_WAIT;
+    }
+    if (st == DISCO_VIRTUAL_ERRO)
+    {
+      storage_bloco_atual = 0;
+      *media_status = STORAGE_SENSE_LEITURA;
+      return UX_STATE_ERROR;
+    }
+    storage_bloco_atual++;
+  }
+  storage_bloco_atual = 0;
+  *media_status = 0;
+  /* USER CODE END USBD_STORAGE_Read */
+
+  return status;
+}
+
+/**
+  * @brief  USBD_STORAGE_Write
+  *         This function is invoked to write in media.
+  * @param  storage_instance : Pointer to the storage class instance.
+  * @param  lun: Logical unit number is the command is directed to.
+  * @param  data_pointer: Address of the buffer to be used for reading or writing.
+  * @param  number_blocks: number of sectors to read/write.
+  * @param  lba: Logical block address is the sector address to read.
+  * @param  media_status: should be filled out exactly like the media status
+  *                       callback return value.
+  * @retval status
+  */
+UINT USBD_STORAGE_Write(VOID *storage_instance, ULONG lun, UCHAR *data_pointer,
+                        ULONG number_blocks, ULONG lba, ULONG *media_status)
+{
+  UINT status = UX_STATE_ERROR;
+
+  /* USER CODE BEGIN USBD_STORAGE_Write */
+  UX_PARAMETER_NOT_USED(storage_instance);
+  UX_PARAMETER_NOT_USED(lun);
+  UX_PARAMETER_NOT_USED(data_pointer);
+  UX_PARAMETER_NOT_USED(number_blocks);
+  UX_PARAMETER_NOT_USED(lba);
+
+  // Volume somente-leitura: o conteudo e sintetizado a partir da configuracao/EEPROM
+  *media_status = STORAGE_SENSE_PROTEGIDO;
+  /* USER CODE END USBD_STORAGE_Write */
+
+  return status;
+}
+
+/**
+  * @brief  USBD_STORAGE_Flush
+  *         This function is invoked to flush media.
+  * @param  storage_instance : Pointer to the storage class instance.
+  * @param  lun: Logical unit number is the command is directed to.
+  * @param  number_blocks: number of sectors to read/write.
+  * @param  lba: Logical block address is the sector address to read.
+  * @param  media_status: should be filled out exactly like the media status
+  *                       callback return value.
+  * @retval status
+  */
+UINT USBD_STORAGE_Flush(VOID *storage_instance, ULONG lun, ULONG number_blocks,
+                        ULONG lba, ULONG *media_status)
+{
+  UINT status = UX_STATE_NEXT;
+
+  /* USER CODE BEGIN USBD_STORAGE_Flush */
+  UX_PARAMETER_NOT_USED(storage_instance);
+  UX_PARAMETER_NOT_USED(lun);
+  UX_PARAMETER_NOT_USED(number_blocks);
+  UX_PARAMETER_NOT_USED(lba);
+  *media_status = 0;
+  /* USER CODE END USBD_STORAGE_Flush */
+
+  return status;
+}
+
+/**
+  * @brief  USBD_STORAGE_Status
+  *         This function is invoked to obtain the status of the device.
+  * @param  storage_instance : Pointer to the storage class instance.
+  * @param  lun: Logical unit number is the command is directed to.
+  * @param  media_id: is not currently used.
+  * @param  media_status: should be filled out exactly like the media status
+  *                       callback return value.
+  * @retval status
+  */
+UINT USBD_STORAGE_Status(VOID *storage_instance, ULONG lun, ULONG media_id,
+                         ULONG *media_status)
+{
+  UINT status = UX_SUCCESS;
+
+  /* USER CODE BEGIN USBD_STORAGE_Status */
+  UX_PARAMETER_NOT_USED(storage_instance);
+  UX_PARAMETER_NOT_USED(lun);
+  UX_PARAMETER_NOT_USED(media_id);
+  *media_status = 0;
+  /* USER CODE END USBD_STORAGE_Status */
+
+  return status;
+}
+
+/**
+  * @brief  USBD_STORAGE_Notification
+  *         This function is invoked to obtain the notification of the device.
+  * @param  storage_instance : Pointer to the storage class instance.
+  * @param  lun: Logical unit number is the command is directed to.
+  * @param  media_id: is not currently used.
+  * @param  notification_class: specifies the class of notification.
+  * @param  media_notification: response for the notification.
+  * @param  media_notification_length: length of the response buffer.
+  * @retval status
+  */
+UINT USBD_STORAGE_Notification(VOID *storage_instance, ULONG lun, ULONG media_id,
+                               ULONG notification_class, UCHAR **media_notification,
+                               ULONG *media_notification_length)
+{
+  UINT status = UX_SUCCESS;
+
+  /* USER CODE BEGIN USBD_STORAGE_Notification */
+  UX_PARAMETER_NOT_USED(storage_instance);
+  UX_PARAMETER_NOT_USED(lun);
+  UX_PARAMETER_NOT_USED(media_id);
+  UX_PARAMETER_NOT_USED(notification_class);
+  UX_PARAMETER_NOT_USED(media_notification);
+  UX_PARAMETER_NOT_USED(media_notification_length);
+  /* USER CODE END USBD_STORAGE_Notification */
+
+  return status;
+}
+
+/**
+  * @brief  USBD_STORAGE_GetMediaLastLba
+  *         Get Media last LBA.
+  * @param  none
+  * @retval last lba
+  */
+ULONG USBD_STORAGE_GetMediaLastLba(VOID)
+{
+  ULONG LastLba = 0U;
+
+  /* USER CODE BEGIN USBD_STORAGE_GetMediaLastLba */
+  LastLba = Disco_Virtual_Total_Setores() - 1U;
+  /* USER CODE END USBD_STORAGE_GetMediaLastLba */
+
+  return LastLba;
+}
+
+/**
+  * @brief  USBD_STORAGE_GetMediaBlocklength
+  *         Get Media block length.
+  * @param  none.
+  * @retval block length.
+  */
+ULONG USBD_STORAGE_GetMediaBlocklength(VOID)
+{
+  ULONG MediaBlockLen = 0U;
+
+  /* USER CODE BEGIN USBD_STORAGE_GetMediaBlocklength */
+  MediaBlockLen = DISCO_VIRTUAL_SETOR;
+  /* USER CODE END USBD_STORAGE_GetMediaBlocklength */
+
+  return MediaBlockLen;
+}
+
+/* USER CODE BEGIN 1 */
+
+/* USER CODE END 1 */
@@ -166,7 +166,7 @@
 /* Defined, this value is the maximum number of classes in the device stack that can be loaded by
    USBX.  */
 
-#define UX_MAX_SLAVE_CLASS_DRIVER    1
+#define UX_MAX_SLAVE_CLASS_DRIVER    4
 
 /* Defined, this value represents the number of different host controllers available in the system.
    For USB 1.1 support, this value will usually be 1. For USB 2.0 support, this value can be more
@@ -185,12 +185,12 @@
 
 /* Defined, this value is the maximum number of interfaces in the device framework.  */
 
-/* #define UX_MAX_SLAVE_INTERFACES    16 */
+#define UX_MAX_SLAVE_INTERFACES    5
 
 /* Defined, this value represents the current number of SCSI logical units represented in the device
    storage class driver.  */
 
-/* #define UX_MAX_SLAVE_LUN    1 */
+#define UX_MAX_SLAVE_LUN    1
 
 /* Defined, this value represents the maximum number of SCSI logical units represented in the
    host storage class driver.  */
@@ -206,14 +206,14 @@
    0 - The default, endpoint buffer is managed by core stack. Each endpoint takes UX_SLAVE_REQUEST_DATA_MAX_LENGTH bytes.
    1 - Endpoint buffer managed by classes. In this case not all endpoints consume UX_SLAVE_REQUEST_DATA_MAX_LENGTH bytes.  */
 
-/* #define UX_DEVICE_ENDPOINT_BUFFER_OWNER      0 */
+#define UX_DEVICE_ENDPOINT_BUFFER_OWNER      1
 
 /* Defined, it enables device CDC ACM zero copy for bulk in/out endpoints (write/read).
    Enabled, the endpoint buffer is not allocated in class, application must provide the buffer for read/write,
    and the buffer must meet device controller driver (DCD) buffer requirements (e.g., aligned and cache safe).
    It only works if  UX_DEVICE_ENDPOINT_BUFFER_OWNER is 1 (endpoint buffer managed by class).  */
 
-/* #define UX_DEVICE_CLASS_CDC_ACM_ZERO_COPY  */
+#define UX_DEVICE_CLASS_CDC_ACM_ZERO_COPY
 
 /* Defined, it enables device HID zero copy and flexible queue support (works if HID owns endpoint buffer).
     Enabled, the internal queue buffer is directly used for transfer, the APIs are kept to keep
@@ -253,7 +253,7 @@
    is 2048 bytes but can be reduced in memory constrained environments. For cd-rom support in the storage
    class, this value cannot be less than 2048.  */
 
-/* #define UX_SLAVE_REQUEST_DATA_MAX_LENGTH                 2048 */
+#define UX_SLAVE_REQUEST_DATA_MAX_LENGTH                 512
 
 /* Defined, this enables processing of Get String Descriptor requests with zero Language ID.
    The first language ID in the language ID framework will be used if the request has a zero
@@ -384,17 +384,17 @@
    device.
  */
 
-/* #define UX_DEVICE_CLASS_HID_EVENT_BUFFER_LENGTH          64 */
+#define UX_DEVICE_CLASS_HID_EVENT_BUFFER_LENGTH          32
 
 /* Defined, this value represents the the maximum number of HID events/reports
    that can be queued at once.
  */
 
-/* #define UX_DEVICE_CLASS_HID_MAX_EVENTS_QUEUE             8 */
+#define UX_DEVICE_CLASS_HID_MAX_EVENTS_QUEUE             2
 
 /* Defined, this macro will disable DFU_UPLOAD support.  */
 
-/* #define UX_DEVICE_CLASS_DFU_UPLOAD_DISABLE  */
+#define UX_DEVICE_CLASS_DFU_UPLOAD_DISABLE
 
 /* Defined, this macro will enable DFU_GETSTATUS and DFU_GETSTATE in dfuERROR.  */
 
@@ -443,7 +443,7 @@
 
 /* Defined, device HID interrupt OUT transfer is supported.  */
 
-/* #define UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT */
+#define UX_DEVICE_CLASS_HID_INTERRUPT_OUT_SUPPORT
 
 /* Defined, this macro enables device bi-directional endpoint support. */
 
@@ -460,7 +460,7 @@
    Undefined, the following two macros must be defined to initialize memory structures.
  */
 
-/* #define UX_DEVICE_INITIALIZE_FRAMEWORK_SCAN_DISABLE */
+#define UX_DEVICE_INITIALIZE_FRAMEWORK_SCAN_DISABLE
 
 /* Defined, host HID interrupt OUT transfer is supported.  */
 
@@ -598,11 +598,11 @@
 
 /* it define USBX device max number of endpoints (1~n). */
 
-/* #define UX_MAX_DEVICE_ENDPOINTS           6 */
+#define UX_MAX_DEVICE_ENDPOINTS           7
 
 /* it define USBX device max number of interfacess (1~n). */
 
-/* #define UX_MAX_DEVICE_INTERFACES          6 */
+#define UX_MAX_DEVICE_INTERFACES          5
 
 /* Define USBX max root hub port (1 ~ n).  */
 